@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <Common/CharTraits.hpp>
+#include <Common/StringRef.hpp>
+#include <Common/Details/EditDistanceKernels.hpp>
+
+namespace CppMiniToolkit
+{
+    // a query compared with many candidates by Levenshtein distance, e.g. "did you mean" over a dictionary:
+    //     TFuzzyMatcher<char, true> matcher(name);
+    //     auto best = matcher.FindClosest(names.begin(), names.end(), 2);
+    // the query is preprocessed once into the bit masks of the Myers algorithm, so each candidate costs
+    // about one word operation per character for queries up to 64 characters.
+    // candidates whose length alone differs by more than the limit are skipped without a scan,
+    // the others are abandoned as soon as the limit can't be reached anymore.
+    // IgnoreCase uses the same folding rules as TCharTraits::iFind
+    template <typename TCharType, bool IgnoreCase = false>
+    class TFuzzyMatcher
+    {
+    public:
+        typedef std::basic_string<TCharType>                            StringType;
+        typedef typename StringType::size_type                          SizeType;
+
+        constexpr static SizeType npos = StringType::npos;
+
+        explicit TFuzzyMatcher(const TCharType* query) :
+            TFuzzyMatcher(query, TCharTraits<TCharType>::length(query))
+        {
+        }
+
+        explicit TFuzzyMatcher(const StringType& query) :
+            TFuzzyMatcher(query.c_str(), query.size())
+        {
+        }
+
+        TFuzzyMatcher(const TCharType* query, const SizeType queryLength) :
+            Query(query, queryLength),
+            Pattern(query, queryLength)
+        {
+        }
+
+        const StringType& GetQuery() const
+        {
+            return Query;
+        }
+
+        constexpr static bool IsIgnoreCase()
+        {
+            return IgnoreCase;
+        }
+
+        SizeType GetDistance(const TStringRef<TCharType>& candidate) const
+        {
+            return Pattern.Distance(candidate.GetData(), candidate.GetLength(), npos);
+        }
+
+        // the distance if it is at most maxDistance, maxDistance + 1 otherwise
+        SizeType GetDistance(const TStringRef<TCharType>& candidate, const SizeType maxDistance) const
+        {
+            return Pattern.Distance(candidate.GetData(), candidate.GetLength(), maxDistance);
+        }
+
+        // calls onMatch(index, distance) for every candidate within maxDistance and returns how many there were
+        // the candidates are anything TStringRef can be made of: strings, string references, pointers
+        template <typename TIterator, typename TCallback>
+        SizeType FindWithin(TIterator first, const TIterator last, const SizeType maxDistance, TCallback onMatch) const
+        {
+            SizeType count = 0;
+
+            for (SizeType index = 0; first != last; ++first, ++index)
+            {
+                const SizeType distance = GetDistance(TStringRef<TCharType>(*first), maxDistance);
+
+                if (distance <= maxDistance)
+                {
+                    onMatch(index, distance);
+                    ++count;
+                }
+            }
+
+            return count;
+        }
+
+        // the first of the closest candidates, last if none is within maxDistance
+        // the limit shrinks to the best distance found so far, so later candidates are abandoned earlier
+        template <typename TIterator>
+        TIterator FindClosest(TIterator first, const TIterator last, const SizeType maxDistance = npos, SizeType* distance = nullptr) const
+        {
+            TIterator closest = last;
+            SizeType limit = maxDistance;
+
+            for (; first != last; ++first)
+            {
+                const SizeType current = GetDistance(TStringRef<TCharType>(*first), limit);
+
+                if (current <= limit && (closest == last || current < limit))
+                {
+                    closest = first;
+                    limit = current;
+
+                    if (limit == 0)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            if (distance != nullptr)
+            {
+                *distance = closest != last ? limit : npos;
+            }
+
+            return closest;
+        }
+
+    private:
+        StringType                                              Query;
+        Details::TEditDistancePattern<TCharType, IgnoreCase>    Pattern;
+    };
+
+    template <typename TCharType, bool IgnoreCase>
+    constexpr typename TFuzzyMatcher<TCharType, IgnoreCase>::SizeType TFuzzyMatcher<TCharType, IgnoreCase>::npos;
+
+    typedef TFuzzyMatcher<char>             FuzzyMatcher;
+    typedef TFuzzyMatcher<char, true>       iFuzzyMatcher;
+    typedef TFuzzyMatcher<wchar_t>          WFuzzyMatcher;
+    typedef TFuzzyMatcher<wchar_t, true>    iWFuzzyMatcher;
+}
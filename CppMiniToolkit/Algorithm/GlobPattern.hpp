@@ -0,0 +1,381 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <Common/CharTraits.hpp>
+#include <Common/StringRef.hpp>
+
+namespace CppMiniToolkit
+{
+    // a wildcard pattern compiled once and matched against many strings, e.g. file names:
+    //     TGlobPattern<char, true> logs("*.log");  logs.Match(name)
+    // '*' matches any run of characters (also none), '?' matches exactly one character, everything
+    // else matches itself, and the pattern has to match the whole string.
+    // the pattern is split at the stars into segments: the first and the last one are anchored at the
+    // ends of the string, the ones between are found from left to right, each at its first occurrence.
+    // taking the first occurrence is always right for globs, so there is no backtracking and a match
+    // costs one pass over the string: literal segments use the SIMD kernels of TCharTraits, segments
+    // with '?' a bit parallel Shift-And automaton of one bit per character, split into 64 bit words.
+    // IgnoreCase uses the same folding rules as TCharTraits::iFind
+    template <typename TCharType, bool IgnoreCase = false>
+    class TGlobPattern
+    {
+    public:
+        typedef std::basic_string<TCharType>                            StringType;
+        typedef typename StringType::size_type                          SizeType;
+        typedef typename std::make_unsigned<TCharType>::type            UnsignedCharType;
+
+        explicit TGlobPattern(const TCharType* pattern) :
+            TGlobPattern(pattern, TCharTraits<TCharType>::length(pattern))
+        {
+        }
+
+        explicit TGlobPattern(const StringType& pattern) :
+            TGlobPattern(pattern.c_str(), pattern.size())
+        {
+        }
+
+        TGlobPattern(const TCharType* pattern, const SizeType patternLength) :
+            Pattern(pattern, patternLength),
+            HasStar(false),
+            AnchoredStart(true),
+            AnchoredEnd(true)
+        {
+            Compile();
+        }
+
+        const StringType& GetPattern() const
+        {
+            return Pattern;
+        }
+
+        constexpr static bool IsIgnoreCase()
+        {
+            return IgnoreCase;
+        }
+
+        bool Match(const TCharType* text, const SizeType length) const
+        {
+            if (!HasStar)
+            {
+                return Segments.empty() ? length == 0 : length == Segments[0].Length && MatchAt(Segments[0], text);
+            }
+
+            SizeType begin = 0;
+            SizeType end = length;
+            SizeType first = 0;
+            SizeType last = Segments.size();
+
+            if (AnchoredStart)
+            {
+                if (Segments[0].Length > end || !MatchAt(Segments[0], text))
+                {
+                    return false;
+                }
+
+                begin = Segments[0].Length;
+                ++first;
+            }
+
+            if (AnchoredEnd && first < last)
+            {
+                const Segment& segment = Segments[last - 1];
+
+                if (segment.Length > end - begin || !MatchAt(segment, text + end - segment.Length))
+                {
+                    return false;
+                }
+
+                end -= segment.Length;
+                --last;
+            }
+
+            for (SizeType i = first; i < last; ++i)
+            {
+                const TCharType* match = FindSegment(Segments[i], text + begin, end - begin);
+
+                if (match == nullptr)
+                {
+                    return false;
+                }
+
+                begin = static_cast<SizeType>(match - text) + Segments[i].Length;
+            }
+
+            return true;
+        }
+
+        bool Match(const TStringRef<TCharType>& text) const
+        {
+            return Match(text.GetData(), text.GetLength());
+        }
+
+        bool Match(const TCharType* text) const
+        {
+            return Match(text, TCharTraits<TCharType>::length(text));
+        }
+
+    private:
+        constexpr static SizeType BlockBits = 64;
+
+        struct Segment
+        {
+            // characters in Folded, '?' stands for any character
+            SizeType            Offset;
+            SizeType            Length;
+            // index of the Shift-And masks in Masks, npos for literal segments
+            SizeType            Table;
+            // words per mask, one bit per character of the segment
+            SizeType            BlockCount;
+            // the characters beyond 256 of the segment, sorted, in WideCharacters and their masks in WideMasks
+            SizeType            WideOffset;
+            SizeType            WideCount;
+            SizeType            WideTable;
+        };
+
+        static TCharType Fold(const TCharType ch)
+        {
+            return IgnoreCase ? Details::TCaseFolding<TCharType>::Fold(ch) : ch;
+        }
+
+        static bool IsWildcard(const TCharType ch)
+        {
+            return ch == TCharType('?');
+        }
+
+        void Compile()
+        {
+            SizeType start = 0;
+
+            for (SizeType i = 0; i <= Pattern.size(); ++i)
+            {
+                if (i < Pattern.size() && Pattern[i] != TCharType('*'))
+                {
+                    continue;
+                }
+
+                if (i < Pattern.size())
+                {
+                    HasStar = true;
+                    AnchoredStart = AnchoredStart && i > 0;
+                    AnchoredEnd = i + 1 < Pattern.size();
+                }
+
+                if (i > start)
+                {
+                    AddSegment(start, i - start);
+                }
+
+                start = i + 1;
+            }
+        }
+
+        void AddSegment(const SizeType offset, const SizeType length)
+        {
+            Segment segment = { Folded.size(), length, StringType::npos, 0, WideCharacters.size(), 0, 0 };
+            bool hasWildcard = false;
+
+            for (SizeType i = 0; i < length; ++i)
+            {
+                Folded += Fold(Pattern[offset + i]);
+                hasWildcard = hasWildcard || IsWildcard(Pattern[offset + i]);
+            }
+
+            if (hasWildcard)
+            {
+                AddMasks(segment);
+            }
+
+            Segments.push_back(segment);
+        }
+
+        // bit i of the mask of a character is set if position i of the segment accepts it. the table has
+        // BlockCount words for each character below 256 and one more row with the '?' positions, which
+        // is the mask of every wide character that doesn't occur in the segment
+        void AddMasks(Segment& segment)
+        {
+            const TCharType* pattern = Folded.c_str() + segment.Offset;
+            const SizeType blockCount = (segment.Length + BlockBits - 1) / BlockBits;
+
+            segment.Table = Masks.size();
+            segment.BlockCount = blockCount;
+            Masks.resize(Masks.size() + 257 * blockCount, 0);
+
+            for (SizeType i = 0; i < segment.Length; ++i)
+            {
+                const TCharType ch = pattern[i];
+                const auto wideBegin = WideCharacters.begin() + static_cast<std::ptrdiff_t>(segment.WideOffset);
+
+                if (!IsWildcard(ch) && static_cast<UnsignedCharType>(ch) >= 256 &&
+                    !std::binary_search(wideBegin, WideCharacters.end(), ch))
+                {
+                    WideCharacters.insert(std::lower_bound(wideBegin, WideCharacters.end(), ch), ch);
+                }
+            }
+
+            const auto wideBegin = WideCharacters.begin() + static_cast<std::ptrdiff_t>(segment.WideOffset);
+            segment.WideCount = WideCharacters.size() - segment.WideOffset;
+            segment.WideTable = WideMasks.size();
+            WideMasks.resize(WideMasks.size() + segment.WideCount * blockCount, 0);
+
+            uint64_t* const wideMasks = WideMasks.data() + segment.WideTable;
+
+            for (SizeType i = 0; i < segment.Length; ++i)
+            {
+                const TCharType ch = pattern[i];
+                const SizeType word = i / BlockBits;
+                const uint64_t bit = static_cast<uint64_t>(1) << (i % BlockBits);
+
+                if (IsWildcard(ch))
+                {
+                    for (SizeType value = 0; value <= 256; ++value)
+                    {
+                        Masks[segment.Table + value * blockCount + word] |= bit;
+                    }
+
+                    for (SizeType index = 0; index < segment.WideCount; ++index)
+                    {
+                        wideMasks[index * blockCount + word] |= bit;
+                    }
+                }
+                else if (static_cast<UnsignedCharType>(ch) < 256)
+                {
+                    Masks[segment.Table + static_cast<UnsignedCharType>(ch) * blockCount + word] |= bit;
+                }
+                else
+                {
+                    const auto index = static_cast<SizeType>(std::lower_bound(wideBegin, WideCharacters.end(), ch) - wideBegin);
+                    wideMasks[index * blockCount + word] |= bit;
+                }
+            }
+        }
+
+        bool MatchAt(const Segment& segment, const TCharType* text) const
+        {
+            const TCharType* pattern = Folded.c_str() + segment.Offset;
+
+            for (SizeType i = 0; i < segment.Length; ++i)
+            {
+                if (!IsWildcard(pattern[i]) && pattern[i] != Fold(text[i]))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        const TCharType* FindSegment(const Segment& segment, const TCharType* text, const SizeType length) const
+        {
+            if (segment.Table == StringType::npos)
+            {
+                return IgnoreCase ?
+                    TCharTraits<TCharType>::iFind(text, length, Folded.c_str() + segment.Offset, segment.Length) :
+                    TCharTraits<TCharType>::Find(text, length, Folded.c_str() + segment.Offset, segment.Length);
+            }
+
+            if (segment.Length > length)
+            {
+                return nullptr;
+            }
+
+            return segment.BlockCount == 1 ?
+                FindSegmentWord(segment, text, length) :
+                FindSegmentBlocks(segment, text, length);
+        }
+
+        // state bit i: the last i + 1 characters match the first i + 1 positions of the segment
+        const TCharType* FindSegmentWord(const Segment& segment, const TCharType* text, const SizeType length) const
+        {
+            const uint64_t accept = static_cast<uint64_t>(1) << (segment.Length - 1);
+            uint64_t state = 0;
+
+            for (SizeType i = 0; i < length; ++i)
+            {
+                state = (state << 1 | 1) & *GetMasks(segment, Fold(text[i]));
+
+                if ((state & accept) != 0)
+                {
+                    return text + i + 1 - segment.Length;
+                }
+            }
+
+            return nullptr;
+        }
+
+        // the same automaton over BlockCount words, the shift carries the top bit of a word into the next one
+        const TCharType* FindSegmentBlocks(const Segment& segment, const TCharType* text, const SizeType length) const
+        {
+            const SizeType blockCount = segment.BlockCount;
+            const uint64_t accept = static_cast<uint64_t>(1) << ((segment.Length - 1) % BlockBits);
+            std::vector<uint64_t> state(blockCount, 0);
+
+            for (SizeType i = 0; i < length; ++i)
+            {
+                const uint64_t* masks = GetMasks(segment, Fold(text[i]));
+                uint64_t carry = 1;
+
+                for (SizeType word = 0; word < blockCount; ++word)
+                {
+                    const uint64_t next = state[word] >> (BlockBits - 1);
+
+                    state[word] = (state[word] << 1 | carry) & masks[word];
+                    carry = next;
+                }
+
+                if ((state[blockCount - 1] & accept) != 0)
+                {
+                    return text + i + 1 - segment.Length;
+                }
+            }
+
+            return nullptr;
+        }
+
+        const uint64_t* GetMasks(const Segment& segment, const TCharType ch) const
+        {
+            const auto value = static_cast<UnsignedCharType>(ch);
+
+            if (value < 256)
+            {
+                return &Masks[segment.Table + value * segment.BlockCount];
+            }
+
+            const auto wideBegin = WideCharacters.begin() + static_cast<std::ptrdiff_t>(segment.WideOffset);
+            const auto wideEnd = wideBegin + static_cast<std::ptrdiff_t>(segment.WideCount);
+            const auto position = std::lower_bound(wideBegin, wideEnd, ch);
+
+            if (position == wideEnd || *position != ch)
+            {
+                return &Masks[segment.Table + 256 * segment.BlockCount];
+            }
+
+            return &WideMasks[segment.WideTable + static_cast<SizeType>(position - wideBegin) * segment.BlockCount];
+        }
+
+    private:
+        StringType              Pattern;
+        // the segments one after another, folded for IgnoreCase
+        StringType              Folded;
+        std::vector<Segment>    Segments;
+        // 257 rows of BlockCount words for each segment with '?'
+        std::vector<uint64_t>   Masks;
+        std::vector<TCharType>  WideCharacters;
+        std::vector<uint64_t>   WideMasks;
+        bool                    HasStar;
+        bool                    AnchoredStart;
+        bool                    AnchoredEnd;
+    };
+
+    template <typename TCharType, bool IgnoreCase>
+    constexpr typename TGlobPattern<TCharType, IgnoreCase>::SizeType TGlobPattern<TCharType, IgnoreCase>::BlockBits;
+
+    typedef TGlobPattern<char>              GlobPattern;
+    typedef TGlobPattern<char, true>        iGlobPattern;
+    typedef TGlobPattern<wchar_t>           WGlobPattern;
+    typedef TGlobPattern<wchar_t, true>     iWGlobPattern;
+}
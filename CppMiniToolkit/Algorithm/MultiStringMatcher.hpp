@@ -0,0 +1,566 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+#include <cassert>
+
+#include <Common/CharTraits.hpp>
+
+namespace CppMiniToolkit
+{
+    // Aho-Corasick automaton over a set of patterns, every search is a single linear pass over the text
+    // characters are compressed into classes (only characters used by the patterns get their own class),
+    // so the fully resolved transition table is dense: states x classes. When there are less than
+    // 65536 states the table is stored with 16 bit entries to keep it small enough for L2.
+    // IgnoreCase folds both patterns and text with TCharTraits::ToLower
+    template <typename TCharType, bool IgnoreCase = false>
+    class TMultiStringMatcher
+    {
+    public:
+        typedef std::basic_string<TCharType>                            StringType;
+        typedef size_t                                                  SizeType;
+        typedef typename std::make_unsigned<TCharType>::type            UnsignedCharType;
+
+        constexpr static SizeType npos = static_cast<SizeType>(-1);
+
+        struct MatchResult
+        {
+            SizeType Position = npos;
+            SizeType Length = 0;
+            SizeType PatternIndex = npos;
+        };
+
+        TMultiStringMatcher() = default;
+
+        template <typename TSequenceType>
+        explicit TMultiStringMatcher(const TSequenceType& patterns)
+        {
+            for (const auto& pattern : patterns)
+            {
+                AddPattern(pattern);
+            }
+
+            Build();
+        }
+
+        TMultiStringMatcher(std::initializer_list<StringType> patterns)
+        {
+            for (const auto& pattern : patterns)
+            {
+                AddPattern(pattern);
+            }
+
+            Build();
+        }
+
+        // add a pattern, returns its index. Build must be called before searching again
+        // empty patterns are ignored, duplicated patterns report the index of the first one
+        SizeType AddPattern(const StringType& pattern)
+        {
+            Patterns.push_back(pattern);
+            Built = false;
+
+            return Patterns.size() - 1;
+        }
+
+        SizeType AddPattern(const TCharType* pattern)
+        {
+            return AddPattern(StringType(pattern));
+        }
+
+        void Build()
+        {
+            BuildClasses();
+            BuildTrie();
+            BuildAutomaton();
+
+            Built = true;
+        }
+
+        bool IsBuilt() const
+        {
+            return Built;
+        }
+
+        SizeType GetPatternCount() const
+        {
+            return Patterns.size();
+        }
+
+        const StringType& GetPattern(const SizeType index) const
+        {
+            return Patterns[index];
+        }
+
+        SizeType GetStateCount() const
+        {
+            return StateCount;
+        }
+
+        SizeType GetClassCount() const
+        {
+            return ClassCount;
+        }
+
+        SizeType GetMaxPatternLength() const
+        {
+            return MaxPatternLength;
+        }
+
+        // bytes used by the automaton tables
+        SizeType GetMemoryUsage() const
+        {
+            return Transitions16.capacity() * sizeof(uint16_t) +
+                Transitions32.capacity() * sizeof(uint32_t) +
+                Failure.capacity() * sizeof(uint32_t) +
+                MatchLink.capacity() * sizeof(uint32_t) +
+                StatePattern.capacity() * sizeof(uint32_t) +
+                Depth.capacity() * sizeof(uint32_t) +
+                WideClasses.capacity() * sizeof(std::pair<UnsignedCharType, uint32_t>) +
+                sizeof(ByteClasses) +
+                sizeof(FoldedByteClasses);
+        }
+
+        // visit every match (overlapping ones included) in the order of their end positions
+        // the callback receives a MatchResult and returns false to stop the scan
+        // returns false if the scan was stopped by the callback
+        template <typename TCallback>
+        bool ScanIn(const TCharType* text, const SizeType length, TCallback callback) const
+        {
+            SizeType limit = length;
+
+            return ScanRange(text, limit, callback);
+        }
+
+        template <typename TCallback>
+        bool ScanIn(const StringType& text, TCallback callback) const
+        {
+            return ScanIn(text.c_str(), text.size(), callback);
+        }
+
+        bool ContainsAnyIn(const TCharType* text, const SizeType length) const
+        {
+            return !ScanIn(text, length, [](const MatchResult&) { return false; });
+        }
+
+        bool ContainsAnyIn(const StringType& text) const
+        {
+            return ContainsAnyIn(text.c_str(), text.size());
+        }
+
+        // find the leftmost match, the longest one if several matches start at the same position
+        bool FindFirstIn(const TCharType* text, const SizeType length, MatchResult& result) const
+        {
+            MatchResult best;
+            SizeType limit = length;
+
+            auto callback = [&](const MatchResult& match)
+                {
+                    if (best.Position == npos || match.Position < best.Position || (match.Position == best.Position && match.Length > best.Length))
+                    {
+                        best = match;
+                    }
+
+                    // a match ending after this can't start at or before the best match
+                    limit = (std::min)(length, best.Position + MaxPatternLength);
+
+                    return true;
+                };
+
+            ScanRange(text, limit, callback);
+
+            result = best;
+
+            return best.Position != npos;
+        }
+
+        bool FindFirstIn(const StringType& text, MatchResult& result) const
+        {
+            return FindFirstIn(text.c_str(), text.size(), result);
+        }
+
+        // visit non overlapping matches in text order, at every step the leftmost match wins and
+        // the longest pattern wins between matches starting at the same position
+        // one pass: a match is reported as soon as the automaton state shows that no other match can
+        // start at or before it anymore, the scan goes on from the same state
+        // returns false if the scan was stopped by the callback
+        template <typename TCallback>
+        bool ScanLeftmostLongestIn(const TCharType* text, const SizeType length, TCallback callback) const
+        {
+            assert(Built && "call Build before searching");
+
+            if (StateCount == 0 || MaxPatternLength == 0)
+            {
+                return true;
+            }
+
+            return Transitions32.empty() ?
+                ScanLeftmostLongestCore(Transitions16.data(), text, length, callback) :
+                ScanLeftmostLongestCore(Transitions32.data(), text, length, callback);
+        }
+
+        template <typename TCallback>
+        bool ScanLeftmostLongestIn(const StringType& text, TCallback callback) const
+        {
+            return ScanLeftmostLongestIn(text.c_str(), text.size(), callback);
+        }
+
+        // append all matches (overlapping ones included) to results, returns the number of matches
+        template <typename TSequenceType>
+        SizeType FindAllIn(const TCharType* text, const SizeType length, TSequenceType& results) const
+        {
+            SizeType count = 0;
+
+            ScanIn(text, length, [&](const MatchResult& match)
+                {
+                    results.push_back(match);
+                    ++count;
+                    return true;
+                });
+
+            return count;
+        }
+
+        template <typename TSequenceType>
+        SizeType FindAllIn(const StringType& text, TSequenceType& results) const
+        {
+            return FindAllIn(text.c_str(), text.size(), results);
+        }
+
+    private:
+        constexpr static uint32_t NoState = 0xFFFFFFFFu;
+        constexpr static uint32_t NoPattern = 0xFFFFFFFFu;
+        constexpr static SizeType ByteClassCount = 256;
+
+        static TCharType Fold(const TCharType ch)
+        {
+            // ToLower on char is only defined for non negative values
+            return IgnoreCase && !(std::is_signed<TCharType>::value && ch < 0) ?
+                static_cast<TCharType>(TCharTraits<TCharType>::ToLower(ch)) :
+                ch;
+        }
+
+        // class of a character that is already folded, 0 if no pattern uses it
+        uint32_t FoldedClassOf(const TCharType ch) const
+        {
+            const auto value = static_cast<UnsignedCharType>(ch);
+
+            if (value < ByteClassCount)
+            {
+                return FoldedByteClasses[value];
+            }
+
+            const auto it = std::lower_bound(
+                WideClasses.begin(),
+                WideClasses.end(),
+                value,
+                [](const std::pair<UnsignedCharType, uint32_t>& item, const UnsignedCharType key) { return item.first < key; }
+                );
+
+            return it != WideClasses.end() && it->first == value ? it->second : 0;
+        }
+
+        uint32_t ClassOf(const TCharType ch) const
+        {
+            const auto value = static_cast<UnsignedCharType>(ch);
+
+            // the byte table already contains the folding
+            return value < ByteClassCount ? ByteClasses[value] : FoldedClassOf(Fold(ch));
+        }
+
+        void BuildClasses()
+        {
+            std::vector<UnsignedCharType> characters;
+
+            MaxPatternLength = 0;
+
+            for (const auto& pattern : Patterns)
+            {
+                for (const auto ch : pattern)
+                {
+                    characters.push_back(static_cast<UnsignedCharType>(Fold(ch)));
+                }
+
+                MaxPatternLength = (std::max)(MaxPatternLength, static_cast<SizeType>(pattern.size()));
+            }
+
+            std::sort(characters.begin(), characters.end());
+            characters.erase(std::unique(characters.begin(), characters.end()), characters.end());
+
+            std::fill(FoldedByteClasses, FoldedByteClasses + ByteClassCount, 0);
+            WideClasses.clear();
+
+            uint32_t classId = 0;
+
+            for (const auto value : characters)
+            {
+                ++classId;
+
+                if (value < ByteClassCount)
+                {
+                    FoldedByteClasses[value] = classId;
+                }
+                else
+                {
+                    WideClasses.emplace_back(value, classId);
+                }
+            }
+
+            ClassCount = classId + 1;
+
+            for (SizeType i = 0; i < ByteClassCount; ++i)
+            {
+                ByteClasses[i] = FoldedClassOf(Fold(static_cast<TCharType>(i)));
+            }
+        }
+
+        void BuildTrie()
+        {
+            // root only
+            StateCount = 1;
+            Transitions32.assign(ClassCount, NoState);
+            StatePattern.assign(1, NoPattern);
+            Depth.assign(1, 0);
+
+            for (SizeType index = 0; index < Patterns.size(); ++index)
+            {
+                const StringType& pattern = Patterns[index];
+
+                if (pattern.empty())
+                {
+                    continue;
+                }
+
+                uint32_t state = 0;
+
+                for (const auto ch : pattern)
+                {
+                    const uint32_t classId = FoldedClassOf(Fold(ch));
+                    uint32_t& next = Transitions32[state * ClassCount + classId];
+
+                    if (next == NoState)
+                    {
+                        next = static_cast<uint32_t>(StateCount++);
+
+                        // next is a reference into the table, it must not be used after the table grows
+                        Transitions32.resize(StateCount * ClassCount, NoState);
+                        StatePattern.push_back(NoPattern);
+                        Depth.push_back(Depth[state] + 1);
+                    }
+
+                    state = Transitions32[state * ClassCount + classId];
+                }
+
+                if (StatePattern[state] == NoPattern)
+                {
+                    StatePattern[state] = static_cast<uint32_t>(index);
+                }
+            }
+        }
+
+        void BuildAutomaton()
+        {
+            Failure.assign(StateCount, 0);
+            MatchLink.assign(StateCount, NoState);
+
+            std::vector<uint32_t> queue;
+            queue.reserve(StateCount);
+
+            for (SizeType classId = 0; classId < ClassCount; ++classId)
+            {
+                uint32_t& next = Transitions32[classId];
+
+                if (next == NoState)
+                {
+                    next = 0;
+                }
+                else
+                {
+                    Failure[next] = 0;
+                    queue.push_back(next);
+                }
+            }
+
+            // breadth first, so the failure state of every node is resolved before its children
+            for (SizeType head = 0; head < queue.size(); ++head)
+            {
+                const uint32_t state = queue[head];
+                const uint32_t failure = Failure[state];
+
+                MatchLink[state] = StatePattern[state] != NoPattern ? state : MatchLink[failure];
+
+                for (SizeType classId = 0; classId < ClassCount; ++classId)
+                {
+                    uint32_t& next = Transitions32[state * ClassCount + classId];
+                    const uint32_t fallback = Transitions32[failure * ClassCount + classId];
+
+                    if (next == NoState)
+                    {
+                        next = fallback;
+                    }
+                    else
+                    {
+                        Failure[next] = fallback;
+                        queue.push_back(next);
+                    }
+                }
+            }
+
+            if (StateCount <= 0x10000)
+            {
+                Transitions16.assign(Transitions32.begin(), Transitions32.end());
+                Transitions32.clear();
+                Transitions32.shrink_to_fit();
+            }
+            else
+            {
+                Transitions16.clear();
+                Transitions16.shrink_to_fit();
+            }
+        }
+
+        // limit may be lowered by the callback to end the scan early
+        template <typename TCallback>
+        bool ScanRange(const TCharType* text, SizeType& limit, TCallback& callback) const
+        {
+            assert(Built && "call Build before searching");
+
+            if (StateCount == 0)
+            {
+                return true;
+            }
+
+            return Transitions32.empty() ?
+                ScanCore(Transitions16.data(), text, limit, callback) :
+                ScanCore(Transitions32.data(), text, limit, callback);
+        }
+
+        template <typename TStateType, typename TCallback>
+        bool ScanCore(const TStateType* transitions, const TCharType* text, const SizeType& limit, TCallback& callback) const
+        {
+            const SizeType classCount = ClassCount;
+            SizeType state = 0;
+
+            for (SizeType i = 0; i < limit; ++i)
+            {
+                state = transitions[state * classCount + ClassOf(text[i])];
+
+                for (uint32_t matched = MatchLink[state]; matched != NoState; matched = MatchLink[Failure[matched]])
+                {
+                    const SizeType patternIndex = StatePattern[matched];
+
+                    MatchResult match;
+                    match.Length = Patterns[patternIndex].size();
+                    match.Position = i + 1 - match.Length;
+                    match.PatternIndex = patternIndex;
+
+                    if (!callback(static_cast<const MatchResult&>(match)))
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        template <typename TStateType, typename TCallback>
+        bool ScanLeftmostLongestCore(const TStateType* transitions, const TCharType* text, const SizeType length, TCallback& callback) const
+        {
+            // the longest match found so far for every start that may still be reported, by start modulo
+            // MaxPatternLength: the undecided starts never span more than the depth of the current state
+            std::vector<MatchResult> pending(MaxPatternLength);
+            const SizeType classCount = ClassCount;
+            SizeType state = 0;
+            // starts below cursor are decided, matches must not start before next
+            SizeType cursor = 0;
+            SizeType next = 0;
+
+            for (SizeType i = 0; i < length; ++i)
+            {
+                state = transitions[state * classCount + ClassOf(text[i])];
+
+                // a match ending later is a suffix of the current state extended, so it can't start before this
+                if (!ReportPending(pending, i + 1 - Depth[state], cursor, next, callback))
+                {
+                    return false;
+                }
+
+                for (uint32_t matched = MatchLink[state]; matched != NoState; matched = MatchLink[Failure[matched]])
+                {
+                    const SizeType matchLength = Depth[matched];
+                    const SizeType position = i + 1 - matchLength;
+
+                    MatchResult& candidate = pending[position % MaxPatternLength];
+
+                    if (position >= next && matchLength > candidate.Length)
+                    {
+                        candidate.Position = position;
+                        candidate.Length = matchLength;
+                        candidate.PatternIndex = StatePattern[matched];
+                    }
+                }
+            }
+
+            return ReportPending(pending, length, cursor, next, callback);
+        }
+
+        // report the matches starting below bound in text order, skipping the ones that overlap a reported match
+        template <typename TCallback>
+        bool ReportPending(std::vector<MatchResult>& pending, const SizeType bound, SizeType& cursor, SizeType& next, TCallback& callback) const
+        {
+            for (; cursor < bound; ++cursor)
+            {
+                MatchResult& candidate = pending[cursor % MaxPatternLength];
+
+                if (candidate.Length != 0 && cursor >= next)
+                {
+                    next = cursor + candidate.Length;
+
+                    if (!callback(static_cast<const MatchResult&>(candidate)))
+                    {
+                        return false;
+                    }
+                }
+
+                candidate.Length = 0;
+            }
+
+            return true;
+        }
+
+    private:
+        std::vector<StringType>                                     Patterns;
+        bool                                                        Built = false;
+        SizeType                                                    StateCount = 0;
+        SizeType                                                    ClassCount = 0;
+        SizeType                                                    MaxPatternLength = 0;
+        uint32_t                                                    ByteClasses[ByteClassCount] = {};
+        uint32_t                                                    FoldedByteClasses[ByteClassCount] = {};
+        std::vector<std::pair<UnsignedCharType, uint32_t>>          WideClasses;
+        std::vector<uint16_t>                                       Transitions16;
+        std::vector<uint32_t>                                       Transitions32;
+        std::vector<uint32_t>                                       Failure;
+        std::vector<uint32_t>                                       MatchLink;
+        std::vector<uint32_t>                                       StatePattern;
+        // length of the string spelled by every state
+        std::vector<uint32_t>                                       Depth;
+    };
+
+    template <typename TCharType, bool IgnoreCase>
+    constexpr typename TMultiStringMatcher<TCharType, IgnoreCase>::SizeType TMultiStringMatcher<TCharType, IgnoreCase>::npos;
+
+    template <typename TCharType, bool IgnoreCase>
+    constexpr uint32_t TMultiStringMatcher<TCharType, IgnoreCase>::NoState;
+
+    template <typename TCharType, bool IgnoreCase>
+    constexpr uint32_t TMultiStringMatcher<TCharType, IgnoreCase>::NoPattern;
+
+    template <typename TCharType, bool IgnoreCase>
+    constexpr typename TMultiStringMatcher<TCharType, IgnoreCase>::SizeType TMultiStringMatcher<TCharType, IgnoreCase>::ByteClassCount;
+}
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+
+#include <Common/CharTraits.hpp>
+#include <Common/CharSet.hpp>
+#include <Common/StringRef.hpp>
+
+namespace CppMiniToolkit
+{
+    namespace Details
+    {
+        // delimiter finders of TSplitView
+        // Find returns the position of the next delimiter at or after start, or npos
+        template <typename TCharType>
+        struct TSplitByChar
+        {
+            typedef typename TStringRef<TCharType>::SizeType SizeType;
+
+            TCharType Delimiter;
+
+            SizeType GetDelimiterLength() const
+            {
+                return 1;
+            }
+
+            // memchr/wmemchr
+            SizeType Find(const TCharType* str, const SizeType length, const SizeType start) const
+            {
+                const TCharType* result = TCharTraits<TCharType>::find(str + start, length - start, Delimiter);
+
+                return result != nullptr ? static_cast<SizeType>(result - str) : TStringRef<TCharType>::npos;
+            }
+        };
+
+        template <typename TCharType>
+        struct TSplitByAnyOf
+        {
+            typedef typename TStringRef<TCharType>::SizeType SizeType;
+
+            TCharSet<TCharType> Delimiters;
+
+            SizeType GetDelimiterLength() const
+            {
+                return 1;
+            }
+
+            SizeType Find(const TCharType* str, const SizeType length, const SizeType start) const
+            {
+                const TCharType* result = Delimiters.FindFirstOf(str + start, length - start);
+
+                return result != nullptr ? static_cast<SizeType>(result - str) : TStringRef<TCharType>::npos;
+            }
+        };
+
+        // an empty delimiter never matches
+        // the search goes on from token to token, so splitting costs one pass even for adversarial input
+        template <typename TCharType>
+        struct TSplitByString
+        {
+            typedef typename TStringRef<TCharType>::SizeType                        SizeType;
+            typedef typename TStringSearchKernels<TCharType>::TSearchCursor         CursorType;
+
+            TStringRef<TCharType>   Delimiter;
+            CursorType              Cursor;
+
+            TSplitByString()
+            {
+            }
+
+            TSplitByString(const TStringRef<TCharType>& delimiter) :
+                Delimiter(delimiter)
+            {
+            }
+
+            SizeType GetDelimiterLength() const
+            {
+                return Delimiter.GetLength();
+            }
+
+            // start is the end of the previous delimiter, the first call starts the search over str
+            SizeType Find(const TCharType* str, const SizeType length, const SizeType start)
+            {
+                if (start == 0)
+                {
+                    Cursor = CursorType(str, length, Delimiter.GetData(), Delimiter.GetLength());
+                }
+
+                const TCharType* result = Cursor.Next(start);
+
+                return result != nullptr ? static_cast<SizeType>(result - str) : TStringRef<TCharType>::npos;
+            }
+        };
+    }
+
+    // a lazy range of the tokens of a string, tokens are references into the source and are
+    // found one by one while iterating, so nothing is allocated and the walk can stop at any time
+    // without skipEmpty, n delimiters always produce n + 1 tokens, e.g. "a,,b" -> "a", "", "b"
+    // the source characters (and the delimiter string) must outlive the view and its iterators
+    template <typename TCharType, typename TDelimiterType>
+    class TSplitView
+    {
+    public:
+        typedef TStringRef<TCharType>                   ValueType;
+        typedef typename ValueType::SizeType            SizeType;
+
+        class Iterator
+        {
+        public:
+            typedef std::forward_iterator_tag           iterator_category;
+            typedef TStringRef<TCharType>               value_type;
+            typedef std::ptrdiff_t                      difference_type;
+            typedef const value_type*                   pointer;
+            typedef const value_type&                   reference;
+
+            Iterator() :
+                Delimiter(),
+                Next(0),
+                SkipEmpty(false),
+                Finished(true)
+            {
+            }
+
+            const value_type& operator *() const
+            {
+                return Token;
+            }
+
+            const value_type* operator ->() const
+            {
+                return &Token;
+            }
+
+            Iterator& operator ++()
+            {
+                Advance();
+                return *this;
+            }
+
+            Iterator operator ++(int)
+            {
+                Iterator result = *this;
+                Advance();
+                return result;
+            }
+
+            bool operator == (const Iterator& other) const
+            {
+                return Finished == other.Finished && (Finished || Next == other.Next);
+            }
+
+            bool operator != (const Iterator& other) const
+            {
+                return !(*this == other);
+            }
+
+        private:
+            friend class TSplitView;
+
+            Iterator(const ValueType& source, const TDelimiterType& delimiter, const bool skipEmpty) :
+                Source(source),
+                Delimiter(delimiter),
+                Next(0),
+                SkipEmpty(skipEmpty),
+                Finished(false)
+            {
+                Advance();
+            }
+
+            void Advance()
+            {
+                const SizeType length = Source.GetLength();
+
+                do
+                {
+                    // Next passes the end after the last token
+                    if (Next > length)
+                    {
+                        Finished = true;
+                        return;
+                    }
+
+                    const SizeType pos = Delimiter.Find(Source.GetData(), length, Next);
+
+                    if (pos == ValueType::npos)
+                    {
+                        Token = ValueType(Source.GetData() + Next, length - Next);
+                        Next = length + 1;
+                    }
+                    else
+                    {
+                        Token = ValueType(Source.GetData() + Next, pos - Next);
+                        Next = pos + Delimiter.GetDelimiterLength();
+                    }
+                } while (SkipEmpty && Token.IsEmpty());
+            }
+
+        private:
+            ValueType           Source;
+            TDelimiterType      Delimiter;
+            ValueType           Token;
+            SizeType            Next;
+            bool                SkipEmpty;
+            bool                Finished;
+        };
+
+        TSplitView(const ValueType& source, const TDelimiterType& delimiter, const bool skipEmpty) :
+            Source(source),
+            Delimiter(delimiter),
+            SkipEmpty(skipEmpty)
+        {
+        }
+
+        Iterator begin() const
+        {
+            return Iterator(Source, Delimiter, SkipEmpty);
+        }
+
+        Iterator end() const
+        {
+            return Iterator();
+        }
+
+    private:
+        ValueType           Source;
+        TDelimiterType      Delimiter;
+        bool                SkipEmpty;
+    };
+}
@@ -1,7 +1,18 @@
 ﻿#pragma once
 
 #include <string>
+#include <vector>
 #include <Common/CharTraits.hpp>
+#include <Common/DynamicBuffer.hpp>
+#include <Common/StringRef.hpp>
+#include <Common/InlineString.hpp>
+#include <Common/CharSet.hpp>
+#include <Common/Details/CaseConversionKernels.hpp>
+#include <Algorithm/StringSearcher.hpp>
+#include <Algorithm/GlobPattern.hpp>
+#include <Algorithm/FuzzyMatcher.hpp>
+#include <Algorithm/MultiStringMatcher.hpp>
+#include <Algorithm/SplitView.hpp>
 
 namespace CppMiniToolkit
 {
@@ -48,6 +59,20 @@ namespace CppMiniToolkit
             return TCharTraits<TCharType>::iCompare(first, second) == 0;
         }
 
+        // string references, the second argument can also be a string or a pointer
+        template <typename TCharType>
+        static bool Equal(const TStringRef<TCharType>& first, const Details::TStringRefArgument<TCharType>& second)
+        {
+            return first == second;
+        }
+
+        template <typename TCharType>
+        static bool iEqual(const TStringRef<TCharType>& first, const Details::TStringRefArgument<TCharType>& second)
+        {
+            return first.GetLength() == second.GetLength() &&
+                (first.IsEmpty() || TCharTraits<TCharType>::iCompareN(first.GetData(), second.GetData(), first.GetLength()) == 0);
+        }
+
         // search and identifier
         template <typename TCharType>
         static bool StartWith(const std::basic_string<TCharType>& str, const std::basic_string<TCharType>& start)
@@ -89,16 +114,30 @@ namespace CppMiniToolkit
             return TCharTraits<TCharType>::iCompareN(str, start, TCharTraits<TCharType>::length(start)) == 0;
         }
 
+        template <typename TCharType>
+        static bool StartWith(const TStringRef<TCharType>& str, const Details::TStringRefArgument<TCharType>& start)
+        {
+            return str.GetLength() >= start.GetLength() &&
+                (start.IsEmpty() || TCharTraits<TCharType>::compare(str.GetData(), start.GetData(), start.GetLength()) == 0);
+        }
+
+        template <typename TCharType>
+        static bool iStartWith(const TStringRef<TCharType>& str, const Details::TStringRefArgument<TCharType>& start)
+        {
+            return str.GetLength() >= start.GetLength() &&
+                (start.IsEmpty() || TCharTraits<TCharType>::iCompareN(str.GetData(), start.GetData(), start.GetLength()) == 0);
+        }
+
         template <typename TCharType>
         static bool Contains(const std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match)
         {
-            return str.find(match) != std::basic_string<TCharType>::npos;
+            return TCharTraits<TCharType>::Find(str.c_str(), str.size(), match.c_str(), match.size()) != nullptr;
         }
 
         template <typename TCharType>
         static bool Contains(const std::basic_string<TCharType>& str, const TCharType* match)
         {
-            return str.find(match) != std::basic_string<TCharType>::npos;
+            return TCharTraits<TCharType>::Find(str.c_str(), str.size(), match, TCharTraits<TCharType>::length(match)) != nullptr;
         }
 
         template <typename TCharType>
@@ -107,16 +146,22 @@ namespace CppMiniToolkit
             return TCharTraits<TCharType>::Find(str, match) != nullptr;
         }
 
+        template <typename TCharType>
+        static bool Contains(const TCharType* str, const std::size_t strLength, const TCharType* match, const std::size_t matchLength)
+        {
+            return TCharTraits<TCharType>::Find(str, strLength, match, matchLength) != nullptr;
+        }
+
         template <typename TCharType>
         static bool iContains(const std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match)
         {
-            return TCharTraits<TCharType>::iFind(str.c_str(), match.c_str()) != nullptr;
+            return TCharTraits<TCharType>::iFind(str.c_str(), str.size(), match.c_str(), match.size()) != nullptr;
         }
 
         template <typename TCharType>
         static bool iContains(const std::basic_string<TCharType>& str, const TCharType* match)
         {
-            return TCharTraits<TCharType>::iFind(str.c_str(), match) != nullptr;
+            return TCharTraits<TCharType>::iFind(str.c_str(), str.size(), match, TCharTraits<TCharType>::length(match)) != nullptr;
         }
 
         template <typename TCharType>
@@ -125,10 +170,105 @@ namespace CppMiniToolkit
             return TCharTraits<TCharType>::iFind(str, match) != nullptr;
         }
 
+        template <typename TCharType>
+        static bool iContains(const TCharType* str, const std::size_t strLength, const TCharType* match, const std::size_t matchLength)
+        {
+            return TCharTraits<TCharType>::iFind(str, strLength, match, matchLength) != nullptr;
+        }
+
+        template <typename TCharType>
+        static bool Contains(const TStringRef<TCharType>& str, const Details::TStringRefArgument<TCharType>& match)
+        {
+            return TCharTraits<TCharType>::Find(str.GetData(), str.GetLength(), match.GetData(), match.GetLength()) != nullptr;
+        }
+
+        template <typename TCharType>
+        static bool iContains(const TStringRef<TCharType>& str, const Details::TStringRefArgument<TCharType>& match)
+        {
+            return TCharTraits<TCharType>::iFind(str.GetData(), str.GetLength(), match.GetData(), match.GetLength()) != nullptr;
+        }
+
+        // search with a precompiled searcher, the searcher decides whether case is ignored
+        template <typename TCharType, bool IgnoreCase>
+        static bool Contains(const std::basic_string<TCharType>& str, const TStringSearcher<TCharType, IgnoreCase>& searcher)
+        {
+            return searcher.ContainsIn(str);
+        }
+
+        template <typename TCharType, bool IgnoreCase>
+        static bool Contains(const TCharType* str, const TStringSearcher<TCharType, IgnoreCase>& searcher)
+        {
+            return searcher.ContainsIn(str);
+        }
+
+        template <typename TCharType, bool IgnoreCase>
+        static bool Contains(const TCharType* str, const std::size_t strLength, const TStringSearcher<TCharType, IgnoreCase>& searcher)
+        {
+            return searcher.ContainsIn(str, strLength);
+        }
+
+        template <typename TCharType, bool IgnoreCase>
+        static bool Contains(const TStringRef<TCharType>& str, const TStringSearcher<TCharType, IgnoreCase>& searcher)
+        {
+            return searcher.ContainsIn(str.GetData(), str.GetLength());
+        }
+
+        template <typename TCharType>
+        static bool iContains(const std::basic_string<TCharType>& str, const TStringSearcher<TCharType, true>& searcher)
+        {
+            return searcher.ContainsIn(str);
+        }
+
+        template <typename TCharType>
+        static bool iContains(const TCharType* str, const TStringSearcher<TCharType, true>& searcher)
+        {
+            return searcher.ContainsIn(str);
+        }
+
+        template <typename TCharType>
+        static bool iContains(const TCharType* str, const std::size_t strLength, const TStringSearcher<TCharType, true>& searcher)
+        {
+            return searcher.ContainsIn(str, strLength);
+        }
+
+        // multi pattern search, every pattern of the matcher is checked in one pass
+        template <typename TCharType, bool IgnoreCase>
+        static bool ContainsAny(const std::basic_string<TCharType>& str, const TMultiStringMatcher<TCharType, IgnoreCase>& matcher)
+        {
+            return matcher.ContainsAnyIn(str);
+        }
+
+        template <typename TCharType, bool IgnoreCase>
+        static bool ContainsAny(const TCharType* str, const TMultiStringMatcher<TCharType, IgnoreCase>& matcher)
+        {
+            return matcher.ContainsAnyIn(str, TCharTraits<TCharType>::length(str));
+        }
+
+        template <typename TCharType, bool IgnoreCase>
+        static bool ContainsAny(const TCharType* str, const std::size_t strLength, const TMultiStringMatcher<TCharType, IgnoreCase>& matcher)
+        {
+            return matcher.ContainsAnyIn(str, strLength);
+        }
+
+        template <typename TCharType, bool IgnoreCase>
+        static bool ContainsAny(const TStringRef<TCharType>& str, const TMultiStringMatcher<TCharType, IgnoreCase>& matcher)
+        {
+            return matcher.ContainsAnyIn(str.GetData(), str.GetLength());
+        }
+
+        // position of the leftmost match of any pattern, npos if nothing matches
+        template <typename TCharType, bool IgnoreCase>
+        static typename std::basic_string<TCharType>::size_type FindAny(const std::basic_string<TCharType>& str, const TMultiStringMatcher<TCharType, IgnoreCase>& matcher)
+        {
+            typename TMultiStringMatcher<TCharType, IgnoreCase>::MatchResult result;
+
+            return matcher.FindFirstIn(str, result) ? result.Position : std::basic_string<TCharType>::npos;
+        }
+
         template <typename TCharType>
         static bool EndWith(const std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match)
         {
-            return str.size() >= match.size() && str.rfind(match) == str.size() - match.size();
+            return str.size() >= match.size() && str.compare(str.size() - match.size(), match.size(), match) == 0;
         }
 
         template <typename TCharType>
@@ -136,7 +276,7 @@ namespace CppMiniToolkit
         {
             std::size_t matchLength = TCharTraits<TCharType>::length(match);
 
-            return str.size() >= matchLength && str.rfind(match) == str.size() - matchLength;
+            return str.size() >= matchLength && str.compare(str.size() - matchLength, matchLength, match, matchLength) == 0;
         }
 
         template <typename TCharType>
@@ -176,267 +316,923 @@ namespace CppMiniToolkit
             return strLength >= matchLength && TCharTraits<TCharType>::iCompareN(str + strLength - matchLength, match, matchLength) == 0;
         }
 
-        // replace
-    private:
-        template <typename TCharType, bool IgnoreCase>
-        static std::basic_string<TCharType>& ReplaceCore(std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        template <typename TCharType>
+        static bool EndWith(const TStringRef<TCharType>& str, const Details::TStringRefArgument<TCharType>& match)
         {
-            auto ptr = IgnoreCase ? TCharTraits<TCharType>::iFind(str.c_str(), match.c_str()) : TCharTraits<TCharType>::Find(str.c_str(), match.c_str());
+            const std::size_t strLength = str.GetLength();
+            const std::size_t matchLength = match.GetLength();
 
-            if (ptr != nullptr)
-            {
-                auto pos = ptr - str.c_str();
+            return strLength >= matchLength &&
+                (matchLength == 0 || TCharTraits<TCharType>::compare(str.GetData() + strLength - matchLength, match.GetData(), matchLength) == 0);
+        }
 
-                str.replace(pos, match.size(), replace);
-            }
+        template <typename TCharType>
+        static bool iEndWith(const TStringRef<TCharType>& str, const Details::TStringRefArgument<TCharType>& match)
+        {
+            const std::size_t strLength = str.GetLength();
+            const std::size_t matchLength = match.GetLength();
 
-            return str;
+            return strLength >= matchLength &&
+                (matchLength == 0 || TCharTraits<TCharType>::iCompareN(str.GetData() + strLength - matchLength, match.GetData(), matchLength) == 0);
         }
 
-    public:
+        // glob match of the whole str: '*' matches any run of characters, '?' a single one, see TGlobPattern
+        // the pattern is compiled on every call, compile a TGlobPattern once to test many strings
         template <typename TCharType>
-        static std::basic_string<TCharType>& Replace(std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        static bool Match(const TStringRef<TCharType>& str, const Details::TStringRefArgument<TCharType>& pattern)
         {
-            return ReplaceCore<TCharType, false>(str, match, replace);
+            return TGlobPattern<TCharType>(pattern.GetData(), pattern.GetLength()).Match(str);
         }
 
         template <typename TCharType>
-        static std::basic_string<TCharType> ReplaceCopy(const std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        static bool Match(const std::basic_string<TCharType>& str, const Details::TStringRefArgument<TCharType>& pattern)
         {
-            auto result = str;
-            Replace(result, match, replace);
-            return result;
+            return Match(TStringRef<TCharType>(str), pattern);
         }
 
         template <typename TCharType>
-        static std::basic_string<TCharType>& iReplace(std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        static bool iMatch(const TStringRef<TCharType>& str, const Details::TStringRefArgument<TCharType>& pattern)
         {
-            return ReplaceCore<TCharType, true>(str, match, replace);
+            return TGlobPattern<TCharType, true>(pattern.GetData(), pattern.GetLength()).Match(str);
         }
 
         template <typename TCharType>
-        static std::basic_string<TCharType> iReplaceCopy(const std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        static bool iMatch(const std::basic_string<TCharType>& str, const Details::TStringRefArgument<TCharType>& pattern)
         {
-            auto result = str;
-            iReplace(result, match, replace);
-            return result;
+            return iMatch(TStringRef<TCharType>(str), pattern);
         }
 
-    private:
         template <typename TCharType, bool IgnoreCase>
-        static std::basic_string<TCharType>& ReplaceAllCore(std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        static bool Match(const TStringRef<TCharType>& str, const TGlobPattern<TCharType, IgnoreCase>& pattern)
         {
-            typename std::basic_string<TCharType>::size_type startPos = std::basic_string<TCharType>::npos;
-
-            do
-            {
-                auto ptr = !IgnoreCase ? TCharTraits<TCharType>::Find(str.c_str() + startPos, match.c_str()) : TCharTraits<TCharType>::iFind(str.c_str() + startPos, match.c_str());
-
-                if (ptr == nullptr)
-                {
-                    break;
-                }
-
-                startPos = ptr - str.c_str() + match.size();
-                str.replace(ptr - str.c_str(), match.size(), replace);
-            } while (true);
+            return pattern.Match(str);
+        }
 
-            return str;
+        template <typename TCharType, bool IgnoreCase>
+        static bool Match(const std::basic_string<TCharType>& str, const TGlobPattern<TCharType, IgnoreCase>& pattern)
+        {
+            return pattern.Match(str.c_str(), str.size());
         }
 
-    public:
+        // Levenshtein distance: the fewest insertions, deletions and substitutions turning str into other
+        // with maxDistance the comparison stops early and returns maxDistance + 1 for more distant strings,
+        // use TFuzzyMatcher to compare one string with many
         template <typename TCharType>
-        static std::basic_string<TCharType>& ReplaceAll(std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        static std::size_t EditDistance(const TStringRef<TCharType>& str, const Details::TStringRefArgument<TCharType>& other, const std::size_t maxDistance = SIZE_MAX)
         {
-            return ReplaceAllCore<TCharType, false>(str, match, replace);
+            return TCharTraits<TCharType>::EditDistance(str.GetData(), str.GetLength(), other.GetData(), other.GetLength(), maxDistance);
         }
 
         template <typename TCharType>
-        static std::basic_string<TCharType> ReplaceAllCopy(const std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        static std::size_t EditDistance(const std::basic_string<TCharType>& str, const Details::TStringRefArgument<TCharType>& other, const std::size_t maxDistance = SIZE_MAX)
         {
-            auto result = str;
-            ReplaceAll(result, match, replace);
-            return result;
+            return TCharTraits<TCharType>::EditDistance(str.c_str(), str.size(), other.GetData(), other.GetLength(), maxDistance);
         }
 
         template <typename TCharType>
-        static std::basic_string<TCharType>& iReplaceAll(std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        static std::size_t EditDistance(const TCharType* str, const Details::TStringRefArgument<TCharType>& other, const std::size_t maxDistance = SIZE_MAX)
         {
-            return ReplaceAllCore<TCharType, true>(str, match, replace);
+            return TCharTraits<TCharType>::EditDistance(str, TCharTraits<TCharType>::length(str), other.GetData(), other.GetLength(), maxDistance);
         }
 
         template <typename TCharType>
-        static std::basic_string<TCharType> iReplaceAllCopy(const std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        static std::size_t iEditDistance(const TStringRef<TCharType>& str, const Details::TStringRefArgument<TCharType>& other, const std::size_t maxDistance = SIZE_MAX)
         {
-            auto result = str;
-            iReplaceAll(result, match, replace);
-            return result;
+            return TCharTraits<TCharType>::iEditDistance(str.GetData(), str.GetLength(), other.GetData(), other.GetLength(), maxDistance);
         }
 
-        // trim
-        template <typename TCharType, typename Predicate>
-        static std::basic_string<TCharType>& TrimLeft(std::basic_string<TCharType>& str, Predicate predicate)
+        template <typename TCharType>
+        static std::size_t iEditDistance(const std::basic_string<TCharType>& str, const Details::TStringRefArgument<TCharType>& other, const std::size_t maxDistance = SIZE_MAX)
         {
-            for (size_t i = 0; i < str.size(); ++i)
-            {
-                if (!predicate(str[i]))
-                {
-                    if (i > 0)
-                    {
-                        str.erase(0, i);
-                    }
-
-                    break;
-                }
-            }
-
-            return str;
+            return TCharTraits<TCharType>::iEditDistance(str.c_str(), str.size(), other.GetData(), other.GetLength(), maxDistance);
         }
 
-        template <typename TCharType, typename Predicate>
-        static std::basic_string<TCharType> TrimLeftCopy(const std::basic_string<TCharType>& str, Predicate predicate)
+        template <typename TCharType>
+        static std::size_t iEditDistance(const TCharType* str, const Details::TStringRefArgument<TCharType>& other, const std::size_t maxDistance = SIZE_MAX)
         {
-            auto result = str;
-            TrimLeft<TCharType, Predicate>(result, predicate);
-            return result;
+            return TCharTraits<TCharType>::iEditDistance(str, TCharTraits<TCharType>::length(str), other.GetData(), other.GetLength(), maxDistance);
         }
 
+        // find all: the offset of every occurrence of match in one scan of str, appended to positions from left to right
+        // without overlapping the search resumes after each match ("aaaa" contains "aa" twice), with overlapping
+        // at the next character (three times). an empty match has no occurrences, the number of occurrences is returned
         template <typename TCharType>
-        static std::basic_string<TCharType>& TrimLeft(std::basic_string<TCharType>& str)
+        static std::size_t FindAll(std::vector<std::size_t>& positions, const TStringRef<TCharType>& str, const Details::TStringRefArgument<TCharType>& match, const bool overlapping = false)
         {
-            return TrimLeft(str, TCharTraits<TCharType>::IsSpace);
+            auto onMatch = [&positions](const std::size_t offset) { positions.push_back(offset); };
+
+            return FindAllCore<TCharType, false>(str.GetData(), str.GetLength(), match, overlapping, onMatch);
         }
 
         template <typename TCharType>
-        static std::basic_string<TCharType> TrimLeftCopy(const std::basic_string<TCharType>& str)
+        static std::size_t FindAll(std::vector<std::size_t>& positions, const std::basic_string<TCharType>& str, const Details::TStringRefArgument<TCharType>& match, const bool overlapping = false)
         {
-            auto result = str;
-            TrimLeft<TCharType>(result);
-            return result;
+            auto onMatch = [&positions](const std::size_t offset) { positions.push_back(offset); };
+
+            return FindAllCore<TCharType, false>(str.c_str(), str.size(), match, overlapping, onMatch);
         }
 
-        template <typename TCharType, typename Predicate>
-        static std::basic_string<TCharType>& TrimRight(std::basic_string<TCharType>& str, Predicate predicate)
+        template <typename TCharType>
+        static std::size_t iFindAll(std::vector<std::size_t>& positions, const TStringRef<TCharType>& str, const Details::TStringRefArgument<TCharType>& match, const bool overlapping = false)
         {
-            if (str.empty())
-            {
-                return str;
-            }
+            auto onMatch = [&positions](const std::size_t offset) { positions.push_back(offset); };
 
-            for (auto i = str.size() - 1; i >= 0 && i < str.size(); --i)
-            {
-                if (!predicate(str[i]))
-                {
-                    if (i < str.size() - 1)
-                    {
-                        str.erase(i + 1, str.size() - i - 1);
-                    }
+            return FindAllCore<TCharType, true>(str.GetData(), str.GetLength(), match, overlapping, onMatch);
+        }
 
-                    break;
-                }
-            }
+        template <typename TCharType>
+        static std::size_t iFindAll(std::vector<std::size_t>& positions, const std::basic_string<TCharType>& str, const Details::TStringRefArgument<TCharType>& match, const bool overlapping = false)
+        {
+            auto onMatch = [&positions](const std::size_t offset) { positions.push_back(offset); };
 
-            return str;
+            return FindAllCore<TCharType, true>(str.c_str(), str.size(), match, overlapping, onMatch);
         }
 
-        template <typename TCharType, typename Predicate>
-        static std::basic_string<TCharType> TrimRightCopy(const std::basic_string<TCharType>& str, Predicate predicate)
+        // onMatch(offset) is called for every occurrence instead of collecting the offsets
+        template <typename TCharType, typename TCallback>
+        static std::size_t FindAll(const TStringRef<TCharType>& str, const Details::TStringRefArgument<TCharType>& match, TCallback onMatch, const bool overlapping = false)
         {
-            auto result = str;
-            TrimRight<TCharType, Predicate>(result, predicate);
-            return result;
+            return FindAllCore<TCharType, false>(str.GetData(), str.GetLength(), match, overlapping, onMatch);
         }
 
-        template <typename TCharType>
-        static std::basic_string<TCharType>& TrimRight(std::basic_string<TCharType>& str)
+        template <typename TCharType, typename TCallback>
+        static std::size_t FindAll(const std::basic_string<TCharType>& str, const Details::TStringRefArgument<TCharType>& match, TCallback onMatch, const bool overlapping = false)
         {
-            return TrimRight(str, TCharTraits<TCharType>::IsSpace);
+            return FindAllCore<TCharType, false>(str.c_str(), str.size(), match, overlapping, onMatch);
         }
 
-        template <typename TCharType>
-        static std::basic_string<TCharType> TrimRightCopy(const std::basic_string<TCharType>& str)
+        template <typename TCharType, typename TCallback>
+        static std::size_t iFindAll(const TStringRef<TCharType>& str, const Details::TStringRefArgument<TCharType>& match, TCallback onMatch, const bool overlapping = false)
         {
-            auto result = str;
-            TrimRight<TCharType>(result);
-            return result;
+            return FindAllCore<TCharType, true>(str.GetData(), str.GetLength(), match, overlapping, onMatch);
         }
 
-        template <typename TCharType, typename Predicate>
-        static std::basic_string<TCharType>& Trim(std::basic_string<TCharType>& str, Predicate predicate)
+        template <typename TCharType, typename TCallback>
+        static std::size_t iFindAll(const std::basic_string<TCharType>& str, const Details::TStringRefArgument<TCharType>& match, TCallback onMatch, const bool overlapping = false)
         {
-            if (str.empty())
-            {
-                return str;
-            }
-
-            TrimLeft<TCharType, Predicate>(str, predicate);
-            TrimRight<TCharType, Predicate>(str, predicate);
-            return str;
+            return FindAllCore<TCharType, true>(str.c_str(), str.size(), match, overlapping, onMatch);
         }
 
-        template <typename TCharType, typename Predicate>
-        static std::basic_string<TCharType> TrimCopy(const std::basic_string<TCharType>& str, Predicate predicate)
+        // number of occurrences of match, counted like FindAll
+        template <typename TCharType>
+        static std::size_t Count(const TStringRef<TCharType>& str, const Details::TStringRefArgument<TCharType>& match, const bool overlapping = false)
         {
-            auto result = str;
-            Trim<TCharType, Predicate>(result, predicate);
-            return result;
+            auto onMatch = [](std::size_t) {};
+
+            return FindAllCore<TCharType, false>(str.GetData(), str.GetLength(), match, overlapping, onMatch);
         }
 
         template <typename TCharType>
-        static std::basic_string<TCharType>& Trim(std::basic_string<TCharType>& str)
+        static std::size_t Count(const std::basic_string<TCharType>& str, const Details::TStringRefArgument<TCharType>& match, const bool overlapping = false)
         {
-            TrimLeft<TCharType>(str);
-            TrimRight<TCharType>(str);
-            return str;
+            auto onMatch = [](std::size_t) {};
+
+            return FindAllCore<TCharType, false>(str.c_str(), str.size(), match, overlapping, onMatch);
         }
 
         template <typename TCharType>
-        static std::basic_string<TCharType> TrimCopy(const std::basic_string<TCharType>& str)
+        static std::size_t iCount(const TStringRef<TCharType>& str, const Details::TStringRefArgument<TCharType>& match, const bool overlapping = false)
         {
-            auto result = str;
-            Trim<TCharType>(result);
-            return result;
+            auto onMatch = [](std::size_t) {};
+
+            return FindAllCore<TCharType, true>(str.GetData(), str.GetLength(), match, overlapping, onMatch);
         }
 
-        // upper/lower
         template <typename TCharType>
-        static std::basic_string<TCharType>& ToUpper(std::basic_string<TCharType>& str)
+        static std::size_t iCount(const std::basic_string<TCharType>& str, const Details::TStringRefArgument<TCharType>& match, const bool overlapping = false)
         {
-            for (auto iter = str.begin(); iter != str.end(); ++iter)
-            {
-                *iter = static_cast<TCharType>(TCharTraits<TCharType>::ToUpper(*iter));
-            }
+            auto onMatch = [](std::size_t) {};
 
-            return str;
+            return FindAllCore<TCharType, true>(str.c_str(), str.size(), match, overlapping, onMatch);
         }
 
-        template <typename TCharType>
-        static std::basic_string<TCharType>& ToLower(std::basic_string<TCharType>& str)
+    private:
+        template <typename TCharType, bool IgnoreCase, typename TCallback>
+        static std::size_t FindAllCore(const TCharType* str, const std::size_t strLength, const TStringRef<TCharType>& match, const bool overlapping, TCallback& onMatch)
+        {
+            return IgnoreCase ?
+                TCharTraits<TCharType>::iFindAll(str, strLength, match.GetData(), match.GetLength(), overlapping, onMatch) :
+                TCharTraits<TCharType>::FindAll(str, strLength, match.GetData(), match.GetLength(), overlapping, onMatch);
+        }
+
+        // replace
+    private:
+        template <typename TCharType, bool IgnoreCase>
+        static std::basic_string<TCharType>& ReplaceCore(std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
         {
-            for (auto iter = str.begin(); iter != str.end(); ++iter)
+            auto ptr = IgnoreCase ? 
+                TCharTraits<TCharType>::iFind(str.c_str(), str.size(), match.c_str(), match.size()) : 
+                TCharTraits<TCharType>::Find(str.c_str(), str.size(), match.c_str(), match.size());
+
+            if (ptr != nullptr)
             {
-                *iter = static_cast<TCharType>(TCharTraits<TCharType>::ToLower(*iter));
+                auto pos = ptr - str.c_str();
+
+                str.replace(pos, match.size(), replace);
             }
 
             return str;
         }
 
+    public:
         template <typename TCharType>
-        static std::basic_string<TCharType> ToUpperCopy(const std::basic_string<TCharType>& str)
+        static std::basic_string<TCharType>& Replace(std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
         {
-            auto result = str;
-            ToUpper<TCharType>(result);
-            return result;
+            return ReplaceCore<TCharType, false>(str, match, replace);
         }
 
         template <typename TCharType>
-        static std::basic_string<TCharType> ToLowerCopy(const std::basic_string<TCharType>& str)
+        static std::basic_string<TCharType> ReplaceCopy(const std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
         {
             auto result = str;
-            ToLower<TCharType>(result);
+            Replace(result, match, replace);
             return result;
         }
 
+        template <typename TCharType>
+        static std::basic_string<TCharType>& iReplace(std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        {
+            return ReplaceCore<TCharType, true>(str, match, replace);
+        }
+
+        template <typename TCharType>
+        static std::basic_string<TCharType> iReplaceCopy(const std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        {
+            auto result = str;
+            iReplace(result, match, replace);
+            return result;
+        }
+
+    private:
+        // offsets of the non overlapping matches, found in one pass over str
+        template <typename TCharType, bool IgnoreCase>
+        static void FindReplaceOffsets(const std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, std::vector<std::size_t>& offsets)
+        {
+            auto onMatch = [&offsets](const std::size_t offset) { offsets.push_back(offset); };
+
+            FindAllCore<TCharType, IgnoreCase>(str.c_str(), str.size(), TStringRef<TCharType>(match.c_str(), match.size()), false, onMatch);
+        }
+
+        // size of the result of replacing the matches at offsets
+        template <typename TCharType>
+        static std::size_t ReplaceAllLength(const std::basic_string<TCharType>& str, const std::vector<std::size_t>& offsets, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        {
+            return str.size() - offsets.size() * match.size() + offsets.size() * replace.size();
+        }
+
+        // walk the result of replacing the matches at offsets, appender receives (pointer, length) pieces in order
+        template <typename TCharType, typename TAppender>
+        static void ReplaceAllPieces(
+            const std::basic_string<TCharType>& str,
+            const std::vector<std::size_t>& offsets,
+            const std::basic_string<TCharType>& match,
+            const std::basic_string<TCharType>& replace,
+            TAppender& appender
+            )
+        {
+            std::size_t position = 0;
+
+            for (const std::size_t offset : offsets)
+            {
+                appender(str.c_str() + position, offset - position);
+                appender(replace.c_str(), replace.size());
+
+                position = offset + match.size();
+            }
+
+            appender(str.c_str() + position, str.size() - position);
+        }
+
+        template <typename TCharType, bool IgnoreCase>
+        static std::basic_string<TCharType>& ReplaceAllIntoCore(std::basic_string<TCharType>& output, const std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        {
+            std::vector<std::size_t> offsets;
+            FindReplaceOffsets<TCharType, IgnoreCase>(str, match, offsets);
+
+            if (offsets.empty())
+            {
+                return output.append(str);
+            }
+
+            output.reserve(output.size() + ReplaceAllLength(str, offsets, match, replace));
+
+            auto appender = [&output](const TCharType* piece, const std::size_t pieceLength) { output.append(piece, pieceLength); };
+            ReplaceAllPieces(str, offsets, match, replace, appender);
+
+            return output;
+        }
+
+        template <typename TCharType, bool IgnoreCase, int AlignLength>
+        static TDynamicBuffer<AlignLength>& ReplaceAllIntoCore(TDynamicBuffer<AlignLength>& output, const std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        {
+            std::vector<std::size_t> offsets;
+            FindReplaceOffsets<TCharType, IgnoreCase>(str, match, offsets);
+
+            output.Reserve(output.GetSize() + ReplaceAllLength(str, offsets, match, replace) * sizeof(TCharType));
+
+            auto appender = [&output](const TCharType* piece, const std::size_t pieceLength)
+                {
+                    if (pieceLength > 0)
+                    {
+                        output.Append(piece, pieceLength * sizeof(TCharType));
+                    }
+                };
+
+            ReplaceAllPieces(str, offsets, match, replace, appender);
+
+            return output;
+        }
+
+        // runs in O(n): the matches are found in one pass, then the string is compacted in place when the
+        // replacement is not longer than the match, otherwise the result is sized up front and written once
+        template <typename TCharType, bool IgnoreCase>
+        static std::basic_string<TCharType>& ReplaceAllCore(std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        {
+            if (match.empty() || str.empty())
+            {
+                return str;
+            }
+
+            if (replace.size() > match.size())
+            {
+                std::basic_string<TCharType> result;
+                ReplaceAllIntoCore<TCharType, IgnoreCase>(result, str, match, replace);
+                str.swap(result);
+
+                return str;
+            }
+
+            std::vector<std::size_t> offsets;
+            FindReplaceOffsets<TCharType, IgnoreCase>(str, match, offsets);
+
+            // the write position never passes the read position
+            TCharType* data = &str[0];
+            const std::size_t length = str.size();
+            std::size_t readPos = 0;
+            std::size_t writePos = 0;
+
+            for (const std::size_t offset : offsets)
+            {
+                if (writePos != readPos)
+                {
+                    TCharTraits<TCharType>::move(data + writePos, data + readPos, offset - readPos);
+                }
+
+                writePos += offset - readPos;
+                TCharTraits<TCharType>::copy(data + writePos, replace.c_str(), replace.size());
+                writePos += replace.size();
+                readPos = offset + match.size();
+            }
+
+            if (writePos != readPos)
+            {
+                TCharTraits<TCharType>::move(data + writePos, data + readPos, length - readPos);
+                str.resize(writePos + length - readPos);
+            }
+
+            return str;
+        }
+
+    public:
+        template <typename TCharType>
+        static std::basic_string<TCharType>& ReplaceAll(std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        {
+            return ReplaceAllCore<TCharType, false>(str, match, replace);
+        }
+
+        template <typename TCharType>
+        static std::basic_string<TCharType> ReplaceAllCopy(const std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        {
+            std::basic_string<TCharType> result;
+            ReplaceAllIntoCore<TCharType, false>(result, str, match, replace);
+            return result;
+        }
+
+        template <typename TCharType>
+        static std::basic_string<TCharType>& iReplaceAll(std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        {
+            return ReplaceAllCore<TCharType, true>(str, match, replace);
+        }
+
+        template <typename TCharType>
+        static std::basic_string<TCharType> iReplaceAllCopy(const std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        {
+            std::basic_string<TCharType> result;
+            ReplaceAllIntoCore<TCharType, true>(result, str, match, replace);
+            return result;
+        }
+
+        // append the replaced result to output, so one output can be reused across calls
+        template <typename TCharType>
+        static std::basic_string<TCharType>& ReplaceAllInto(std::basic_string<TCharType>& output, const std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        {
+            return ReplaceAllIntoCore<TCharType, false>(output, str, match, replace);
+        }
+
+        template <typename TCharType>
+        static std::basic_string<TCharType>& iReplaceAllInto(std::basic_string<TCharType>& output, const std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        {
+            return ReplaceAllIntoCore<TCharType, true>(output, str, match, replace);
+        }
+
+        // the buffer receives the raw characters, without terminating zero
+        template <typename TCharType, int AlignLength>
+        static TDynamicBuffer<AlignLength>& ReplaceAllInto(TDynamicBuffer<AlignLength>& output, const std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        {
+            return ReplaceAllIntoCore<TCharType, false>(output, str, match, replace);
+        }
+
+        template <typename TCharType, int AlignLength>
+        static TDynamicBuffer<AlignLength>& iReplaceAllInto(TDynamicBuffer<AlignLength>& output, const std::basic_string<TCharType>& str, const std::basic_string<TCharType>& match, const std::basic_string<TCharType>& replace)
+        {
+            return ReplaceAllIntoCore<TCharType, true>(output, str, match, replace);
+        }
+
+        // replace many patterns in one pass
+    private:
+        template <typename TCharType, bool IgnoreCase, typename TReplacementSequenceType>
+        static std::basic_string<TCharType>& ReplaceAllManyIntoCore(
+            std::basic_string<TCharType>& output, 
+            const std::basic_string<TCharType>& str, 
+            const TMultiStringMatcher<TCharType, IgnoreCase>& matcher, 
+            const TReplacementSequenceType& replacements
+            )
+        {
+            typedef typename TMultiStringMatcher<TCharType, IgnoreCase>::MatchResult MatchResultType;
+
+            std::vector<MatchResultType> matches;
+            matcher.ScanLeftmostLongestIn(str, [&matches](const MatchResultType& match)
+                {
+                    matches.push_back(match);
+                    return true;
+                });
+
+            if (matches.empty())
+            {
+                return output.append(str);
+            }
+
+            std::size_t length = str.size();
+
+            for (const auto& match : matches)
+            {
+                length += Shims::LengthOf(replacements[match.PatternIndex]) - match.Length;
+            }
+
+            output.reserve(output.size() + length);
+
+            std::size_t position = 0;
+
+            for (const auto& match : matches)
+            {
+                const auto& replace = replacements[match.PatternIndex];
+
+                output.append(str, position, match.Position - position);
+                output.append(Shims::PtrOf(replace), Shims::LengthOf(replace));
+
+                position = match.Position + match.Length;
+            }
+
+            return output.append(str, position, std::basic_string<TCharType>::npos);
+        }
+
+        template <typename TCharType, bool IgnoreCase, typename TMapType>
+        static std::basic_string<TCharType>& ReplaceAllManyIntoCore(std::basic_string<TCharType>& output, const std::basic_string<TCharType>& str, const TMapType& replacements)
+        {
+            TMultiStringMatcher<TCharType, IgnoreCase> matcher;
+            std::vector<std::basic_string<TCharType>> values;
+
+            for (const auto& item : replacements)
+            {
+                matcher.AddPattern(item.first);
+                values.push_back(item.second);
+            }
+
+            matcher.Build();
+
+            return ReplaceAllManyIntoCore<TCharType, IgnoreCase>(output, str, matcher, values);
+        }
+
+    public:
+        // replacements maps every pattern to its replacement, e.g. std::map<std::string, std::string>
+        // overlapping matches are resolved leftmost-longest
+        template <typename TCharType, typename TMapType>
+        static std::basic_string<TCharType>& ReplaceAllMany(std::basic_string<TCharType>& str, const TMapType& replacements)
+        {
+            std::basic_string<TCharType> result;
+            ReplaceAllManyIntoCore<TCharType, false>(result, str, replacements);
+            str.swap(result);
+            return str;
+        }
+
+        template <typename TCharType, typename TMapType>
+        static std::basic_string<TCharType> ReplaceAllManyCopy(const std::basic_string<TCharType>& str, const TMapType& replacements)
+        {
+            std::basic_string<TCharType> result;
+            ReplaceAllManyIntoCore<TCharType, false>(result, str, replacements);
+            return result;
+        }
+
+        template <typename TCharType, typename TMapType>
+        static std::basic_string<TCharType>& iReplaceAllMany(std::basic_string<TCharType>& str, const TMapType& replacements)
+        {
+            std::basic_string<TCharType> result;
+            ReplaceAllManyIntoCore<TCharType, true>(result, str, replacements);
+            str.swap(result);
+            return str;
+        }
+
+        template <typename TCharType, typename TMapType>
+        static std::basic_string<TCharType> iReplaceAllManyCopy(const std::basic_string<TCharType>& str, const TMapType& replacements)
+        {
+            std::basic_string<TCharType> result;
+            ReplaceAllManyIntoCore<TCharType, true>(result, str, replacements);
+            return result;
+        }
+
+        // reuse a prebuilt matcher, replacements[i] replaces the pattern with index i
+        template <typename TCharType, bool IgnoreCase, typename TReplacementSequenceType>
+        static std::basic_string<TCharType>& ReplaceAllMany(std::basic_string<TCharType>& str, const TMultiStringMatcher<TCharType, IgnoreCase>& matcher, const TReplacementSequenceType& replacements)
+        {
+            std::basic_string<TCharType> result;
+            ReplaceAllManyIntoCore<TCharType, IgnoreCase>(result, str, matcher, replacements);
+            str.swap(result);
+            return str;
+        }
+
+        template <typename TCharType, bool IgnoreCase, typename TReplacementSequenceType>
+        static std::basic_string<TCharType>& ReplaceAllManyInto(std::basic_string<TCharType>& output, const std::basic_string<TCharType>& str, const TMultiStringMatcher<TCharType, IgnoreCase>& matcher, const TReplacementSequenceType& replacements)
+        {
+            return ReplaceAllManyIntoCore<TCharType, IgnoreCase>(output, str, matcher, replacements);
+        }
+
+        // trim
+        template <typename TCharType, typename Predicate>
+        static std::basic_string<TCharType>& TrimLeft(std::basic_string<TCharType>& str, Predicate predicate)
+        {
+            for (size_t i = 0; i < str.size(); ++i)
+            {
+                if (!predicate(str[i]))
+                {
+                    if (i > 0)
+                    {
+                        str.erase(0, i);
+                    }
+
+                    break;
+                }
+            }
+
+            return str;
+        }
+
+        template <typename TCharType, typename Predicate>
+        static std::basic_string<TCharType> TrimLeftCopy(const std::basic_string<TCharType>& str, Predicate predicate)
+        {
+            auto result = str;
+            TrimLeft<TCharType, Predicate>(result, predicate);
+            return result;
+        }
+
+        template <typename TCharType>
+        static std::basic_string<TCharType>& TrimLeft(std::basic_string<TCharType>& str)
+        {
+            return TrimLeft(str, TCharTraits<TCharType>::IsSpace);
+        }
+
+        template <typename TCharType>
+        static std::basic_string<TCharType> TrimLeftCopy(const std::basic_string<TCharType>& str)
+        {
+            auto result = str;
+            TrimLeft<TCharType>(result);
+            return result;
+        }
+
+        template <typename TCharType, typename Predicate>
+        static std::basic_string<TCharType>& TrimRight(std::basic_string<TCharType>& str, Predicate predicate)
+        {
+            if (str.empty())
+            {
+                return str;
+            }
+
+            for (auto i = str.size() - 1; i >= 0 && i < str.size(); --i)
+            {
+                if (!predicate(str[i]))
+                {
+                    if (i < str.size() - 1)
+                    {
+                        str.erase(i + 1, str.size() - i - 1);
+                    }
+
+                    break;
+                }
+            }
+
+            return str;
+        }
+
+        template <typename TCharType, typename Predicate>
+        static std::basic_string<TCharType> TrimRightCopy(const std::basic_string<TCharType>& str, Predicate predicate)
+        {
+            auto result = str;
+            TrimRight<TCharType, Predicate>(result, predicate);
+            return result;
+        }
+
+        template <typename TCharType>
+        static std::basic_string<TCharType>& TrimRight(std::basic_string<TCharType>& str)
+        {
+            return TrimRight(str, TCharTraits<TCharType>::IsSpace);
+        }
+
+        template <typename TCharType>
+        static std::basic_string<TCharType> TrimRightCopy(const std::basic_string<TCharType>& str)
+        {
+            auto result = str;
+            TrimRight<TCharType>(result);
+            return result;
+        }
+
+        template <typename TCharType, typename Predicate>
+        static std::basic_string<TCharType>& Trim(std::basic_string<TCharType>& str, Predicate predicate)
+        {
+            if (str.empty())
+            {
+                return str;
+            }
+
+            TrimLeft<TCharType, Predicate>(str, predicate);
+            TrimRight<TCharType, Predicate>(str, predicate);
+            return str;
+        }
+
+        template <typename TCharType, typename Predicate>
+        static std::basic_string<TCharType> TrimCopy(const std::basic_string<TCharType>& str, Predicate predicate)
+        {
+            auto result = str;
+            Trim<TCharType, Predicate>(result, predicate);
+            return result;
+        }
+
+        template <typename TCharType>
+        static std::basic_string<TCharType>& Trim(std::basic_string<TCharType>& str)
+        {
+            TrimLeft<TCharType>(str);
+            TrimRight<TCharType>(str);
+            return str;
+        }
+
+        template <typename TCharType>
+        static std::basic_string<TCharType> TrimCopy(const std::basic_string<TCharType>& str)
+        {
+            auto result = str;
+            Trim<TCharType>(result);
+            return result;
+        }
+
+        // trim string references, the result refers to the same characters
+        template <typename TCharType, typename Predicate>
+        static TStringRef<TCharType> TrimLeft(const TStringRef<TCharType>& str, Predicate predicate)
+        {
+            std::size_t start = 0;
+
+            while (start < str.GetLength() && predicate(str[start]))
+            {
+                ++start;
+            }
+
+            return str.SubRef(start);
+        }
+
+        template <typename TCharType>
+        static TStringRef<TCharType> TrimLeft(const TStringRef<TCharType>& str)
+        {
+            return TrimLeft(str, TCharTraits<TCharType>::IsSpace);
+        }
+
+        template <typename TCharType, typename Predicate>
+        static TStringRef<TCharType> TrimRight(const TStringRef<TCharType>& str, Predicate predicate)
+        {
+            std::size_t length = str.GetLength();
+
+            while (length > 0 && predicate(str[length - 1]))
+            {
+                --length;
+            }
+
+            return str.SubRef(0, length);
+        }
+
+        template <typename TCharType>
+        static TStringRef<TCharType> TrimRight(const TStringRef<TCharType>& str)
+        {
+            return TrimRight(str, TCharTraits<TCharType>::IsSpace);
+        }
+
+        template <typename TCharType, typename Predicate>
+        static TStringRef<TCharType> Trim(const TStringRef<TCharType>& str, Predicate predicate)
+        {
+            return TrimRight(TrimLeft(str, predicate), predicate);
+        }
+
+        template <typename TCharType>
+        static TStringRef<TCharType> Trim(const TStringRef<TCharType>& str)
+        {
+            return Trim(str, TCharTraits<TCharType>::IsSpace);
+        }
+
+        // trim with a compiled character set, scanned with the SIMD kernels of TCharSet
+        template <typename TCharType>
+        static TStringRef<TCharType> TrimLeft(const TStringRef<TCharType>& str, const TCharSet<TCharType>& set)
+        {
+            const TCharType* pos = set.FindFirstNotOf(str.GetData(), str.GetLength());
+
+            return str.SubRef(pos != nullptr ? static_cast<std::size_t>(pos - str.GetData()) : str.GetLength());
+        }
+
+        template <typename TCharType>
+        static TStringRef<TCharType> TrimRight(const TStringRef<TCharType>& str, const TCharSet<TCharType>& set)
+        {
+            const TCharType* pos = set.FindLastNotOf(str.GetData(), str.GetLength());
+
+            return str.SubRef(0, pos != nullptr ? static_cast<std::size_t>(pos - str.GetData()) + 1 : 0);
+        }
+
+        template <typename TCharType>
+        static TStringRef<TCharType> Trim(const TStringRef<TCharType>& str, const TCharSet<TCharType>& set)
+        {
+            return TrimRight(TrimLeft(str, set), set);
+        }
+
+        template <typename TCharType>
+        static std::basic_string<TCharType>& TrimLeft(std::basic_string<TCharType>& str, const TCharSet<TCharType>& set)
+        {
+            const TCharType* pos = set.FindFirstNotOf(str.c_str(), str.size());
+
+            str.erase(0, pos != nullptr ? static_cast<std::size_t>(pos - str.c_str()) : str.size());
+
+            return str;
+        }
+
+        template <typename TCharType>
+        static std::basic_string<TCharType>& TrimRight(std::basic_string<TCharType>& str, const TCharSet<TCharType>& set)
+        {
+            const TCharType* pos = set.FindLastNotOf(str.c_str(), str.size());
+
+            str.resize(pos != nullptr ? static_cast<std::size_t>(pos - str.c_str()) + 1 : 0);
+
+            return str;
+        }
+
+        template <typename TCharType>
+        static std::basic_string<TCharType>& Trim(std::basic_string<TCharType>& str, const TCharSet<TCharType>& set)
+        {
+            TrimRight(str, set);
+            TrimLeft(str, set);
+
+            return str;
+        }
+
+        // trim inline strings in place, the characters are moved to the start of the buffer
+        template <typename TCharType, size_t InlineLength, bool SpillToHeap, typename Predicate>
+        static TInlineString<TCharType, InlineLength, SpillToHeap>& TrimLeft(TInlineString<TCharType, InlineLength, SpillToHeap>& str, Predicate predicate)
+        {
+            str.RemovePrefix(str.GetLength() - TrimLeft(TStringRef<TCharType>(str), predicate).GetLength());
+            return str;
+        }
+
+        template <typename TCharType, size_t InlineLength, bool SpillToHeap>
+        static TInlineString<TCharType, InlineLength, SpillToHeap>& TrimLeft(TInlineString<TCharType, InlineLength, SpillToHeap>& str)
+        {
+            return TrimLeft(str, TCharTraits<TCharType>::IsSpace);
+        }
+
+        template <typename TCharType, size_t InlineLength, bool SpillToHeap>
+        static TInlineString<TCharType, InlineLength, SpillToHeap>& TrimLeft(TInlineString<TCharType, InlineLength, SpillToHeap>& str, const TCharSet<TCharType>& set)
+        {
+            str.RemovePrefix(str.GetLength() - TrimLeft(TStringRef<TCharType>(str), set).GetLength());
+            return str;
+        }
+
+        template <typename TCharType, size_t InlineLength, bool SpillToHeap, typename Predicate>
+        static TInlineString<TCharType, InlineLength, SpillToHeap>& TrimRight(TInlineString<TCharType, InlineLength, SpillToHeap>& str, Predicate predicate)
+        {
+            str.RemoveSuffix(str.GetLength() - TrimRight(TStringRef<TCharType>(str), predicate).GetLength());
+            return str;
+        }
+
+        template <typename TCharType, size_t InlineLength, bool SpillToHeap>
+        static TInlineString<TCharType, InlineLength, SpillToHeap>& TrimRight(TInlineString<TCharType, InlineLength, SpillToHeap>& str)
+        {
+            return TrimRight(str, TCharTraits<TCharType>::IsSpace);
+        }
+
+        template <typename TCharType, size_t InlineLength, bool SpillToHeap>
+        static TInlineString<TCharType, InlineLength, SpillToHeap>& TrimRight(TInlineString<TCharType, InlineLength, SpillToHeap>& str, const TCharSet<TCharType>& set)
+        {
+            str.RemoveSuffix(str.GetLength() - TrimRight(TStringRef<TCharType>(str), set).GetLength());
+            return str;
+        }
+
+        template <typename TCharType, size_t InlineLength, bool SpillToHeap, typename Predicate>
+        static TInlineString<TCharType, InlineLength, SpillToHeap>& Trim(TInlineString<TCharType, InlineLength, SpillToHeap>& str, Predicate predicate)
+        {
+            TrimRight(str, predicate);
+            return TrimLeft(str, predicate);
+        }
+
+        template <typename TCharType, size_t InlineLength, bool SpillToHeap>
+        static TInlineString<TCharType, InlineLength, SpillToHeap>& Trim(TInlineString<TCharType, InlineLength, SpillToHeap>& str)
+        {
+            return Trim(str, TCharTraits<TCharType>::IsSpace);
+        }
+
+        template <typename TCharType, size_t InlineLength, bool SpillToHeap>
+        static TInlineString<TCharType, InlineLength, SpillToHeap>& Trim(TInlineString<TCharType, InlineLength, SpillToHeap>& str, const TCharSet<TCharType>& set)
+        {
+            TrimRight(str, set);
+            return TrimLeft(str, set);
+        }
+
+        // upper/lower
+        // char converts ASCII letters only and leaves other bytes (e.g. UTF-8 sequences) untouched,
+        // wchar_t also converts other letters through towupper/towlower
+        template <typename TCharType>
+        static std::basic_string<TCharType>& ToUpper(std::basic_string<TCharType>& str)
+        {
+            if (!str.empty())
+            {
+                Details::TCaseConversionKernels<TCharType>::ToUpper(str.c_str(), &str[0], str.size());
+            }
+
+            return str;
+        }
+
+        template <typename TCharType>
+        static std::basic_string<TCharType>& ToLower(std::basic_string<TCharType>& str)
+        {
+            if (!str.empty())
+            {
+                Details::TCaseConversionKernels<TCharType>::ToLower(str.c_str(), &str[0], str.size());
+            }
+
+            return str;
+        }
+
+        template <typename TCharType, size_t InlineLength, bool SpillToHeap>
+        static TInlineString<TCharType, InlineLength, SpillToHeap>& ToUpper(TInlineString<TCharType, InlineLength, SpillToHeap>& str)
+        {
+            Details::TCaseConversionKernels<TCharType>::ToUpper(str.GetData(), str.GetData(), str.GetLength());
+            return str;
+        }
+
+        template <typename TCharType, size_t InlineLength, bool SpillToHeap>
+        static TInlineString<TCharType, InlineLength, SpillToHeap>& ToLower(TInlineString<TCharType, InlineLength, SpillToHeap>& str)
+        {
+            Details::TCaseConversionKernels<TCharType>::ToLower(str.GetData(), str.GetData(), str.GetLength());
+            return str;
+        }
+
+        // the copy variants convert while copying
+        template <typename TCharType>
+        static std::basic_string<TCharType> ToUpperCopy(const TStringRef<TCharType>& str)
+        {
+            std::basic_string<TCharType> result(str.GetLength(), TCharType());
+
+            if (!str.IsEmpty())
+            {
+                Details::TCaseConversionKernels<TCharType>::ToUpper(str.GetData(), &result[0], str.GetLength());
+            }
+
+            return result;
+        }
+
+        template <typename TCharType>
+        static std::basic_string<TCharType> ToLowerCopy(const TStringRef<TCharType>& str)
+        {
+            std::basic_string<TCharType> result(str.GetLength(), TCharType());
+
+            if (!str.IsEmpty())
+            {
+                Details::TCaseConversionKernels<TCharType>::ToLower(str.GetData(), &result[0], str.GetLength());
+            }
+
+            return result;
+        }
+
+        template <typename TCharType>
+        static std::basic_string<TCharType> ToUpperCopy(const std::basic_string<TCharType>& str)
+        {
+            return ToUpperCopy(TStringRef<TCharType>(str));
+        }
+
+        template <typename TCharType>
+        static std::basic_string<TCharType> ToLowerCopy(const std::basic_string<TCharType>& str)
+        {
+            return ToLowerCopy(TStringRef<TCharType>(str));
+        }
+
         // find by predicate
         // ReSharper disable once CppRedundantAccessSpecifier
     public:
@@ -454,84 +1250,385 @@ namespace CppMiniToolkit
             return std::basic_string<TCharType>::npos;
         }
 
+        template <typename TCharType, typename Predicate>
+        static typename TStringRef<TCharType>::SizeType Find(const TStringRef<TCharType>& str, Predicate predicate, typename TStringRef<TCharType>::SizeType startPos = 0)
+        {
+            for (auto i = startPos; i < str.GetLength(); ++i)
+            {
+                if (predicate(str[i]))
+                {
+                    return i;
+                }
+            }
+
+            return TStringRef<TCharType>::npos;
+        }
+
+        // find the first character in set
+        template <typename TCharType>
+        static typename std::basic_string<TCharType>::size_type Find(const std::basic_string<TCharType>& str, const TCharSet<TCharType>& set, typename std::basic_string<TCharType>::size_type startPos = 0)
+        {
+            return Find(TStringRef<TCharType>(str), set, startPos);
+        }
+
+        template <typename TCharType>
+        static typename TStringRef<TCharType>::SizeType Find(const TStringRef<TCharType>& str, const TCharSet<TCharType>& set, typename TStringRef<TCharType>::SizeType startPos = 0)
+        {
+            if (startPos >= str.GetLength())
+            {
+                return TStringRef<TCharType>::npos;
+            }
+
+            const TCharType* pos = set.FindFirstOf(str.GetData() + startPos, str.GetLength() - startPos);
+
+            return pos != nullptr ? static_cast<typename TStringRef<TCharType>::SizeType>(pos - str.GetData()) : TStringRef<TCharType>::npos;
+        }
+
+        // numbers, independent of the locale: [sign] digits for integers, [sign] digits [. digits] [e [sign] digits]
+        // for double. the whole string must be the number, false when it is not or when it does not fit in value
+        template <typename TCharType, typename TInteger>
+        static bool ParseInt(const TStringRef<TCharType>& str, TInteger& value)
+        {
+            return TCharTraits<TCharType>::ParseInt(str.GetData(), str.GetLength(), value);
+        }
+
+        template <typename TCharType, typename TInteger>
+        static bool ParseInt(const std::basic_string<TCharType>& str, TInteger& value)
+        {
+            return TCharTraits<TCharType>::ParseInt(str.c_str(), str.size(), value);
+        }
+
+        template <typename TCharType, typename TInteger>
+        static bool ParseUInt(const TStringRef<TCharType>& str, TInteger& value)
+        {
+            return TCharTraits<TCharType>::ParseUInt(str.GetData(), str.GetLength(), value);
+        }
+
+        template <typename TCharType, typename TInteger>
+        static bool ParseUInt(const std::basic_string<TCharType>& str, TInteger& value)
+        {
+            return TCharTraits<TCharType>::ParseUInt(str.c_str(), str.size(), value);
+        }
+
+        template <typename TCharType>
+        static bool ParseDouble(const TStringRef<TCharType>& str, double& value)
+        {
+            return TCharTraits<TCharType>::ParseDouble(str.GetData(), str.GetLength(), value);
+        }
+
+        template <typename TCharType>
+        static bool ParseDouble(const std::basic_string<TCharType>& str, double& value)
+        {
+            return TCharTraits<TCharType>::ParseDouble(str.c_str(), str.size(), value);
+        }
+
         // split
         // ReSharper disable once CppRedundantAccessSpecifier
     public:
+        // empty tokens are skipped, every token is added with emplace_back(pointer, length)
+        // so the sequence can hold strings or string references into str
         template <typename TSequenceType, typename TCharType, typename Predicate>
-        static TSequenceType& Split(TSequenceType& sequence, const std::basic_string<TCharType>& str, Predicate predicate)
+        static TSequenceType& Split(TSequenceType& sequence, const TStringRef<TCharType>& str, Predicate predicate)
         {
-            typedef typename std::basic_string<TCharType>::size_type SizeType;
+            typedef typename TStringRef<TCharType>::SizeType SizeType;
 
+            const TCharType* data = str.GetData();
             SizeType startPos = 0;
-            SizeType pos = std::basic_string<TCharType>::npos;
-            while ((pos = Find<TCharType, Predicate>(str, predicate, startPos)) != std::basic_string<TCharType>::npos)
+
+            for (SizeType pos = 0; pos < str.GetLength(); ++pos)
             {
-                if (pos == startPos)
+                if (predicate(data[pos]))
                 {
+                    if (pos > startPos)
+                    {
+                        sequence.emplace_back(data + startPos, pos - startPos);
+                    }
+
                     startPos = pos + 1;
-                    continue;
                 }
+            }
 
-                std::basic_string<TCharType> token = str.substr(startPos, pos - startPos);
-                sequence.emplace_back(std::move(token));
-                startPos = pos + 1;
+            if (startPos < str.GetLength())
+            {
+                sequence.emplace_back(data + startPos, str.GetLength() - startPos);
             }
 
             return sequence;
         }
 
-        // join
-        // ReSharper disable once CppRedundantAccessSpecifier
-    public:
-        template <typename TSequenceType, typename TCharType, typename Predicate>
-        static std::basic_string<TCharType> Join(const TSequenceType& sequence, const TCharType* separator, Predicate predicate)
+        template <typename TSequenceType, typename TCharType>
+        static TSequenceType& Split(TSequenceType& sequence, const TStringRef<TCharType>& str, const TCharSet<TCharType>& set)
         {
-            std::basic_string<TCharType> Result;
-
-            auto itBegin = sequence.begin();
-            auto itEnd = sequence.end();
+            const TCharType* data = str.GetData();
+            const TCharType* end = data + str.GetLength();
+            const TCharType* start = data;
 
-            while (itBegin != itEnd && !predicate(*itBegin))
+            while (start < end)
             {
-                ++itBegin;
+                const TCharType* pos = set.FindFirstOf(start, static_cast<std::size_t>(end - start));
+
+                if (pos == nullptr)
+                {
+                    pos = end;
+                }
+
+                if (pos > start)
+                {
+                    sequence.emplace_back(start, static_cast<std::size_t>(pos - start));
+                }
+
+                start = pos + 1;
             }
 
-            if (itBegin != itEnd)
+            return sequence;
+        }
+
+        template <typename TSequenceType, typename TCharType>
+        static TSequenceType& Split(TSequenceType& sequence, const std::basic_string<TCharType>& str, const TCharSet<TCharType>& set)
+        {
+            return Split<TSequenceType, TCharType>(sequence, TStringRef<TCharType>(str), set);
+        }
+
+        template <typename TSequenceType, typename TCharType, typename Predicate>
+        static TSequenceType& Split(TSequenceType& sequence, const std::basic_string<TCharType>& str, Predicate predicate)
+        {
+            return Split<TSequenceType, TCharType, Predicate>(sequence, TStringRef<TCharType>(str), predicate);
+        }
+
+        // lazy split, tokens are string references produced while iterating:
+        // for (const auto& token : StringAlgorithm::SplitView(line, ',')) { ... }
+        // the view refers to str, so str must outlive it
+        template <typename TCharType>
+        static TSplitView<TCharType, Details::TSplitByChar<TCharType>> SplitView(const TStringRef<TCharType>& str, const TCharType delimiter, const bool skipEmpty = false)
+        {
+            return TSplitView<TCharType, Details::TSplitByChar<TCharType>>(str, Details::TSplitByChar<TCharType>{ delimiter }, skipEmpty);
+        }
+
+        template <typename TCharType>
+        static TSplitView<TCharType, Details::TSplitByChar<TCharType>> SplitView(const std::basic_string<TCharType>& str, const TCharType delimiter, const bool skipEmpty = false)
+        {
+            return SplitView<TCharType>(TStringRef<TCharType>(str), delimiter, skipEmpty);
+        }
+
+        // a temporary string would be destroyed before the tokens are used
+        template <typename TCharType>
+        static void SplitView(std::basic_string<TCharType>&& str, const TCharType delimiter, const bool skipEmpty = false) = delete;
+
+        // split by a delimiter string
+        template <typename TCharType>
+        static TSplitView<TCharType, Details::TSplitByString<TCharType>> SplitView(const TStringRef<TCharType>& str, const Details::TStringRefArgument<TCharType>& delimiter, const bool skipEmpty = false)
+        {
+            return TSplitView<TCharType, Details::TSplitByString<TCharType>>(str, Details::TSplitByString<TCharType>{ delimiter }, skipEmpty);
+        }
+
+        template <typename TCharType>
+        static TSplitView<TCharType, Details::TSplitByString<TCharType>> SplitView(const std::basic_string<TCharType>& str, const Details::TStringRefArgument<TCharType>& delimiter, const bool skipEmpty = false)
+        {
+            return SplitView<TCharType>(TStringRef<TCharType>(str), delimiter, skipEmpty);
+        }
+
+        template <typename TCharType>
+        static void SplitView(std::basic_string<TCharType>&& str, const Details::TStringRefArgument<TCharType>& delimiter, const bool skipEmpty = false) = delete;
+
+        // split by any character of delimiters
+        template <typename TCharType>
+        static TSplitView<TCharType, Details::TSplitByAnyOf<TCharType>> SplitViewAnyOf(const TStringRef<TCharType>& str, const Details::TStringRefArgument<TCharType>& delimiters, const bool skipEmpty = false)
+        {
+            return TSplitView<TCharType, Details::TSplitByAnyOf<TCharType>>(str, Details::TSplitByAnyOf<TCharType>{ TCharSet<TCharType>(delimiters.GetData(), delimiters.GetLength()) }, skipEmpty);
+        }
+
+        template <typename TCharType>
+        static TSplitView<TCharType, Details::TSplitByAnyOf<TCharType>> SplitViewAnyOf(const std::basic_string<TCharType>& str, const Details::TStringRefArgument<TCharType>& delimiters, const bool skipEmpty = false)
+        {
+            return SplitViewAnyOf<TCharType>(TStringRef<TCharType>(str), delimiters, skipEmpty);
+        }
+
+        template <typename TCharType>
+        static void SplitViewAnyOf(std::basic_string<TCharType>&& str, const Details::TStringRefArgument<TCharType>& delimiters, const bool skipEmpty = false) = delete;
+
+        template <typename TCharType>
+        static TSplitView<TCharType, Details::TSplitByAnyOf<TCharType>> SplitViewAnyOf(const TStringRef<TCharType>& str, const TCharSet<TCharType>& delimiters, const bool skipEmpty = false)
+        {
+            return TSplitView<TCharType, Details::TSplitByAnyOf<TCharType>>(str, Details::TSplitByAnyOf<TCharType>{ delimiters }, skipEmpty);
+        }
+
+        template <typename TCharType>
+        static TSplitView<TCharType, Details::TSplitByAnyOf<TCharType>> SplitViewAnyOf(const std::basic_string<TCharType>& str, const TCharSet<TCharType>& delimiters, const bool skipEmpty = false)
+        {
+            return SplitViewAnyOf<TCharType>(TStringRef<TCharType>(str), delimiters, skipEmpty);
+        }
+
+        template <typename TCharType>
+        static void SplitViewAnyOf(std::basic_string<TCharType>&& str, const TCharSet<TCharType>& delimiters, const bool skipEmpty = false) = delete;
+
+        // join
+        // the result is sized first and then written with one reservation,
+        // so predicate is called twice for every element and must give the same answer both times
+    private:
+        struct JoinAcceptAll
+        {
+            template <typename T>
+            bool operator ()(const T&) const
             {
-                Result.append(*itBegin);
-                ++itBegin;
+                return true;
             }
+        };
+
+        // elements can be anything Shims::PtrOf/LengthOf support: strings, pointers or string references
+        template <typename TCharType, typename TSequenceType, typename Predicate, typename TAppender>
+        static void JoinPieces(const TSequenceType& sequence, const TCharType* separator, const std::size_t separatorLength, Predicate& predicate, TAppender& appender)
+        {
+            bool first = true;
 
-            for (; itBegin != itEnd; ++itBegin)
+            for (const auto& item : sequence)
             {
-                if (predicate(*itBegin))
+                if (!predicate(item))
                 {
-                    Result.append(separator);
-                    Result.append(*itBegin);
+                    continue;
+                }
+
+                if (!first)
+                {
+                    appender(separator, separatorLength);
                 }
+
+                appender(Shims::PtrOf(item), Shims::LengthOf(item));
+                first = false;
+            }
+        }
+
+        template <typename TCharType, typename TSequenceType, typename Predicate>
+        static std::size_t JoinLength(const TSequenceType& sequence, const TCharType* separator, const std::size_t separatorLength, Predicate& predicate)
+        {
+            std::size_t length = 0;
+
+            auto counter = [&length](const TCharType*, const std::size_t pieceLength) { length += pieceLength; };
+            JoinPieces<TCharType>(sequence, separator, separatorLength, predicate, counter);
+
+            return length;
+        }
+
+        template <typename TCharType, typename TSequenceType, typename Predicate>
+        static std::basic_string<TCharType>& JoinIntoCore(std::basic_string<TCharType>& output, const TSequenceType& sequence, const TCharType* separator, const std::size_t separatorLength, Predicate& predicate)
+        {
+            output.reserve(output.size() + JoinLength<TCharType>(sequence, separator, separatorLength, predicate));
+
+            auto appender = [&output](const TCharType* piece, const std::size_t pieceLength) { output.append(piece, pieceLength); };
+            JoinPieces<TCharType>(sequence, separator, separatorLength, predicate, appender);
+
+            return output;
+        }
+
+        template <typename TCharType, int AlignLength, typename TSequenceType, typename Predicate>
+        static TDynamicBuffer<AlignLength>& JoinIntoCore(TDynamicBuffer<AlignLength>& output, const TSequenceType& sequence, const TCharType* separator, const std::size_t separatorLength, Predicate& predicate)
+        {
+            output.Reserve(output.GetSize() + JoinLength<TCharType>(sequence, separator, separatorLength, predicate) * sizeof(TCharType));
+
+            auto appender = [&output](const TCharType* piece, const std::size_t pieceLength)
+                {
+                    if (pieceLength > 0)
+                    {
+                        output.Append(piece, pieceLength * sizeof(TCharType));
+                    }
+                };
+            JoinPieces<TCharType>(sequence, separator, separatorLength, predicate, appender);
+
+            return output;
+        }
+
+        template <typename TCharType, size_t InlineLength, bool SpillToHeap, typename TSequenceType, typename Predicate>
+        static TInlineString<TCharType, InlineLength, SpillToHeap>& JoinIntoCore(TInlineString<TCharType, InlineLength, SpillToHeap>& output, const TSequenceType& sequence, const TCharType* separator, const std::size_t separatorLength, Predicate& predicate)
+        {
+            // a fixed capacity string has nothing to reserve
+            if (SpillToHeap)
+            {
+                output.Reserve(output.GetLength() + JoinLength<TCharType>(sequence, separator, separatorLength, predicate));
             }
 
+            auto appender = [&output](const TCharType* piece, const std::size_t pieceLength) { output.Append(piece, pieceLength); };
+            JoinPieces<TCharType>(sequence, separator, separatorLength, predicate, appender);
+
+            return output;
+        }
+
+        // ReSharper disable once CppRedundantAccessSpecifier
+    public:
+        template <typename TSequenceType, typename TCharType, typename Predicate>
+        static std::basic_string<TCharType> Join(const TSequenceType& sequence, const TCharType* separator, Predicate predicate)
+        {
+            std::basic_string<TCharType> Result;
+            JoinIntoCore<TCharType>(Result, sequence, separator, TCharTraits<TCharType>::length(separator), predicate);
             return Result;
         }
 
         template <typename TSequenceType, typename TCharType, typename Predicate>
         static std::basic_string<TCharType> Join(const TSequenceType& sequence, const std::basic_string<TCharType>& separator, Predicate predicate)
         {
-            return Join<TSequenceType, TCharType, Predicate>(sequence, separator.c_str(), predicate);
+            std::basic_string<TCharType> Result;
+            JoinIntoCore<TCharType>(Result, sequence, separator.c_str(), separator.size(), predicate);
+            return Result;
         }
 
         template <typename TSequenceType, typename TCharType>
         static std::basic_string<TCharType> Join(const TSequenceType& sequence, const TCharType* separator)
         {
-            static auto predicate = [](const auto&) { return true; };
-
-            return Join<TSequenceType, TCharType, decltype(predicate)>(sequence, separator, predicate);
+            return Join<TSequenceType, TCharType>(sequence, separator, JoinAcceptAll());
         }
 
         template <typename TSequenceType, typename TCharType>
         static std::basic_string<TCharType> Join(const TSequenceType& sequence, const std::basic_string<TCharType>& separator)
         {
-            return Join<TSequenceType, TCharType>(sequence, separator.c_str());
+            return Join<TSequenceType, TCharType>(sequence, separator, JoinAcceptAll());
+        }
+
+        // append the joined result to output, so one output can serve many batches
+        template <typename TCharType, typename TSequenceType, typename Predicate>
+        static std::basic_string<TCharType>& JoinInto(std::basic_string<TCharType>& output, const TSequenceType& sequence, const Details::TStringRefArgument<TCharType>& separator, Predicate predicate)
+        {
+            return JoinIntoCore<TCharType>(output, sequence, separator.GetData(), separator.GetLength(), predicate);
+        }
+
+        template <typename TCharType, typename TSequenceType>
+        static std::basic_string<TCharType>& JoinInto(std::basic_string<TCharType>& output, const TSequenceType& sequence, const Details::TStringRefArgument<TCharType>& separator)
+        {
+            return JoinInto(output, sequence, separator, JoinAcceptAll());
+        }
+
+        template <typename TCharType, size_t InlineLength, bool SpillToHeap, typename TSequenceType, typename Predicate>
+        static TInlineString<TCharType, InlineLength, SpillToHeap>& JoinInto(TInlineString<TCharType, InlineLength, SpillToHeap>& output, const TSequenceType& sequence, const Details::TStringRefArgument<TCharType>& separator, Predicate predicate)
+        {
+            return JoinIntoCore<TCharType>(output, sequence, separator.GetData(), separator.GetLength(), predicate);
+        }
+
+        template <typename TCharType, size_t InlineLength, bool SpillToHeap, typename TSequenceType>
+        static TInlineString<TCharType, InlineLength, SpillToHeap>& JoinInto(TInlineString<TCharType, InlineLength, SpillToHeap>& output, const TSequenceType& sequence, const Details::TStringRefArgument<TCharType>& separator)
+        {
+            return JoinInto(output, sequence, separator, JoinAcceptAll());
+        }
+
+        // the buffer receives the raw characters, without terminating zero
+        template <int AlignLength, typename TSequenceType, typename TCharType, typename Predicate>
+        static TDynamicBuffer<AlignLength>& JoinInto(TDynamicBuffer<AlignLength>& output, const TSequenceType& sequence, const TCharType* separator, Predicate predicate)
+        {
+            return JoinIntoCore<TCharType>(output, sequence, separator, TCharTraits<TCharType>::length(separator), predicate);
+        }
+
+        template <int AlignLength, typename TSequenceType, typename TCharType, typename Predicate>
+        static TDynamicBuffer<AlignLength>& JoinInto(TDynamicBuffer<AlignLength>& output, const TSequenceType& sequence, const std::basic_string<TCharType>& separator, Predicate predicate)
+        {
+            return JoinIntoCore<TCharType>(output, sequence, separator.c_str(), separator.size(), predicate);
+        }
+
+        template <int AlignLength, typename TSequenceType, typename TCharType>
+        static TDynamicBuffer<AlignLength>& JoinInto(TDynamicBuffer<AlignLength>& output, const TSequenceType& sequence, const TCharType* separator)
+        {
+            return JoinInto(output, sequence, separator, JoinAcceptAll());
+        }
+
+        template <int AlignLength, typename TSequenceType, typename TCharType>
+        static TDynamicBuffer<AlignLength>& JoinInto(TDynamicBuffer<AlignLength>& output, const TSequenceType& sequence, const std::basic_string<TCharType>& separator)
+        {
+            return JoinInto(output, sequence, separator, JoinAcceptAll());
         }
     };
 }
@@ -0,0 +1,321 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <type_traits>
+
+#include <Common/CharTraits.hpp>
+
+namespace CppMiniToolkit
+{
+    // a needle preprocessed once and searched many times
+    // short patterns go through the SIMD kernels of TCharTraits, longer ones use Boyer-Moore-Horspool
+    // with a precomputed shift table. If Horspool degrades on adversarial input, the search
+    // continues with a Knuth-Morris-Pratt scan whose failure table is also built up front.
+    // IgnoreCase uses the same folding rules as TCharTraits::iFind
+    template <typename TCharType, bool IgnoreCase = false>
+    class TStringSearcher
+    {
+    public:
+        typedef std::basic_string<TCharType>                            StringType;
+        typedef typename StringType::size_type                          SizeType;
+        typedef typename std::make_unsigned<TCharType>::type            UnsignedCharType;
+
+        constexpr static SizeType npos = StringType::npos;
+
+        explicit TStringSearcher(const TCharType* pattern) :
+            TStringSearcher(pattern, TCharTraits<TCharType>::length(pattern))
+        {
+        }
+
+        explicit TStringSearcher(const StringType& pattern) :
+            TStringSearcher(pattern.c_str(), pattern.size())
+        {
+        }
+
+        TStringSearcher(const TCharType* pattern, const SizeType patternLength) :
+            Pattern(pattern, patternLength)
+        {
+            Compile();
+        }
+
+        const StringType& GetPattern() const
+        {
+            return Pattern;
+        }
+
+        SizeType GetPatternLength() const
+        {
+            return Pattern.size();
+        }
+
+        constexpr static bool IsIgnoreCase()
+        {
+            return IgnoreCase;
+        }
+
+        // find the first occurrence in text, returns nullptr if not found
+        const TCharType* FindIn(const TCharType* text, const SizeType textLength) const
+        {
+            if (Pattern.size() < HorspoolThreshold)
+            {
+                return IgnoreCase ?
+                    TCharTraits<TCharType>::iFind(text, textLength, Pattern.c_str(), Pattern.size()) :
+                    TCharTraits<TCharType>::Find(text, textLength, Pattern.c_str(), Pattern.size());
+            }
+
+            return FindHorspool(text, textLength);
+        }
+
+        SizeType FindIn(const StringType& text, const SizeType startPos = 0) const
+        {
+            if (startPos > text.size())
+            {
+                return npos;
+            }
+
+            const TCharType* result = FindIn(text.c_str() + startPos, text.size() - startPos);
+
+            return result != nullptr ? static_cast<SizeType>(result - text.c_str()) : npos;
+        }
+
+        bool ContainsIn(const TCharType* text, const SizeType textLength) const
+        {
+            return FindIn(text, textLength) != nullptr;
+        }
+
+        bool ContainsIn(const TCharType* text) const
+        {
+            return ContainsIn(text, TCharTraits<TCharType>::length(text));
+        }
+
+        bool ContainsIn(const StringType& text) const
+        {
+            return ContainsIn(text.c_str(), text.size());
+        }
+
+        // append the offsets of all matches to positions, returns the number of matches
+        // one pass over text: the search goes on behind every match instead of starting over
+        template <typename TSequenceType>
+        SizeType FindAllIn(const TCharType* text, const SizeType textLength, TSequenceType& positions, const bool overlapping = false) const
+        {
+            if (Pattern.empty())
+            {
+                return 0;
+            }
+
+            if (Pattern.size() < HorspoolThreshold)
+            {
+                auto onMatch = [&positions](const SizeType offset) { positions.push_back(offset); };
+
+                return IgnoreCase ?
+                    TCharTraits<TCharType>::iFindAll(text, textLength, Pattern.c_str(), Pattern.size(), overlapping, onMatch) :
+                    TCharTraits<TCharType>::FindAll(text, textLength, Pattern.c_str(), Pattern.size(), overlapping, onMatch);
+            }
+
+            SizeType count = 0;
+
+            auto onMatch = [&](const TCharType* match)
+                {
+                    positions.push_back(static_cast<SizeType>(match - text));
+                    ++count;
+
+                    return false;
+                };
+
+            ScanHorspool(text, textLength, overlapping ? 1 : Pattern.size(), onMatch);
+
+            return count;
+        }
+
+        template <typename TSequenceType>
+        SizeType FindAllIn(const StringType& text, TSequenceType& positions, const bool overlapping = false) const
+        {
+            return FindAllIn(text.c_str(), text.size(), positions, overlapping);
+        }
+
+    private:
+        constexpr static SizeType HorspoolThreshold = 16;
+        constexpr static SizeType ShiftTableSize = 256;
+
+        static TCharType Fold(const TCharType ch)
+        {
+            return Details::TSearchPolicy<TCharType, IgnoreCase>::Fold(ch);
+        }
+
+        // wide characters share buckets, the table keeps the smallest shift of each bucket which stays safe
+        static SizeType ShiftIndex(const TCharType ch)
+        {
+            return static_cast<SizeType>(static_cast<UnsignedCharType>(ch)) & (ShiftTableSize - 1);
+        }
+
+        void Compile()
+        {
+            const SizeType length = Pattern.size();
+
+            if (length < HorspoolThreshold)
+            {
+                return;
+            }
+
+            FoldedPattern.resize(length);
+
+            for (SizeType i = 0; i < length; ++i)
+            {
+                FoldedPattern[i] = Fold(Pattern[i]);
+            }
+
+            Shifts.assign(ShiftTableSize, length);
+
+            for (SizeType i = 0; i + 1 < length; ++i)
+            {
+                Shifts[ShiftIndex(FoldedPattern[i])] = length - 1 - i;
+            }
+
+            Failure.assign(length, 0);
+
+            for (SizeType i = 1, k = 0; i < length; ++i)
+            {
+                while (k > 0 && FoldedPattern[i] != FoldedPattern[k])
+                {
+                    k = Failure[k - 1];
+                }
+
+                if (FoldedPattern[i] == FoldedPattern[k])
+                {
+                    ++k;
+                }
+
+                Failure[i] = k;
+            }
+        }
+
+        const TCharType* FindHorspool(const TCharType* text, const SizeType textLength) const
+        {
+            auto onMatch = [](const TCharType*) { return true; };
+
+            return ScanHorspool(text, textLength, 1, onMatch);
+        }
+
+        // calls onMatch(match) for the matches from left to right, each one at least step after the
+        // previous, until onMatch returns true. returns that match, nullptr if the text ends first.
+        // the comparison budget covers the whole scan, so it holds for any number of matches
+        template <typename TCallback>
+        const TCharType* ScanHorspool(const TCharType* text, const SizeType textLength, const SizeType step, TCallback& onMatch) const
+        {
+            const SizeType length = FoldedPattern.size();
+
+            if (length > textLength)
+            {
+                return nullptr;
+            }
+
+            const SizeType lastIndex = length - 1;
+            const TCharType lastChar = FoldedPattern[lastIndex];
+            const SizeType budget = textLength * 2 + 1024;
+
+            SizeType cost = 0;
+            SizeType position = 0;
+
+            while (position + length <= textLength)
+            {
+                const TCharType* window = text + position;
+                const TCharType tail = Fold(window[lastIndex]);
+
+                if (tail == lastChar)
+                {
+                    SizeType i = 0;
+
+                    while (i < lastIndex && Fold(window[i]) == FoldedPattern[i])
+                    {
+                        ++i;
+                    }
+
+                    cost += i + 1;
+
+                    if (i == lastIndex)
+                    {
+                        if (onMatch(window))
+                        {
+                            return window;
+                        }
+
+                        position += step;
+                    }
+                    else
+                    {
+                        position += Shifts[ShiftIndex(tail)];
+                    }
+
+                    // the skipped windows can't match, so the linear scan starts at the next one
+                    if (cost > budget)
+                    {
+                        return ScanLinear(text, textLength, position, step, onMatch);
+                    }
+
+                    continue;
+                }
+
+                position += Shifts[ShiftIndex(tail)];
+            }
+
+            return nullptr;
+        }
+
+        template <typename TCallback>
+        const TCharType* ScanLinear(const TCharType* text, const SizeType textLength, const SizeType startPos, const SizeType step, TCallback& onMatch) const
+        {
+            const SizeType length = FoldedPattern.size();
+
+            for (SizeType i = startPos, k = 0; i < textLength; ++i)
+            {
+                const TCharType ch = Fold(text[i]);
+
+                while (k > 0 && ch != FoldedPattern[k])
+                {
+                    k = Failure[k - 1];
+                }
+
+                if (ch == FoldedPattern[k])
+                {
+                    ++k;
+                }
+
+                if (k == length)
+                {
+                    const TCharType* match = text + i + 1 - length;
+
+                    if (onMatch(match))
+                    {
+                        return match;
+                    }
+
+                    // without overlapping the next match starts behind this one
+                    k = step > 1 ? 0 : Failure[k - 1];
+                }
+            }
+
+            return nullptr;
+        }
+
+    private:
+        StringType               Pattern;
+        StringType               FoldedPattern;
+        std::vector<SizeType>    Shifts;
+        std::vector<SizeType>    Failure;
+    };
+
+    template <typename TCharType, bool IgnoreCase>
+    constexpr typename TStringSearcher<TCharType, IgnoreCase>::SizeType TStringSearcher<TCharType, IgnoreCase>::npos;
+
+    template <typename TCharType, bool IgnoreCase>
+    constexpr typename TStringSearcher<TCharType, IgnoreCase>::SizeType TStringSearcher<TCharType, IgnoreCase>::HorspoolThreshold;
+
+    template <typename TCharType, bool IgnoreCase>
+    constexpr typename TStringSearcher<TCharType, IgnoreCase>::SizeType TStringSearcher<TCharType, IgnoreCase>::ShiftTableSize;
+
+    typedef TStringSearcher<char>             StringSearcher;
+    typedef TStringSearcher<char, true>       iStringSearcher;
+    typedef TStringSearcher<wchar_t>          WStringSearcher;
+    typedef TStringSearcher<wchar_t, true>    iWStringSearcher;
+}
@@ -107,6 +107,32 @@
 #define _countof( Array ) (sizeof(Array)/sizeof(Array[0]))
 #endif
 
+// SIMD instruction sets enabled at compile time
+// define CMT_DISABLE_SIMD to force the scalar code paths
+#if !defined(CMT_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define CMT_SIMD_SSE2          1  // NOLINT(modernize-macro-to-enum)
+#else
+#define CMT_SIMD_SSE2          0  // NOLINT(modernize-macro-to-enum)
+#endif
+
+#if CMT_SIMD_SSE2 && (defined(__SSSE3__) || defined(__AVX__))
+#define CMT_SIMD_SSSE3         1  // NOLINT(modernize-macro-to-enum)
+#else
+#define CMT_SIMD_SSSE3         0  // NOLINT(modernize-macro-to-enum)
+#endif
+
+#if CMT_SIMD_SSE2 && defined(__AVX2__)
+#define CMT_SIMD_AVX2          1  // NOLINT(modernize-macro-to-enum)
+#else
+#define CMT_SIMD_AVX2          0  // NOLINT(modernize-macro-to-enum)
+#endif
+
+// define CMT_CHAR_TRAITS_LOCALE_FREE as 1 to make TCharTraits<char> classify characters and convert case
+// with the tables of AsciiCharTraits ("C" locale) instead of the locale aware C library
+#ifndef CMT_CHAR_TRAITS_LOCALE_FREE
+#define CMT_CHAR_TRAITS_LOCALE_FREE 0  // NOLINT(modernize-macro-to-enum)
+#endif
+
 #define CMT_UNREFERENCED_PARAMETER(p) (void)(p)
 #define CMT_DECLARE_TOOLKIT_CLASS_TYPE(typeName) \
         typeName() = delete; \
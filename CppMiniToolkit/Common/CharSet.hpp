@@ -0,0 +1,328 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+#include <type_traits>
+
+#include <Common/BuildConfig.hpp>
+#include <Common/CharTraits.hpp>
+#include <Common/Details/Simd.hpp>
+
+namespace CppMiniToolkit
+{
+    // a compiled set of characters: a 256 bit membership bitmap plus the nibble tables used by the
+    // SIMD kernels, which classify 16 (SSSE3) or 32 (AVX2) characters per step with two shuffles
+    // only code units below 256 can be members, wider characters are never in the set
+    template <typename TCharType>
+    class TCharSet
+    {
+    public:
+        typedef typename std::make_unsigned<TCharType>::type            UnsignedCharType;
+
+        TCharSet()
+        {
+            Clear();
+        }
+
+        explicit TCharSet(const TCharType* chars)
+        {
+            Clear();
+            Add(chars, TCharTraits<TCharType>::length(chars));
+        }
+
+        TCharSet(const TCharType* chars, const size_t length)
+        {
+            Clear();
+            Add(chars, length);
+        }
+
+        // build from a classification function such as TCharTraits<TCharType>::IsSpace
+        template <typename Predicate>
+        static TCharSet FromPredicate(Predicate predicate)
+        {
+            TCharSet result;
+
+            for (uint32_t i = 0; i < 256; ++i)
+            {
+                const auto ch = static_cast<TCharType>(static_cast<UnsignedCharType>(i));
+
+                if (predicate(ch))
+                {
+                    result.Add(ch);
+                }
+            }
+
+            return result;
+        }
+
+        void Clear()
+        {
+            memset(Bits, 0, sizeof(Bits));
+            memset(LowTable, 0, sizeof(LowTable));
+            memset(HighTable, 0, sizeof(HighTable));
+        }
+
+        void Add(const TCharType ch)
+        {
+            const auto value = static_cast<uint32_t>(static_cast<UnsignedCharType>(ch));
+
+            assert(value < 256 && "only code units below 256 can be added");
+
+            if (value >= 256)
+            {
+                return;
+            }
+
+            Bits[value >> 6] |= uint64_t(1) << (value & 63);
+
+            const uint32_t high = value >> 4;
+            const uint32_t low = value & 0x0F;
+
+            if (high < 8)
+            {
+                LowTable[low] = static_cast<uint8_t>(LowTable[low] | (1u << high));
+            }
+            else
+            {
+                HighTable[low] = static_cast<uint8_t>(HighTable[low] | (1u << (high - 8)));
+            }
+        }
+
+        void Add(const TCharType* chars, const size_t length)
+        {
+            for (size_t i = 0; i < length; ++i)
+            {
+                Add(chars[i]);
+            }
+        }
+
+        bool Contains(const TCharType ch) const
+        {
+            const auto value = static_cast<uint32_t>(static_cast<UnsignedCharType>(ch));
+
+            return value < 256 && ((Bits[value >> 6] >> (value & 63)) & 1) != 0;
+        }
+
+        // so the set can be passed where a predicate is expected
+        bool operator ()(const TCharType ch) const
+        {
+            return Contains(ch);
+        }
+
+        // the first character of str which is in the set, nullptr if there is none
+        const TCharType* FindFirstOf(const TCharType* str, const size_t length) const
+        {
+            return FindFirst<true>(str, length);
+        }
+
+        // the first character of str which is not in the set, nullptr if there is none
+        const TCharType* FindFirstNotOf(const TCharType* str, const size_t length) const
+        {
+            return FindFirst<false>(str, length);
+        }
+
+        const TCharType* FindLastOf(const TCharType* str, const size_t length) const
+        {
+            return FindLast<true>(str, length);
+        }
+
+        const TCharType* FindLastNotOf(const TCharType* str, const size_t length) const
+        {
+            return FindLast<false>(str, length);
+        }
+
+    private:
+#if CMT_SIMD_SSSE3
+        // one byte per character, lanes whose character is 256 or above are cleared in inRange
+        static __m128i LoadBytes128(const TCharType* str, __m128i& inRange)
+        {
+            return LoadBytes128(str, inRange, std::integral_constant<size_t, sizeof(TCharType)>());
+        }
+
+        static __m128i LoadBytes128(const TCharType* str, __m128i& inRange, std::integral_constant<size_t, 1>)
+        {
+            inRange = _mm_set1_epi8(-1);
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+        }
+
+        static __m128i LoadBytes128(const TCharType* str, __m128i& inRange, std::integral_constant<size_t, 2>)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i lowByte = _mm_set1_epi16(0x00FF);
+            const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+            const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + 8));
+
+            inRange = _mm_packs_epi16(
+                _mm_cmpeq_epi16(_mm_srli_epi16(first, 8), zero),
+                _mm_cmpeq_epi16(_mm_srli_epi16(second, 8), zero)
+            );
+
+            return _mm_packus_epi16(_mm_and_si128(first, lowByte), _mm_and_si128(second, lowByte));
+        }
+
+        static __m128i LoadBytes128(const TCharType* str, __m128i& inRange, std::integral_constant<size_t, 4>)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i lowByte = _mm_set1_epi32(0x000000FF);
+            __m128i blocks[4];
+            __m128i ranges[4];
+
+            for (int i = 0; i < 4; ++i)
+            {
+                blocks[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i * 4));
+                ranges[i] = _mm_cmpeq_epi32(_mm_srli_epi32(blocks[i], 8), zero);
+                blocks[i] = _mm_and_si128(blocks[i], lowByte);
+            }
+
+            inRange = _mm_packs_epi16(_mm_packs_epi32(ranges[0], ranges[1]), _mm_packs_epi32(ranges[2], ranges[3]));
+
+            return _mm_packus_epi16(_mm_packs_epi32(blocks[0], blocks[1]), _mm_packs_epi32(blocks[2], blocks[3]));
+        }
+
+        // 0xFF in every lane whose byte is a member
+        static __m128i Classify128(const __m128i bytes, const __m128i lowTable, const __m128i highTable)
+        {
+            const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+            const __m128i bitTable = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+
+            const __m128i low = _mm_and_si128(bytes, nibbleMask);
+            const __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), nibbleMask);
+            const __m128i upper = _mm_cmpgt_epi8(high, _mm_set1_epi8(7));
+            const __m128i row = _mm_or_si128(
+                _mm_and_si128(upper, _mm_shuffle_epi8(highTable, low)),
+                _mm_andnot_si128(upper, _mm_shuffle_epi8(lowTable, low))
+            );
+            const __m128i bit = _mm_shuffle_epi8(bitTable, high);
+
+            return _mm_cmpeq_epi8(_mm_and_si128(row, bit), bit);
+        }
+
+        // bit i is set when str[i] is a member, 16 characters
+        uint32_t Match16(const TCharType* str, const __m128i lowTable, const __m128i highTable) const
+        {
+            __m128i inRange;
+            const __m128i bytes = LoadBytes128(str, inRange);
+
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(Classify128(bytes, lowTable, highTable), inRange)));
+        }
+#endif
+
+#if CMT_SIMD_AVX2
+        static __m256i Classify256(const __m256i bytes, const __m256i lowTable, const __m256i highTable)
+        {
+            const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+            const __m256i bitTable = _mm256_setr_epi8(
+                1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128
+            );
+
+            const __m256i low = _mm256_and_si256(bytes, nibbleMask);
+            const __m256i high = _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibbleMask);
+            const __m256i upper = _mm256_cmpgt_epi8(high, _mm256_set1_epi8(7));
+            const __m256i row = _mm256_blendv_epi8(_mm256_shuffle_epi8(lowTable, low), _mm256_shuffle_epi8(highTable, low), upper);
+            const __m256i bit = _mm256_shuffle_epi8(bitTable, high);
+
+            return _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+        }
+#endif
+
+        template <bool Member>
+        const TCharType* FindFirst(const TCharType* str, const size_t length) const
+        {
+            size_t i = 0;
+
+#if CMT_SIMD_SSSE3
+            const __m128i lowTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(LowTable));
+            const __m128i highTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(HighTable));
+
+#if CMT_SIMD_AVX2
+            // wide characters need cross lane packing, they stay on the 128 bit path
+            if (sizeof(TCharType) == 1)
+            {
+                const __m256i lowTable256 = _mm256_broadcastsi128_si256(lowTable);
+                const __m256i highTable256 = _mm256_broadcastsi128_si256(highTable);
+
+                for (; i + 32 <= length; i += 32)
+                {
+                    const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + i));
+                    auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(Classify256(bytes, lowTable256, highTable256)));
+
+                    mask = Member ? mask : ~mask;
+
+                    if (mask != 0)
+                    {
+                        return str + i + Details::CountTrailingZeros32(mask);
+                    }
+                }
+            }
+#endif
+
+            for (; i + 16 <= length; i += 16)
+            {
+                uint32_t mask = Match16(str + i, lowTable, highTable);
+
+                mask = Member ? mask : (~mask & 0xFFFFu);
+
+                if (mask != 0)
+                {
+                    return str + i + Details::CountTrailingZeros32(mask);
+                }
+            }
+#endif
+
+            for (; i < length; ++i)
+            {
+                if (Contains(str[i]) == Member)
+                {
+                    return str + i;
+                }
+            }
+
+            return nullptr;
+        }
+
+        template <bool Member>
+        const TCharType* FindLast(const TCharType* str, const size_t length) const
+        {
+            size_t end = length;
+
+#if CMT_SIMD_SSSE3
+            const __m128i lowTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(LowTable));
+            const __m128i highTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(HighTable));
+
+            for (; end >= 16; end -= 16)
+            {
+                uint32_t mask = Match16(str + end - 16, lowTable, highTable);
+
+                mask = Member ? mask : (~mask & 0xFFFFu);
+
+                if (mask != 0)
+                {
+                    return str + end - 16 + (31 - Details::CountLeadingZeros32(mask));
+                }
+            }
+#endif
+
+            while (end > 0)
+            {
+                --end;
+
+                if (Contains(str[end]) == Member)
+                {
+                    return str + end;
+                }
+            }
+
+            return nullptr;
+        }
+
+    private:
+        uint64_t        Bits[4];
+        uint8_t         LowTable[16];
+        uint8_t         HighTable[16];
+    };
+
+    typedef TCharSet<char>          CharSet;
+    typedef TCharSet<wchar_t>       WCharSet;
+}
@@ -5,6 +5,10 @@
 #include <string>
 
 #include <Common/BuildConfig.hpp>
+#include <Common/AsciiCharTraits.hpp>
+#include <Common/Details/StringSearchKernels.hpp>
+#include <Common/Details/NumberConversionKernels.hpp>
+#include <Common/Details/EditDistanceKernels.hpp>
 
 namespace CppMiniToolkit
 {
@@ -19,63 +23,6 @@ namespace CppMiniToolkit
     template <>
     class TCharTraits<char> : public std::char_traits<char>
     {
-    private:
-        // ReSharper disable once CommentTypo
-        // NOLINTBEGIN
-        static const char* strrstr(const char* haystack, const char* needle)
-        {
-            const char* r = nullptr;
-
-            if (!needle[0])
-            {
-                return haystack + length(haystack);
-            }
-
-            while (true)
-            {
-                const char* p = strstr(haystack, needle);
-
-                if (!p)
-                {
-                    return r;
-                }
-
-                r = p;
-                haystack = p + 1;
-            }
-
-            // return nullptr;
-        }
-
-        /*
-         * Find the first occurrence of find in s, ignore case.
-         */
-        static const char* strcasestr(const char* s, const char* find)
-        {
-            char c, sc;
-            size_t len;
-
-            if ((c = *find++) != 0)
-            {
-                c = (char)ToLower(c);
-                len = length(find);
-                do
-                {
-                    do
-                    {
-                        if ((sc = *s++) == 0)
-                        {
-                            return nullptr;
-                        }
-                    } while (ToLower(sc) != c);
-                } while (iCompareN(s, find, len) != 0);
-                s--;
-            }
-            return s;
-        }
-        // ReSharper disable once CommentTypo
-        // NOLINTEND
-
     public:
         static int32_t StringPrintf(
             char* string,
@@ -141,7 +88,9 @@ namespace CppMiniToolkit
 
         static int iCompare(const char* first, const char* second)
         {
-#if CMT_COMPILER_MSVC
+#if CMT_CHAR_TRAITS_LOCALE_FREE
+            return AsciiCharTraits::iCompare(first, second);
+#elif CMT_COMPILER_MSVC
             return _stricmp(first, second);
 #else
             return strcasecmp(first, second);
@@ -150,7 +99,9 @@ namespace CppMiniToolkit
 
         static int iCompareN(const char* first, const char* second, const size_t n)
         {
-#if CMT_COMPILER_MSVC
+#if CMT_CHAR_TRAITS_LOCALE_FREE
+            return AsciiCharTraits::iCompareN(first, second, n);
+#elif CMT_COMPILER_MSVC
             return _strnicmp(first, second, n);
 #else
             return strncasecmp(first, second, n);
@@ -159,48 +110,86 @@ namespace CppMiniToolkit
 
         static const char* Find(const char* str, const char* match)
         {
-            return strstr(str, match);
+            return Find(str, strlen(str), match, strlen(match));
+        }
+
+        static const char* Find(const char* str, const size_t strLength, const char* match, const size_t matchLength)
+        {
+            return Details::TStringSearchKernels<char>::Find(str, strLength, match, matchLength);
         }
 
         static const char* iFind(const char* str, const char* match)
         {
-            return strcasestr(str, match);
+            return iFind(str, strlen(str), match, strlen(match));
+        }
+
+        static const char* iFind(const char* str, const size_t strLength, const char* match, const size_t matchLength)
+        {
+            return Details::TStringSearchKernels<char>::iFind(str, strLength, match, matchLength);
+        }
+
+        // onMatch(offset) for every occurrence in one scan, returns the number of occurrences
+        template <typename TCallback>
+        static size_t FindAll(const char* str, const size_t strLength, const char* match, const size_t matchLength, const bool overlapping, TCallback& onMatch)
+        {
+            return Details::TStringSearchKernels<char>::FindAll(str, strLength, match, matchLength, overlapping, onMatch);
+        }
+
+        template <typename TCallback>
+        static size_t iFindAll(const char* str, const size_t strLength, const char* match, const size_t matchLength, const bool overlapping, TCallback& onMatch)
+        {
+            return Details::TStringSearchKernels<char>::iFindAll(str, strLength, match, matchLength, overlapping, onMatch);
         }
 
         static const char* rFind(const char* str, const char ch)
         {
-            return strrchr(str, ch);
+            return rFind(str, strlen(str), ch);
+        }
+
+        static const char* rFind(const char* str, const size_t strLength, const char ch)
+        {
+            return Details::TStringSearchKernels<char>::rFind(str, strLength, ch);
         }
 
         static const char* rFind(const char* str, const char* subString)
         {
-            return strrstr(str, subString);
+            return rFind(str, strlen(str), subString, strlen(subString));
+        }
+
+        static const char* rFind(const char* str, const size_t strLength, const char* match, const size_t matchLength)
+        {
+            return Details::TStringSearchKernels<char>::rFind(str, strLength, match, matchLength);
         }
 
         static const char* rFindAny(const char* str, const char* targets)
         {
-            for (const char* p = str + strlen(str) - 1; p >= str; --p)
-            {
-                if(strchr(targets, *p) != nullptr)
-                {
-                    return p;
-                }
-            }
+            return rFindAny(str, strlen(str), targets, strlen(targets));
+        }
 
-            return nullptr;
+        static const char* rFindAny(const char* str, const size_t strLength, const char* targets, const size_t targetsLength)
+        {
+            return Details::TStringSearchKernels<char>::rFindAny(str, strLength, targets, targetsLength);
         }
 
         static const char* rFindNotOfAny(const char* str, const char* targets)
         {
-            for (const char* p = str + strlen(str) - 1; p >= str; --p)
-            {
-                if (strchr(targets, *p) == nullptr)
-                {
-                    return p;
-                }
-            }
+            return rFindNotOfAny(str, strlen(str), targets, strlen(targets));
+        }
 
-            return nullptr;
+        static const char* rFindNotOfAny(const char* str, const size_t strLength, const char* targets, const size_t targetsLength)
+        {
+            return Details::TStringSearchKernels<char>::rFindNotOfAny(str, strLength, targets, targetsLength);
+        }
+
+        // Levenshtein distance if it is at most maxDistance, maxDistance + 1 otherwise, see Details::TEditDistancePattern
+        static size_t EditDistance(const char* first, const size_t firstLength, const char* second, const size_t secondLength, const size_t maxDistance = SIZE_MAX)
+        {
+            return Details::TEditDistanceKernels<char>::Distance(first, firstLength, second, secondLength, maxDistance);
+        }
+
+        static size_t iEditDistance(const char* first, const size_t firstLength, const char* second, const size_t secondLength, const size_t maxDistance = SIZE_MAX)
+        {
+            return Details::TEditDistanceKernels<char>::iDistance(first, firstLength, second, secondLength, maxDistance);
         }
 
         static char* Fill(char* dest, const char val, const size_t length)
@@ -208,71 +197,152 @@ namespace CppMiniToolkit
             return (char*)memset(dest, val, length); // NOLINT
         }
 
+        // locale independent number conversion, see Details::TNumberConversion
+        template <typename TInteger>
+        static bool ParseInt(const char* str, const size_t length, TInteger& value, size_t* parsedLength = nullptr)
+        {
+            return Details::TNumberConversion<char>::ParseInt(str, length, value, parsedLength);
+        }
+
+        template <typename TInteger>
+        static bool ParseUInt(const char* str, const size_t length, TInteger& value, size_t* parsedLength = nullptr)
+        {
+            return Details::TNumberConversion<char>::ParseUInt(str, length, value, parsedLength);
+        }
+
+        static bool ParseDouble(const char* str, const size_t length, double& value, size_t* parsedLength = nullptr)
+        {
+            return Details::TNumberConversion<char>::ParseDouble(str, length, value, parsedLength);
+        }
+
+        template <typename TValue>
+        static char* ToChars(char* first, char* last, const TValue value)
+        {
+            return Details::TNumberConversion<char>::ToChars(first, last, value);
+        }
+
+        static char* ToCharsFixed(char* first, char* last, const double value, const int decimals)
+        {
+            return Details::TNumberConversion<char>::ToCharsFixed(first, last, value, decimals);
+        }
+
         // ReSharper disable once CommentTypo
         // NOLINTBEGIN
         static int IsAlnum(char ch)
         {
+#if CMT_CHAR_TRAITS_LOCALE_FREE
+            return AsciiCharTraits::IsAlnum(ch);
+#else
             return isalnum(ch);
+#endif
         }
 
         static int IsAlpha(char ch)
         {
+#if CMT_CHAR_TRAITS_LOCALE_FREE
+            return AsciiCharTraits::IsAlpha(ch);
+#else
             return isalpha(ch);
+#endif
         }
 
         static int IsLower(char ch)
         {
+#if CMT_CHAR_TRAITS_LOCALE_FREE
+            return AsciiCharTraits::IsLower(ch);
+#else
             return islower(ch);
+#endif
         }
 
         static int IsUpper(char ch)
         {
+#if CMT_CHAR_TRAITS_LOCALE_FREE
+            return AsciiCharTraits::IsUpper(ch);
+#else
             return isupper(ch);
+#endif
         }
 
         static int IsDigit(char ch)
         {
+#if CMT_CHAR_TRAITS_LOCALE_FREE
+            return AsciiCharTraits::IsDigit(ch);
+#else
             return isdigit(ch);
+#endif
         }
 
         static int IsXDigit(char ch)
         {
+#if CMT_CHAR_TRAITS_LOCALE_FREE
+            return AsciiCharTraits::IsXDigit(ch);
+#else
             return isxdigit(ch);
+#endif
         }
 
         static int IsCntrl(char ch)
         {
+#if CMT_CHAR_TRAITS_LOCALE_FREE
+            return AsciiCharTraits::IsCntrl(ch);
+#else
             return iscntrl(ch);
+#endif
         }
 
         static int IsGraph(char ch)
         {
+#if CMT_CHAR_TRAITS_LOCALE_FREE
+            return AsciiCharTraits::IsGraph(ch);
+#else
             return isgraph(ch);
+#endif
         }
 
         static int IsPrint(char ch)
         {
+#if CMT_CHAR_TRAITS_LOCALE_FREE
+            return AsciiCharTraits::IsPrint(ch);
+#else
             return isprint(ch);
+#endif
         }
 
         static int IsPunct(char ch)
         {
+#if CMT_CHAR_TRAITS_LOCALE_FREE
+            return AsciiCharTraits::IsPunct(ch);
+#else
             return ispunct(ch);
+#endif
         }
 
         static int IsSpace(char ch)
         {
+#if CMT_CHAR_TRAITS_LOCALE_FREE
+            return AsciiCharTraits::IsSpace(ch);
+#else
             return isspace(ch);
+#endif
         }
 
         static int ToLower(char ch)
         {
+#if CMT_CHAR_TRAITS_LOCALE_FREE
+            return AsciiCharTraits::ToLower(ch);
+#else
             return tolower(ch);
+#endif
         }
 
         static int ToUpper(char ch)
         {
+#if CMT_CHAR_TRAITS_LOCALE_FREE
+            return AsciiCharTraits::ToUpper(ch);
+#else
             return toupper(ch);
+#endif
         }
         // ReSharper disable once CommentTypo
         // NOLINTEND
@@ -298,62 +368,6 @@ namespace CppMiniToolkit
     template <>
     class TCharTraits<wchar_t> : public std::char_traits<wchar_t>
     {
-    private:
-        // ReSharper disable once CommentTypo
-        // NOLINTBEGIN
-        static const wchar_t* wcsrstr(const wchar_t* haystack, const wchar_t* needle)
-        {
-            const wchar_t* r = nullptr;
-
-            if (!needle[0])
-            {
-                return haystack + length(haystack);
-            }
-
-            while (true)
-            {
-                const wchar_t* p = wcsstr(haystack, needle);
-
-                if (!p)
-                {
-                    return r;
-                }
-
-                r = p;
-                haystack = p + 1;
-            }
-
-            // return nullptr;
-        }
-
-        /*
-         * Find the first occurrence of find in s, ignore case.
-         */
-        static const wchar_t* wcscasestr(const wchar_t* s, const wchar_t* find)
-        {
-            wchar_t c, sc;
-            size_t len;
-
-            if ((c = *find++) != 0)
-            {
-                c = (wchar_t)ToLower(c);
-                len = length(find);
-                do
-                {
-                    do
-                    {
-                        if ((sc = *s++) == 0)
-                        {
-                            return nullptr;
-                        }
-                    } while (ToLower(sc) != c);
-                } while (iCompareN(s, find, len) != 0);
-                s--;
-            }
-            return s;
-        }
-        // ReSharper disable once CommentTypo
-        // NOLINTEND
     public:
         static int32_t StringPrintf(
             wchar_t* string,
@@ -450,48 +464,86 @@ namespace CppMiniToolkit
 
         static const wchar_t* Find(const wchar_t* str, const wchar_t* match)
         {
-            return wcsstr(str, match);
+            return Find(str, wcslen(str), match, wcslen(match));
+        }
+
+        static const wchar_t* Find(const wchar_t* str, const size_t strLength, const wchar_t* match, const size_t matchLength)
+        {
+            return Details::TStringSearchKernels<wchar_t>::Find(str, strLength, match, matchLength);
         }
 
         static const wchar_t* iFind(const wchar_t* str, const wchar_t* match)
         {
-            return wcscasestr(str, match);
+            return iFind(str, wcslen(str), match, wcslen(match));
+        }
+
+        static const wchar_t* iFind(const wchar_t* str, const size_t strLength, const wchar_t* match, const size_t matchLength)
+        {
+            return Details::TStringSearchKernels<wchar_t>::iFind(str, strLength, match, matchLength);
+        }
+
+        // onMatch(offset) for every occurrence in one scan, returns the number of occurrences
+        template <typename TCallback>
+        static size_t FindAll(const wchar_t* str, const size_t strLength, const wchar_t* match, const size_t matchLength, const bool overlapping, TCallback& onMatch)
+        {
+            return Details::TStringSearchKernels<wchar_t>::FindAll(str, strLength, match, matchLength, overlapping, onMatch);
+        }
+
+        template <typename TCallback>
+        static size_t iFindAll(const wchar_t* str, const size_t strLength, const wchar_t* match, const size_t matchLength, const bool overlapping, TCallback& onMatch)
+        {
+            return Details::TStringSearchKernels<wchar_t>::iFindAll(str, strLength, match, matchLength, overlapping, onMatch);
         }
 
         static const wchar_t* rFind(const wchar_t* str, const wchar_t ch)
         {
-            return wcsrchr(str, ch);
+            return rFind(str, wcslen(str), ch);
+        }
+
+        static const wchar_t* rFind(const wchar_t* str, const size_t strLength, const wchar_t ch)
+        {
+            return Details::TStringSearchKernels<wchar_t>::rFind(str, strLength, ch);
         }
 
         static const wchar_t* rFind(const wchar_t* str, const wchar_t* subString)
         {
-            return wcsrstr(str, subString);
+            return rFind(str, wcslen(str), subString, wcslen(subString));
+        }
+
+        static const wchar_t* rFind(const wchar_t* str, const size_t strLength, const wchar_t* match, const size_t matchLength)
+        {
+            return Details::TStringSearchKernels<wchar_t>::rFind(str, strLength, match, matchLength);
         }
 
         static const wchar_t* rFindAny(const wchar_t* str, const wchar_t* targets)
         {
-            for (const wchar_t* p = str + wcslen(str) - 1; p >= str; --p)
-            {
-                if (wcschr(targets, *p) != nullptr)
-                {
-                    return p;
-                }
-            }
+            return rFindAny(str, wcslen(str), targets, wcslen(targets));
+        }
 
-            return nullptr;
+        static const wchar_t* rFindAny(const wchar_t* str, const size_t strLength, const wchar_t* targets, const size_t targetsLength)
+        {
+            return Details::TStringSearchKernels<wchar_t>::rFindAny(str, strLength, targets, targetsLength);
         }
 
         static const wchar_t* rFindNotOfAny(const wchar_t* str, const wchar_t* targets)
         {
-            for (const wchar_t* p = str + wcslen(str) - 1; p >= str; --p)
-            {
-                if (wcschr(targets, *p) == nullptr)
-                {
-                    return p;
-                }
-            }
+            return rFindNotOfAny(str, wcslen(str), targets, wcslen(targets));
+        }
+
+        static const wchar_t* rFindNotOfAny(const wchar_t* str, const size_t strLength, const wchar_t* targets, const size_t targetsLength)
+        {
+            return Details::TStringSearchKernels<wchar_t>::rFindNotOfAny(str, strLength, targets, targetsLength);
+        }
 
-            return nullptr;
+        // Levenshtein distance if it is at most maxDistance, maxDistance + 1 otherwise, see Details::TEditDistancePattern
+        static size_t EditDistance(const wchar_t* first, const size_t firstLength, const wchar_t* second, const size_t secondLength, const size_t maxDistance = SIZE_MAX)
+        {
+            return Details::TEditDistanceKernels<wchar_t>::Distance(first, firstLength, second, secondLength, maxDistance);
+        }
+
+        static size_t iEditDistance(const wchar_t* first, const size_t firstLength, const wchar_t* second, const size_t secondLength, const size_t maxDistance = SIZE_MAX)
+        {
+            return Details::TEditDistanceKernels<wchar_t>::iDistance(first, firstLength, second, secondLength, maxDistance);
         }
 
         static wchar_t* Fill(wchar_t* dest, const wchar_t val, const size_t length)
@@ -499,6 +551,35 @@ namespace CppMiniToolkit
             return wmemset(dest, val, length);
         }
 
+        // locale independent number conversion, see Details::TNumberConversion
+        template <typename TInteger>
+        static bool ParseInt(const wchar_t* str, const size_t length, TInteger& value, size_t* parsedLength = nullptr)
+        {
+            return Details::TNumberConversion<wchar_t>::ParseInt(str, length, value, parsedLength);
+        }
+
+        template <typename TInteger>
+        static bool ParseUInt(const wchar_t* str, const size_t length, TInteger& value, size_t* parsedLength = nullptr)
+        {
+            return Details::TNumberConversion<wchar_t>::ParseUInt(str, length, value, parsedLength);
+        }
+
+        static bool ParseDouble(const wchar_t* str, const size_t length, double& value, size_t* parsedLength = nullptr)
+        {
+            return Details::TNumberConversion<wchar_t>::ParseDouble(str, length, value, parsedLength);
+        }
+
+        template <typename TValue>
+        static wchar_t* ToChars(wchar_t* first, wchar_t* last, const TValue value)
+        {
+            return Details::TNumberConversion<wchar_t>::ToChars(first, last, value);
+        }
+
+        static wchar_t* ToCharsFixed(wchar_t* first, wchar_t* last, const double value, const int decimals)
+        {
+            return Details::TNumberConversion<wchar_t>::ToCharsFixed(first, last, value, decimals);
+        }
+
         static int IsAlnum(const wchar_t ch) // NOLINT
         {
             return iswalnum(ch);
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <Common/BuildConfig.hpp>
+#include <Common/CharTraits.hpp>
+#include <Common/Details/Simd.hpp>
+
+namespace CppMiniToolkit
+{
+    namespace Details
+    {
+        // case conversion of a run of characters, source and destination may be the same
+        // char converts ASCII letters only, so UTF-8 sequences pass through untouched
+        // wchar_t converts blocks of ASCII with SIMD, blocks with other characters go through towupper/towlower
+        template <typename TCharType>
+        class TCaseConversionKernels
+        {
+        public:
+            typedef TSimdLane<sizeof(TCharType)> LaneType;
+
+            static void ToUpper(const TCharType* source, TCharType* destination, const size_t length)
+            {
+                Convert<true>(source, destination, length);
+            }
+
+            static void ToLower(const TCharType* source, TCharType* destination, const size_t length)
+            {
+                Convert<false>(source, destination, length);
+            }
+
+        private:
+            template <bool Upper>
+            static TCharType ConvertOne(const TCharType ch)
+            {
+                const TCharType first = Upper ? TCharType('a') : TCharType('A');
+                const TCharType last = Upper ? TCharType('z') : TCharType('Z');
+
+                if (ch >= first && ch <= last)
+                {
+                    return static_cast<TCharType>(ch ^ 0x20);
+                }
+
+                if (sizeof(TCharType) == 1 || (ch >= 0 && ch < 0x80))
+                {
+                    return ch;
+                }
+
+                return static_cast<TCharType>(Upper ? TCharTraits<TCharType>::ToUpper(ch) : TCharTraits<TCharType>::ToLower(ch));
+            }
+
+            template <bool Upper>
+            static void ConvertScalar(const TCharType* source, TCharType* destination, const size_t length)
+            {
+                for (size_t i = 0; i < length; ++i)
+                {
+                    destination[i] = ConvertOne<Upper>(source[i]);
+                }
+            }
+
+            template <bool Upper>
+            static void Convert(const TCharType* source, TCharType* destination, const size_t length)
+            {
+                size_t i = 0;
+
+#if CMT_SIMD_AVX2
+                {
+                    constexpr size_t CharsPerBlock = 32 / sizeof(TCharType);
+
+                    const __m256i first = LaneType::Broadcast256(Upper ? 'a' - 1 : 'A' - 1);
+                    const __m256i last = LaneType::Broadcast256(Upper ? 'z' + 1 : 'Z' + 1);
+                    const __m256i caseBit = LaneType::Broadcast256(0x20);
+                    const __m256i asciiLast = LaneType::Broadcast256(0x7F);
+                    const __m256i zero = _mm256_setzero_si256();
+
+                    for (; i + CharsPerBlock <= length; i += CharsPerBlock)
+                    {
+                        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+
+                        // negative lanes are outside of ASCII as well
+                        if (sizeof(TCharType) > 1 &&
+                            !_mm256_testz_si256(_mm256_or_si256(LaneType::CompareGreater256(block, asciiLast), LaneType::CompareGreater256(zero, block)), _mm256_set1_epi8(-1)))
+                        {
+                            ConvertScalar<Upper>(source + i, destination + i, CharsPerBlock);
+                            continue;
+                        }
+
+                        const __m256i letters = _mm256_and_si256(LaneType::CompareGreater256(block, first), LaneType::CompareGreater256(last, block));
+
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_xor_si256(block, _mm256_and_si256(letters, caseBit)));
+                    }
+                }
+#endif
+
+#if CMT_SIMD_SSE2
+                {
+                    constexpr size_t CharsPerBlock = 16 / sizeof(TCharType);
+
+                    const __m128i first = LaneType::Broadcast128(Upper ? 'a' - 1 : 'A' - 1);
+                    const __m128i last = LaneType::Broadcast128(Upper ? 'z' + 1 : 'Z' + 1);
+                    const __m128i caseBit = LaneType::Broadcast128(0x20);
+                    const __m128i asciiLast = LaneType::Broadcast128(0x7F);
+                    const __m128i zero = _mm_setzero_si128();
+
+                    for (; i + CharsPerBlock <= length; i += CharsPerBlock)
+                    {
+                        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+
+                        if (sizeof(TCharType) > 1 &&
+                            _mm_movemask_epi8(_mm_or_si128(LaneType::CompareGreater128(block, asciiLast), LaneType::CompareGreater128(zero, block))) != 0)
+                        {
+                            ConvertScalar<Upper>(source + i, destination + i, CharsPerBlock);
+                            continue;
+                        }
+
+                        const __m128i letters = _mm_and_si128(LaneType::CompareGreater128(block, first), LaneType::CompareGreater128(last, block));
+
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_xor_si128(block, _mm_and_si128(letters, caseBit)));
+                    }
+                }
+#endif
+
+                ConvertScalar<Upper>(source + i, destination + i, length - i);
+            }
+        };
+    }
+}
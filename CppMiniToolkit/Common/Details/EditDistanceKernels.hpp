@@ -0,0 +1,281 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include <Common/BuildConfig.hpp>
+#include <Common/Details/StringSearchKernels.hpp>
+
+namespace CppMiniToolkit
+{
+    namespace Details
+    {
+        // Levenshtein distance with the bit parallel algorithm of Myers in the formulation of Hyyrö:
+        // a column of the dynamic programming matrix is kept as vertical delta bit vectors, one bit per
+        // character of the pattern, and is advanced by one character of the text with a few word operations.
+        // patterns up to 64 characters take one word per text character, longer ones are split into blocks
+        // of 64 rows that pass their horizontal delta down to the next block.
+        // the pattern is preprocessed once, so it can be compared with many texts
+        template <typename TCharType, bool IgnoreCase>
+        class TEditDistancePattern
+        {
+        public:
+            typedef typename std::make_unsigned<TCharType>::type UnsignedCharType;
+
+            constexpr static size_t BlockBits = 64;
+
+            TEditDistancePattern(const TCharType* pattern, const size_t length) :
+                Length(length),
+                BlockCount((length + BlockBits - 1) / BlockBits),
+                Masks(256 * BlockCount, 0),
+                Zero(BlockCount, 0)
+            {
+                for (size_t i = 0; i < length; ++i)
+                {
+                    const TCharType ch = Fold(pattern[i]);
+                    const auto value = static_cast<UnsignedCharType>(ch);
+
+                    if (value < 256)
+                    {
+                        Masks[value * BlockCount + i / BlockBits] |= static_cast<uint64_t>(1) << (i % BlockBits);
+                    }
+                    else if (!std::binary_search(WideCharacters.begin(), WideCharacters.end(), ch))
+                    {
+                        WideCharacters.insert(std::lower_bound(WideCharacters.begin(), WideCharacters.end(), ch), ch);
+                    }
+                }
+
+                // characters beyond 256 exist only for wide strings, their masks follow the table in the same order
+                WideMasks.resize(WideCharacters.size() * BlockCount, 0);
+
+                for (size_t i = 0; i < length; ++i)
+                {
+                    const TCharType ch = Fold(pattern[i]);
+
+                    if (static_cast<UnsignedCharType>(ch) >= 256)
+                    {
+                        const auto index = static_cast<size_t>(std::lower_bound(WideCharacters.begin(), WideCharacters.end(), ch) - WideCharacters.begin());
+                        WideMasks[index * BlockCount + i / BlockBits] |= static_cast<uint64_t>(1) << (i % BlockBits);
+                    }
+                }
+            }
+
+            size_t GetLength() const
+            {
+                return Length;
+            }
+
+            // the distance between the pattern and text if it is at most maxDistance, maxDistance + 1 otherwise.
+            // the scan stops once the distance can't get down to maxDistance anymore
+            size_t Distance(const TCharType* text, const size_t textLength, const size_t maxDistance) const
+            {
+                const size_t lengthDifference = Length > textLength ? Length - textLength : textLength - Length;
+
+                if (lengthDifference > maxDistance)
+                {
+                    return maxDistance + 1;
+                }
+
+                if (Length == 0 || textLength == 0)
+                {
+                    return lengthDifference;
+                }
+
+                const size_t distance = BlockCount == 1 ?
+                    DistanceWord(text, textLength, maxDistance) :
+                    DistanceBlocks(text, textLength, maxDistance);
+
+                return distance <= maxDistance ? distance : maxDistance + 1;
+            }
+
+        private:
+            static TCharType Fold(const TCharType ch)
+            {
+                return IgnoreCase ? TCaseFolding<TCharType>::Fold(ch) : ch;
+            }
+
+            const uint64_t* GetMasks(const TCharType ch) const
+            {
+                const TCharType folded = Fold(ch);
+                const auto value = static_cast<UnsignedCharType>(folded);
+
+                if (value < 256)
+                {
+                    return &Masks[value * BlockCount];
+                }
+
+                const auto position = std::lower_bound(WideCharacters.begin(), WideCharacters.end(), folded);
+
+                if (position == WideCharacters.end() || *position != folded)
+                {
+                    return Zero.data();
+                }
+
+                return &WideMasks[static_cast<size_t>(position - WideCharacters.begin()) * BlockCount];
+            }
+
+            // the distance at the last row can drop by at most one per remaining text character
+            static bool IsOutOfReach(const size_t score, const size_t remaining, const size_t maxDistance)
+            {
+                return score > remaining && score - remaining > maxDistance;
+            }
+
+            size_t DistanceWord(const TCharType* text, const size_t textLength, const size_t maxDistance) const
+            {
+                const uint64_t last = static_cast<uint64_t>(1) << (Length - 1);
+
+                // vertical deltas +1 and -1 of the current column, the first column is 0, 1, 2 ... Length
+                uint64_t pv = ~static_cast<uint64_t>(0);
+                uint64_t mv = 0;
+                size_t score = Length;
+
+                for (size_t j = 0; j < textLength; ++j)
+                {
+                    const uint64_t eq = GetMasks(text[j])[0];
+                    const uint64_t xv = eq | mv;
+                    const uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+                    uint64_t ph = mv | ~(xh | pv);
+                    uint64_t mh = pv & xh;
+
+                    if ((ph & last) != 0)
+                    {
+                        ++score;
+                    }
+                    else if ((mh & last) != 0)
+                    {
+                        --score;
+                    }
+
+                    // the first row grows by one per text character
+                    ph = ph << 1 | 1;
+                    mh <<= 1;
+
+                    pv = mh | ~(xv | ph);
+                    mv = ph & xv;
+
+                    if (IsOutOfReach(score, textLength - j - 1, maxDistance))
+                    {
+                        return maxDistance + 1;
+                    }
+                }
+
+                return score;
+            }
+
+            size_t DistanceBlocks(const TCharType* text, const size_t textLength, const size_t maxDistance) const
+            {
+                std::vector<uint64_t> pv(BlockCount, ~static_cast<uint64_t>(0));
+                std::vector<uint64_t> mv(BlockCount, 0);
+
+                const uint64_t high = static_cast<uint64_t>(1) << (BlockBits - 1);
+                const uint64_t last = static_cast<uint64_t>(1) << ((Length - 1) % BlockBits);
+                size_t score = Length;
+
+                for (size_t j = 0; j < textLength; ++j)
+                {
+                    const uint64_t* masks = GetMasks(text[j]);
+
+                    // horizontal delta entering the top of the block, +1 at the first row
+                    int carry = 1;
+
+                    for (size_t block = 0; block < BlockCount; ++block)
+                    {
+                        carry = AdvanceBlock(pv[block], mv[block], masks[block], carry, block + 1 < BlockCount ? high : last);
+                    }
+
+                    score = carry > 0 ? score + 1 : carry < 0 ? score - 1 : score;
+
+                    if (IsOutOfReach(score, textLength - j - 1, maxDistance))
+                    {
+                        return maxDistance + 1;
+                    }
+                }
+
+                return score;
+            }
+
+            // one text character for 64 rows, returns the horizontal delta at the row of bottom
+            static int AdvanceBlock(uint64_t& pv, uint64_t& mv, uint64_t eq, const int carry, const uint64_t bottom)
+            {
+                const uint64_t xv = eq | mv;
+
+                if (carry < 0)
+                {
+                    eq |= 1;
+                }
+
+                const uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+                uint64_t ph = mv | ~(xh | pv);
+                uint64_t mh = pv & xh;
+
+                const int result = (ph & bottom) != 0 ? 1 : (mh & bottom) != 0 ? -1 : 0;
+
+                ph <<= 1;
+                mh <<= 1;
+
+                if (carry < 0)
+                {
+                    mh |= 1;
+                }
+                else if (carry > 0)
+                {
+                    ph |= 1;
+                }
+
+                pv = mh | ~(xv | ph);
+                mv = ph & xv;
+
+                return result;
+            }
+
+        private:
+            size_t                      Length;
+            size_t                      BlockCount;
+            // BlockCount words for each character below 256
+            std::vector<uint64_t>       Masks;
+            std::vector<TCharType>      WideCharacters;
+            std::vector<uint64_t>       WideMasks;
+            std::vector<uint64_t>       Zero;
+        };
+
+        template <typename TCharType, bool IgnoreCase>
+        constexpr size_t TEditDistancePattern<TCharType, IgnoreCase>::BlockBits;
+
+        template <typename TCharType>
+        class TEditDistanceKernels
+        {
+        public:
+            CMT_DECLARE_TOOLKIT_CLASS_TYPE(TEditDistanceKernels);
+
+            // the Levenshtein distance if it is at most maxDistance, maxDistance + 1 otherwise
+            static size_t Distance(const TCharType* first, const size_t firstLength, const TCharType* second, const size_t secondLength, const size_t maxDistance)
+            {
+                return DistanceCore<false>(first, firstLength, second, secondLength, maxDistance);
+            }
+
+            // ignore case with the folding rules of iFind
+            static size_t iDistance(const TCharType* first, const size_t firstLength, const TCharType* second, const size_t secondLength, const size_t maxDistance)
+            {
+                return DistanceCore<true>(first, firstLength, second, secondLength, maxDistance);
+            }
+
+        private:
+            template <bool IgnoreCase>
+            static size_t DistanceCore(const TCharType* first, const size_t firstLength, const TCharType* second, const size_t secondLength, const size_t maxDistance)
+            {
+                // the shorter string is the pattern, so it needs fewer blocks
+                if (firstLength > secondLength)
+                {
+                    return DistanceCore<IgnoreCase>(second, secondLength, first, firstLength, maxDistance);
+                }
+
+                const TEditDistancePattern<TCharType, IgnoreCase> pattern(first, firstLength);
+
+                return pattern.Distance(second, secondLength, maxDistance);
+            }
+        };
+    }
+}
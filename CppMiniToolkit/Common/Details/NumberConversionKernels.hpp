@@ -0,0 +1,1026 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdlib>
+#include <clocale>
+#include <cmath>
+#include <string>
+#include <limits>
+#include <type_traits>
+
+#include <Common/BuildConfig.hpp>
+#include <Common/Details/Simd.hpp>
+
+// eight ASCII digits are parsed at once by reading them as a little endian word
+#if CMT_COMPILER_MSVC || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define CMT_NUMBER_PARSE_SWAR  1  // NOLINT(modernize-macro-to-enum)
+#else
+#define CMT_NUMBER_PARSE_SWAR  0  // NOLINT(modernize-macro-to-enum)
+#endif
+
+namespace CppMiniToolkit
+{
+    namespace Details
+    {
+        // integer to text without printf, digits are written backwards from the end of a buffer
+        template <typename TCharType>
+        struct TIntegerFormatter
+        {
+            // enough for any 64 bit value in decimal or hexadecimal, with a sign
+            constexpr static size_t MaxLength = 24;
+
+            static TCharType* FormatUnsigned(TCharType* end, uint64_t value)
+            {
+                static const char S_DigitPairs[] =
+                    "00010203040506070809"
+                    "10111213141516171819"
+                    "20212223242526272829"
+                    "30313233343536373839"
+                    "40414243444546474849"
+                    "50515253545556575859"
+                    "60616263646566676869"
+                    "70717273747576777879"
+                    "80818283848586878889"
+                    "90919293949596979899";
+
+                while (value >= 100)
+                {
+                    const auto pair = static_cast<size_t>(value % 100) * 2;
+                    value /= 100;
+
+                    *--end = static_cast<TCharType>(S_DigitPairs[pair + 1]);
+                    *--end = static_cast<TCharType>(S_DigitPairs[pair]);
+                }
+
+                if (value >= 10)
+                {
+                    const auto pair = static_cast<size_t>(value) * 2;
+
+                    *--end = static_cast<TCharType>(S_DigitPairs[pair + 1]);
+                    *--end = static_cast<TCharType>(S_DigitPairs[pair]);
+                }
+                else
+                {
+                    *--end = static_cast<TCharType>('0' + value);
+                }
+
+                return end;
+            }
+
+            static TCharType* FormatSigned(TCharType* end, const int64_t value)
+            {
+                // negate in unsigned arithmetic so INT64_MIN does not overflow
+                if (value < 0)
+                {
+                    end = FormatUnsigned(end, 0 - static_cast<uint64_t>(value));
+                    *--end = TCharType('-');
+                    return end;
+                }
+
+                return FormatUnsigned(end, static_cast<uint64_t>(value));
+            }
+
+            static TCharType* FormatHex(TCharType* end, uint64_t value, const size_t minDigits, const bool upper)
+            {
+                const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+                const TCharType* last = end;
+
+                do
+                {
+                    *--end = static_cast<TCharType>(digits[value & 0xF]);
+                    value >>= 4;
+                } while (value != 0);
+
+                while (static_cast<size_t>(last - end) < minDigits && static_cast<size_t>(last - end) < 16)
+                {
+                    *--end = TCharType('0');
+                }
+
+                return end;
+            }
+        };
+
+        template <typename TFloat>
+        struct TFloatTraits;
+
+        template <>
+        struct TFloatTraits<double>
+        {
+            typedef uint64_t BitsType;
+
+            constexpr static int SignificandSize = 52;
+            constexpr static int ExponentBias = 0x3FF + SignificandSize;
+            constexpr static BitsType SignificandMask = 0x000FFFFFFFFFFFFFull;
+            constexpr static BitsType ExponentMask = 0x7FF0000000000000ull;
+        };
+
+        template <>
+        struct TFloatTraits<float>
+        {
+            typedef uint32_t BitsType;
+
+            constexpr static int SignificandSize = 23;
+            constexpr static int ExponentBias = 0x7F + SignificandSize;
+            constexpr static BitsType SignificandMask = 0x007FFFFFu;
+            constexpr static BitsType ExponentMask = 0x7F800000u;
+        };
+
+        // a floating point value f * 2^e with a 64 bit significand
+        struct TDiyFp
+        {
+            uint64_t    F;
+            int         E;
+
+            TDiyFp(const uint64_t f = 0, const int e = 0) :
+                F(f),
+                E(e)
+            {
+            }
+
+            TDiyFp operator -(const TDiyFp& other) const
+            {
+                return TDiyFp(F - other.F, E);
+            }
+
+            // the high 64 bits of the product, rounded
+            TDiyFp operator *(const TDiyFp& other) const
+            {
+                uint64_t low = F;
+                uint64_t high = other.F;
+                Multiply128(low, high);
+
+                return TDiyFp(high + (low >> 63), E + other.E + 64);
+            }
+
+            TDiyFp Normalize() const
+            {
+                const int shift = static_cast<int>(CountLeadingZeros64(F));
+
+                return TDiyFp(F << shift, E - shift);
+            }
+        };
+
+        // Grisu2 (Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with Integers"):
+        // the digits always read back as the same value, and are the shortest such digits for nearly all values
+        class TShortestFormatter
+        {
+        public:
+            // shortest digits of value as JavaScript prints them: 123, 0.001, 1.5e+300, -inf, nan
+            // buffer needs MaxLength characters, the length is returned
+            constexpr static size_t MaxLength = 32;
+
+            template <typename TFloat>
+            static size_t Format(const TFloat value, char* buffer)
+            {
+                typedef TFloatTraits<TFloat> TraitsType;
+
+                typename TraitsType::BitsType bits;
+                memcpy(&bits, &value, sizeof(bits));
+
+                char* output = buffer;
+
+                if (bits >> (sizeof(bits) * 8 - 1))
+                {
+                    *output++ = '-';
+                }
+
+                if ((bits & TraitsType::ExponentMask) == TraitsType::ExponentMask)
+                {
+                    if ((bits & TraitsType::SignificandMask) != 0)
+                    {
+                        memcpy(buffer, "nan", 3);
+                        return 3;
+                    }
+
+                    memcpy(output, "inf", 3);
+                    return static_cast<size_t>(output - buffer) + 3;
+                }
+
+                if ((bits & (TraitsType::ExponentMask | TraitsType::SignificandMask)) == 0)
+                {
+                    *output++ = '0';
+                    return static_cast<size_t>(output - buffer);
+                }
+
+                int length = 0;
+                int exponent = 0;
+                Grisu2<TFloat>(bits, output, length, exponent);
+
+                return static_cast<size_t>(output - buffer) + Prettify(output, length, exponent);
+            }
+
+        private:
+            static TDiyFp GetCachedPower(const int e, int& k)
+            {
+                // 10^-348, 10^-340, ..., 10^340 normalized to 64 bits
+                static const uint64_t S_Significands[] =
+                {
+                    0xfa8fd5a0081c0288ull, 0xbaaee17fa23ebf76ull, 0x8b16fb203055ac76ull, 0xcf42894a5dce35eaull,
+                    0x9a6bb0aa55653b2dull, 0xe61acf033d1a45dfull, 0xab70fe17c79ac6caull, 0xff77b1fcbebcdc4full,
+                    0xbe5691ef416bd60cull, 0x8dd01fad907ffc3cull, 0xd3515c2831559a83ull, 0x9d71ac8fada6c9b5ull,
+                    0xea9c227723ee8bcbull, 0xaecc49914078536dull, 0x823c12795db6ce57ull, 0xc21094364dfb5637ull,
+                    0x9096ea6f3848984full, 0xd77485cb25823ac7ull, 0xa086cfcd97bf97f4ull, 0xef340a98172aace5ull,
+                    0xb23867fb2a35b28eull, 0x84c8d4dfd2c63f3bull, 0xc5dd44271ad3cdbaull, 0x936b9fcebb25c996ull,
+                    0xdbac6c247d62a584ull, 0xa3ab66580d5fdaf6ull, 0xf3e2f893dec3f126ull, 0xb5b5ada8aaff80b8ull,
+                    0x87625f056c7c4a8bull, 0xc9bcff6034c13053ull, 0x964e858c91ba2655ull, 0xdff9772470297ebdull,
+                    0xa6dfbd9fb8e5b88full, 0xf8a95fcf88747d94ull, 0xb94470938fa89bcfull, 0x8a08f0f8bf0f156bull,
+                    0xcdb02555653131b6ull, 0x993fe2c6d07b7facull, 0xe45c10c42a2b3b06ull, 0xaa242499697392d3ull,
+                    0xfd87b5f28300ca0eull, 0xbce5086492111aebull, 0x8cbccc096f5088ccull, 0xd1b71758e219652cull,
+                    0x9c40000000000000ull, 0xe8d4a51000000000ull, 0xad78ebc5ac620000ull, 0x813f3978f8940984ull,
+                    0xc097ce7bc90715b3ull, 0x8f7e32ce7bea5c70ull, 0xd5d238a4abe98068ull, 0x9f4f2726179a2245ull,
+                    0xed63a231d4c4fb27ull, 0xb0de65388cc8ada8ull, 0x83c7088e1aab65dbull, 0xc45d1df942711d9aull,
+                    0x924d692ca61be758ull, 0xda01ee641a708deaull, 0xa26da3999aef774aull, 0xf209787bb47d6b85ull,
+                    0xb454e4a179dd1877ull, 0x865b86925b9bc5c2ull, 0xc83553c5c8965d3dull, 0x952ab45cfa97a0b3ull,
+                    0xde469fbd99a05fe3ull, 0xa59bc234db398c25ull, 0xf6c69a72a3989f5cull, 0xb7dcbf5354e9beceull,
+                    0x88fcf317f22241e2ull, 0xcc20ce9bd35c78a5ull, 0x98165af37b2153dfull, 0xe2a0b5dc971f303aull,
+                    0xa8d9d1535ce3b396ull, 0xfb9b7cd9a4a7443cull, 0xbb764c4ca7a44410ull, 0x8bab8eefb6409c1aull,
+                    0xd01fef10a657842cull, 0x9b10a4e5e9913129ull, 0xe7109bfba19c0c9dull, 0xac2820d9623bf429ull,
+                    0x80444b5e7aa7cf85ull, 0xbf21e44003acdd2dull, 0x8e679c2f5e44ff8full, 0xd433179d9c8cb841ull,
+                    0x9e19db92b4e31ba9ull, 0xeb96bf6ebadf77d9ull, 0xaf87023b9bf0ee6bull
+                };
+
+                static const int16_t S_Exponents[] =
+                {
+                    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927, -901, -874, -847, -821,
+                    -794, -768, -741, -715, -688, -661, -635, -608, -582, -555, -529, -502, -475, -449, -422, -396,
+                    -369, -343, -316, -289, -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+                    56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348, 375, 402, 428, 455,
+                    481, 508, 534, 561, 588, 614, 641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+                    907, 933, 960, 986, 1013, 1039, 1066
+                };
+
+                // the smallest power whose product with a significand of exponent e lands in [-60, -32]
+                const double dk = (-61 - e) * 0.30102999566398114 + 347;
+                int index = static_cast<int>(dk);
+
+                if (dk - index > 0.0)
+                {
+                    ++index;
+                }
+
+                index = (index >> 3) + 1;
+                k = -(-348 + index * 8);
+
+                return TDiyFp(S_Significands[index], S_Exponents[index]);
+            }
+
+            static int CountDecimalDigits(const uint32_t value)
+            {
+                int count = 1;
+
+                for (uint32_t limit = 10; count < 10 && value >= limit; limit *= 10)
+                {
+                    ++count;
+                }
+
+                return count;
+            }
+
+            static void Round(char* buffer, const int length, const uint64_t delta, uint64_t rest, const uint64_t tenKappa, const uint64_t distance)
+            {
+                while (rest < distance && delta - rest >= tenKappa && (rest + tenKappa < distance || distance - rest > rest + tenKappa - distance))
+                {
+                    --buffer[length - 1];
+                    rest += tenKappa;
+                }
+            }
+
+            static void GenerateDigits(const TDiyFp& w, const TDiyFp& upper, uint64_t delta, char* buffer, int& length, int& k)
+            {
+                static const uint32_t S_Pow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+                const TDiyFp one(1ull << -upper.E, upper.E);
+                const uint64_t distance = (upper - w).F;
+
+                auto integral = static_cast<uint32_t>(upper.F >> -one.E);
+                uint64_t fractional = upper.F & (one.F - 1);
+                int kappa = CountDecimalDigits(integral);
+
+                length = 0;
+
+                while (kappa > 0)
+                {
+                    const uint32_t digit = integral / S_Pow10[kappa - 1];
+                    integral %= S_Pow10[kappa - 1];
+
+                    if (digit != 0 || length != 0)
+                    {
+                        buffer[length++] = static_cast<char>('0' + digit);
+                    }
+
+                    --kappa;
+
+                    const uint64_t rest = (static_cast<uint64_t>(integral) << -one.E) + fractional;
+
+                    if (rest <= delta)
+                    {
+                        k += kappa;
+                        Round(buffer, length, delta, rest, static_cast<uint64_t>(S_Pow10[kappa]) << -one.E, distance);
+                        return;
+                    }
+                }
+
+                for (;;)
+                {
+                    fractional *= 10;
+                    delta *= 10;
+
+                    const auto digit = static_cast<char>(fractional >> -one.E);
+
+                    if (digit != 0 || length != 0)
+                    {
+                        buffer[length++] = static_cast<char>('0' + digit);
+                    }
+
+                    fractional &= one.F - 1;
+                    --kappa;
+
+                    if (fractional < delta)
+                    {
+                        k += kappa;
+                        Round(buffer, length, delta, fractional, one.F, -kappa < 10 ? distance * S_Pow10[-kappa] : 0);
+                        return;
+                    }
+                }
+            }
+
+            // digits * 10^k is value, for a finite non zero value
+            template <typename TFloat>
+            static void Grisu2(const typename TFloatTraits<TFloat>::BitsType bits, char* buffer, int& length, int& k)
+            {
+                typedef TFloatTraits<TFloat> TraitsType;
+
+                const uint64_t hidden = 1ull << TraitsType::SignificandSize;
+                const uint64_t significand = bits & TraitsType::SignificandMask;
+                const int biased = static_cast<int>((bits & TraitsType::ExponentMask) >> TraitsType::SignificandSize);
+
+                const TDiyFp value = biased != 0 ?
+                    TDiyFp(significand + hidden, biased - TraitsType::ExponentBias) :
+                    TDiyFp(significand, 1 - TraitsType::ExponentBias);
+
+                // the midpoints to the neighbours, the lower one is closer at a power of two
+                const TDiyFp plus = TDiyFp((value.F << 1) + 1, value.E - 1).Normalize();
+                TDiyFp minus = value.F == hidden && biased > 1 ? TDiyFp((value.F << 2) - 1, value.E - 2) : TDiyFp((value.F << 1) - 1, value.E - 1);
+
+                minus.F <<= minus.E - plus.E;
+                minus.E = plus.E;
+
+                const TDiyFp cachedPower = GetCachedPower(plus.E, k);
+                const TDiyFp w = value.Normalize() * cachedPower;
+                TDiyFp upper = plus * cachedPower;
+                TDiyFp lower = minus * cachedPower;
+
+                // stay inside the rounding interval despite the error of the products
+                ++lower.F;
+                --upper.F;
+
+                GenerateDigits(w, upper, upper.F - lower.F, buffer, length, k);
+            }
+
+            // lays out digits * 10^k and returns the length
+            static size_t Prettify(char* buffer, const int length, const int k)
+            {
+                const int point = length + k;
+
+                // 1234e7 -> 12340000000
+                if (k >= 0 && point <= 21)
+                {
+                    memset(buffer + length, '0', static_cast<size_t>(k));
+                    return static_cast<size_t>(point);
+                }
+
+                // 1234e-2 -> 12.34
+                if (point > 0 && point <= 21)
+                {
+                    memmove(buffer + point + 1, buffer + point, static_cast<size_t>(length - point));
+                    buffer[point] = '.';
+                    return static_cast<size_t>(length + 1);
+                }
+
+                // 1234e-6 -> 0.001234
+                if (point > -6 && point <= 0)
+                {
+                    const int offset = 2 - point;
+
+                    memmove(buffer + offset, buffer, static_cast<size_t>(length));
+                    buffer[0] = '0';
+                    buffer[1] = '.';
+                    memset(buffer + 2, '0', static_cast<size_t>(offset - 2));
+
+                    return static_cast<size_t>(length + offset);
+                }
+
+                // 1234e30 -> 1.234e+33
+                int position = 1;
+
+                if (length > 1)
+                {
+                    memmove(buffer + 2, buffer + 1, static_cast<size_t>(length - 1));
+                    buffer[1] = '.';
+                    position = length + 1;
+                }
+
+                int exponent = point - 1;
+
+                buffer[position++] = 'e';
+                buffer[position++] = exponent < 0 ? '-' : '+';
+
+                if (exponent < 0)
+                {
+                    exponent = -exponent;
+                }
+
+                if (exponent >= 100)
+                {
+                    buffer[position++] = static_cast<char>('0' + exponent / 100);
+                    exponent %= 100;
+                    buffer[position++] = static_cast<char>('0' + exponent / 10);
+                }
+                else if (exponent >= 10)
+                {
+                    buffer[position++] = static_cast<char>('0' + exponent / 10);
+                }
+
+                buffer[position++] = static_cast<char>('0' + exponent % 10);
+
+                return static_cast<size_t>(position);
+            }
+        };
+
+        // value rounded exactly to a fixed number of decimals like printf("%.*f"), for |value| * 10^decimals below 2^63;
+        // larger values are written by TShortestFormatter. buffer needs MaxLength characters
+        struct TFixedFormatter
+        {
+            constexpr static int MaxDecimals = 9;
+            constexpr static size_t MaxLength = 32;
+
+            static size_t Format(const double value, int decimals, char* buffer)
+            {
+                static const uint64_t S_Pow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+                if (decimals < 0)
+                {
+                    decimals = 0;
+                }
+                else if (decimals > MaxDecimals)
+                {
+                    decimals = MaxDecimals;
+                }
+
+                const double scaled = std::fabs(value) * static_cast<double>(S_Pow10[decimals]);
+
+                if (!(scaled < 9.2e18))
+                {
+                    return TShortestFormatter::Format(value, buffer);
+                }
+
+                const uint64_t units = RoundScaled(value, S_Pow10[decimals]);
+                char digits[TIntegerFormatter<char>::MaxLength];
+                char* const digitsEnd = digits + TIntegerFormatter<char>::MaxLength;
+                char* output = buffer;
+
+                if (std::signbit(value))
+                {
+                    *output++ = '-';
+                }
+
+                const char* integral = TIntegerFormatter<char>::FormatUnsigned(digitsEnd, units / S_Pow10[decimals]);
+                memcpy(output, integral, static_cast<size_t>(digitsEnd - integral));
+                output += digitsEnd - integral;
+
+                if (decimals > 0)
+                {
+                    *output++ = '.';
+
+                    uint64_t fraction = units % S_Pow10[decimals];
+
+                    for (int i = decimals - 1; i >= 0; --i)
+                    {
+                        output[i] = static_cast<char>('0' + fraction % 10);
+                        fraction /= 10;
+                    }
+
+                    output += decimals;
+                }
+
+                return static_cast<size_t>(output - buffer);
+            }
+
+        private:
+            // |value| * scale rounded half to even from the exact binary value, so that no intermediate
+            // double rounding can move a value across the halfway point
+            static uint64_t RoundScaled(const double value, const uint64_t scale)
+            {
+                typedef TFloatTraits<double> TTraits;
+
+                uint64_t bits;
+                memcpy(&bits, &value, sizeof(bits));
+
+                const int biased = static_cast<int>((bits & TTraits::ExponentMask) >> TTraits::SignificandSize);
+                uint64_t significand = bits & TTraits::SignificandMask;
+                int exponent = 1 - TTraits::ExponentBias;
+
+                if (biased != 0)
+                {
+                    significand |= TTraits::SignificandMask + 1;
+                    exponent = biased - TTraits::ExponentBias;
+                }
+
+                if (exponent >= 0)
+                {
+                    return (significand << exponent) * scale;
+                }
+
+                const int shift = -exponent;
+
+                if (shift >= 128)
+                {
+                    // significand * scale is below 2^83, far less than half of 2^shift
+                    return 0;
+                }
+
+                uint64_t low = significand;
+                uint64_t high = scale;
+                Multiply128(low, high);
+
+                uint64_t units;
+                bool roundBit;
+                bool sticky;
+
+                if (shift < 64)
+                {
+                    units = (low >> shift) | (high << (63 - shift) << 1);
+                    roundBit = ((low >> (shift - 1)) & 1) != 0;
+                    sticky = (low & ((uint64_t(1) << (shift - 1)) - 1)) != 0;
+                }
+                else
+                {
+                    units = high >> (shift - 64);
+                    roundBit = shift == 64 ? (low >> 63) != 0 : ((high >> (shift - 65)) & 1) != 0;
+                    sticky = shift == 64 ? (low << 1) != 0 : (low != 0 || (high & ((uint64_t(1) << (shift - 65)) - 1)) != 0);
+                }
+
+                return units + ((roundBit && (sticky || (units & 1) != 0)) ? 1 : 0);
+            }
+        };
+
+        // locale independent parsing of decimal numbers
+        template <typename TCharType>
+        class TNumberParser
+        {
+        public:
+            static bool IsDigit(const TCharType ch)
+            {
+                return ch >= TCharType('0') && ch <= TCharType('9');
+            }
+
+            // digits into value, false in overflow when the number does not fit in 64 bits
+            // returns the end of the digits, or nullptr when there are none
+            static const TCharType* ParseUnsigned(const TCharType* str, const TCharType* end, uint64_t& value, bool& overflow)
+            {
+                const TCharType* p = str;
+
+                // leading zeros do not count against the 20 digits of uint64_t
+                while (p != end && *p == TCharType('0'))
+                {
+                    ++p;
+                }
+
+                uint64_t result = 0;
+                size_t digits = 0;
+
+                overflow = false;
+
+                while (p != end)
+                {
+                    // 19 digits always fit, beyond that every digit is checked
+                    if (digits + 8 <= 19 && ParseEightDigits(p, end, result))
+                    {
+                        digits += 8;
+                        p += 8;
+                        continue;
+                    }
+
+                    if (!IsDigit(*p))
+                    {
+                        break;
+                    }
+
+                    const auto digit = static_cast<uint64_t>(*p - TCharType('0'));
+
+                    if (digits >= 19 && (digits > 19 || result > (UINT64_MAX - digit) / 10))
+                    {
+                        overflow = true;
+                    }
+                    else
+                    {
+                        result = result * 10 + digit;
+                    }
+
+                    ++digits;
+                    ++p;
+                }
+
+                value = result;
+
+                return p != str ? p : nullptr;
+            }
+
+            // [sign] digits [. digits] [(e|E) [sign] digits], inf, infinity or nan
+            // returns the end of the number, or nullptr when there is none
+            static const TCharType* ParseDouble(const TCharType* str, const TCharType* end, double& value)
+            {
+                const TCharType* p = str;
+                bool negative = false;
+
+                if (p != end && (*p == TCharType('+') || *p == TCharType('-')))
+                {
+                    negative = *p == TCharType('-');
+                    ++p;
+                }
+
+                const TCharType* special = ParseSpecial(p, end, value);
+
+                if (special != nullptr)
+                {
+                    value = negative ? -value : value;
+                    return special;
+                }
+
+                // the first 19 significant digits go to mantissa, the dropped ones only flag the value as inexact
+                uint64_t mantissa = 0;
+                int digits = 0;
+                int exponent = 0;
+                bool dropped = false;
+                bool anyDigit = false;
+
+                for (bool fraction = false; p != end; )
+                {
+                    if (mantissa != 0 && digits + 8 <= 19 && ParseEightDigits(p, end, mantissa))
+                    {
+                        digits += 8;
+                        exponent -= fraction ? 8 : 0;
+                        p += 8;
+                        continue;
+                    }
+
+                    if (!fraction && *p == TCharType('.'))
+                    {
+                        fraction = true;
+                        ++p;
+                        continue;
+                    }
+
+                    if (!IsDigit(*p))
+                    {
+                        break;
+                    }
+
+                    const auto digit = static_cast<uint64_t>(*p - TCharType('0'));
+
+                    if (digits < 19)
+                    {
+                        if (mantissa != 0 || digit != 0)
+                        {
+                            mantissa = mantissa * 10 + digit;
+                            ++digits;
+                        }
+
+                        exponent -= fraction ? 1 : 0;
+                    }
+                    else
+                    {
+                        exponent += fraction ? 0 : 1;
+                        dropped |= digit != 0;
+                    }
+
+                    anyDigit = true;
+                    ++p;
+                }
+
+                if (!anyDigit)
+                {
+                    return nullptr;
+                }
+
+                // an exponent without digits is not part of the number
+                if (p != end && (*p == TCharType('e') || *p == TCharType('E')))
+                {
+                    const TCharType* q = p + 1;
+                    bool negativeExponent = false;
+
+                    if (q != end && (*q == TCharType('+') || *q == TCharType('-')))
+                    {
+                        negativeExponent = *q == TCharType('-');
+                        ++q;
+                    }
+
+                    if (q != end && IsDigit(*q))
+                    {
+                        int explicitExponent = 0;
+
+                        for (; q != end && IsDigit(*q); ++q)
+                        {
+                            if (explicitExponent < 100000)
+                            {
+                                explicitExponent = explicitExponent * 10 + static_cast<int>(*q - TCharType('0'));
+                            }
+                        }
+
+                        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+                        p = q;
+                    }
+                }
+
+                // Clinger's fast path: both the mantissa and the power of ten are exact doubles,
+                // so one correctly rounded multiplication or division gives the correctly rounded result
+                static const double S_Pow10[] =
+                {
+                    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+                };
+
+                if (mantissa == 0)
+                {
+                    value = negative ? -0.0 : 0.0;
+                }
+                else if (!dropped && mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22)
+                {
+                    value = static_cast<double>(mantissa);
+                    value = exponent < 0 ? value / S_Pow10[-exponent] : value * S_Pow10[exponent];
+                    value = negative ? -value : value;
+                }
+                else
+                {
+                    value = ParseSlow(str, p);
+                }
+
+                return p;
+            }
+
+        private:
+            static bool ParseEightDigits(const TCharType* p, const TCharType* end, uint64_t& value)
+            {
+#if CMT_NUMBER_PARSE_SWAR
+                if (sizeof(TCharType) == 1 && end - p >= 8)
+                {
+                    uint64_t word;
+                    memcpy(&word, p, sizeof(word));
+
+                    // every byte in '0'..'9'
+                    if ((((word & 0xF0F0F0F0F0F0F0F0ull) | (((word + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4))) != 0x3333333333333333ull)
+                    {
+                        return false;
+                    }
+
+                    // pairs, then quads, then the whole number, with the first digit in the lowest byte
+                    word -= 0x3030303030303030ull;
+                    word = word * 10 + (word >> 8);
+                    word = (((word & 0x000000FF000000FFull) * 0x000F424000000064ull) + (((word >> 16) & 0x000000FF000000FFull) * 0x0000271000000001ull)) >> 32;
+
+                    value = value * 100000000 + static_cast<uint32_t>(word);
+                    return true;
+                }
+#else
+                CMT_UNREFERENCED_PARAMETER(p);
+                CMT_UNREFERENCED_PARAMETER(end);
+                CMT_UNREFERENCED_PARAMETER(value);
+#endif
+                return false;
+            }
+
+            static bool MatchesIgnoreCase(const TCharType* p, const TCharType* end, const char* word)
+            {
+                for (; *word != 0; ++word, ++p)
+                {
+                    if (p == end || (*p | 0x20) != *word)
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            static const TCharType* ParseSpecial(const TCharType* p, const TCharType* end, double& value)
+            {
+                if (MatchesIgnoreCase(p, end, "infinity"))
+                {
+                    value = std::numeric_limits<double>::infinity();
+                    return p + 8;
+                }
+
+                if (MatchesIgnoreCase(p, end, "inf"))
+                {
+                    value = std::numeric_limits<double>::infinity();
+                    return p + 3;
+                }
+
+                if (MatchesIgnoreCase(p, end, "nan"))
+                {
+                    value = std::numeric_limits<double>::quiet_NaN();
+                    return p + 3;
+                }
+
+                return nullptr;
+            }
+
+            // hard cases go through strtod, with the '.' swapped for the decimal point of the current locale
+            static double ParseSlow(const TCharType* str, const TCharType* end)
+            {
+                const char decimalPoint = *localeconv()->decimal_point;
+                const auto length = static_cast<size_t>(end - str);
+
+                char local[128];
+                std::string heap;
+                char* text = local;
+
+                if (length >= sizeof(local))
+                {
+                    heap.resize(length + 1);
+                    text = &heap[0];
+                }
+
+                for (size_t i = 0; i < length; ++i)
+                {
+                    text[i] = str[i] == TCharType('.') ? decimalPoint : static_cast<char>(str[i]);
+                }
+
+                text[length] = 0;
+
+                return strtod(text, nullptr);
+            }
+        };
+
+        // the pointer and length level of the TCharTraits number functions,
+        // nothing is allocated and the decimal point is always '.'
+        template <typename TCharType>
+        struct TNumberConversion
+        {
+            typedef TNumberParser<TCharType> ParserType;
+
+            // characters ToChars needs at most
+            constexpr static size_t MaxIntegerLength = 20 + 1;
+            constexpr static size_t MaxFloatLength = TShortestFormatter::MaxLength;
+
+            // without parsedLength the whole string must be a number, with it the longest number
+            // at the start of the string is parsed and its length stored
+            template <typename TInteger>
+            static bool ParseInt(const TCharType* str, const size_t length, TInteger& value, size_t* parsedLength)
+            {
+                static_assert(std::is_integral<TInteger>::value && std::is_signed<TInteger>::value, "ParseInt needs a signed integer type, use ParseUInt");
+
+                const TCharType* p = str;
+                const TCharType* end = str + length;
+                bool negative = false;
+
+                if (p != end && (*p == TCharType('+') || *p == TCharType('-')))
+                {
+                    negative = *p == TCharType('-');
+                    ++p;
+                }
+
+                uint64_t magnitude = 0;
+                bool overflow = false;
+                p = ParserType::ParseUnsigned(p, end, magnitude, overflow);
+
+                const auto limit = static_cast<uint64_t>(std::numeric_limits<TInteger>::max()) + (negative ? 1 : 0);
+
+                if (!Accept(str, end, p, parsedLength) || overflow || magnitude > limit)
+                {
+                    return false;
+                }
+
+                // negated in unsigned arithmetic so the minimum does not overflow
+                value = negative ? static_cast<TInteger>(0 - magnitude) : static_cast<TInteger>(magnitude);
+                return true;
+            }
+
+            // a leading '+' is accepted, a '-' is not
+            template <typename TInteger>
+            static bool ParseUInt(const TCharType* str, const size_t length, TInteger& value, size_t* parsedLength)
+            {
+                static_assert(std::is_integral<TInteger>::value && std::is_unsigned<TInteger>::value, "ParseUInt needs an unsigned integer type, use ParseInt");
+
+                const TCharType* p = str;
+                const TCharType* end = str + length;
+
+                if (p != end && *p == TCharType('+'))
+                {
+                    ++p;
+                }
+
+                uint64_t result = 0;
+                bool overflow = false;
+                p = ParserType::ParseUnsigned(p, end, result, overflow);
+
+                if (!Accept(str, end, p, parsedLength) || overflow || result > std::numeric_limits<TInteger>::max())
+                {
+                    return false;
+                }
+
+                value = static_cast<TInteger>(result);
+                return true;
+            }
+
+            // decimal and scientific notation, inf and nan; out of range values become infinity or zero like strtod
+            static bool ParseDouble(const TCharType* str, const size_t length, double& value, size_t* parsedLength)
+            {
+                double result = 0;
+                const TCharType* p = ParserType::ParseDouble(str, str + length, result);
+
+                if (!Accept(str, str + length, p, parsedLength))
+                {
+                    return false;
+                }
+
+                value = result;
+                return true;
+            }
+
+            // the functions below write value without a terminating zero and return the end of the written characters,
+            // or nullptr when it does not fit in [first, last)
+            template <typename TInteger>
+            static TCharType* ToChars(TCharType* first, TCharType* last, const TInteger value)
+            {
+                static_assert(std::is_integral<TInteger>::value, "ToChars needs an integer or floating point type");
+
+                typedef TIntegerFormatter<TCharType> FormatterType;
+
+                TCharType buffer[FormatterType::MaxLength];
+                TCharType* const end = buffer + FormatterType::MaxLength;
+                const TCharType* begin = std::is_signed<TInteger>::value ?
+                    FormatterType::FormatSigned(end, static_cast<int64_t>(value)) :
+                    FormatterType::FormatUnsigned(end, static_cast<uint64_t>(value));
+
+                return Copy(first, last, begin, static_cast<size_t>(end - begin));
+            }
+
+            // the shortest digits that read back as value
+            static TCharType* ToChars(TCharType* first, TCharType* last, const double value)
+            {
+                char buffer[TShortestFormatter::MaxLength];
+
+                return Copy(first, last, buffer, TShortestFormatter::Format(value, buffer));
+            }
+
+            static TCharType* ToChars(TCharType* first, TCharType* last, const float value)
+            {
+                char buffer[TShortestFormatter::MaxLength];
+
+                return Copy(first, last, buffer, TShortestFormatter::Format(value, buffer));
+            }
+
+            // decimals digits after the point, at most TFixedFormatter::MaxDecimals
+            static TCharType* ToCharsFixed(TCharType* first, TCharType* last, const double value, const int decimals)
+            {
+                char buffer[TFixedFormatter::MaxLength];
+
+                return Copy(first, last, buffer, TFixedFormatter::Format(value, decimals, buffer));
+            }
+
+        private:
+            static bool Accept(const TCharType* str, const TCharType* end, const TCharType* parsed, size_t* parsedLength)
+            {
+                if (parsed == nullptr || (parsedLength == nullptr && parsed != end))
+                {
+                    return false;
+                }
+
+                if (parsedLength != nullptr)
+                {
+                    *parsedLength = static_cast<size_t>(parsed - str);
+                }
+
+                return true;
+            }
+
+            template <typename TSourceType>
+            static TCharType* Copy(TCharType* first, TCharType* last, const TSourceType* source, const size_t length)
+            {
+                if (static_cast<size_t>(last - first) < length)
+                {
+                    return nullptr;
+                }
+
+                for (size_t i = 0; i < length; ++i)
+                {
+                    first[i] = static_cast<TCharType>(source[i]);
+                }
+
+                return first + length;
+            }
+        };
+
+        template <typename TCharType>
+        constexpr size_t TNumberConversion<TCharType>::MaxIntegerLength;
+
+        template <typename TCharType>
+        constexpr size_t TNumberConversion<TCharType>::MaxFloatLength;
+
+        template <typename TCharType>
+        constexpr size_t TIntegerFormatter<TCharType>::MaxLength;
+    }
+}
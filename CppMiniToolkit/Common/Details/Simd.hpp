@@ -0,0 +1,231 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include <Common/BuildConfig.hpp>
+
+#if CMT_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+#if CMT_SIMD_SSSE3
+#include <tmmintrin.h>
+#endif
+
+#if CMT_SIMD_AVX2
+#include <immintrin.h>
+#endif
+
+#if CMT_COMPILER_MSVC
+#include <intrin.h>
+#endif
+
+namespace CppMiniToolkit
+{
+    namespace Details
+    {
+        // value must not be zero
+        inline uint32_t CountTrailingZeros32(const uint32_t value)
+        {
+#if CMT_COMPILER_MSVC
+            unsigned long index; // NOLINT
+            _BitScanForward(&index, value);
+            return static_cast<uint32_t>(index);
+#else
+            return static_cast<uint32_t>(__builtin_ctz(value));
+#endif
+        }
+
+        // value must not be zero
+        inline uint32_t CountTrailingZeros64(const uint64_t value)
+        {
+#if CMT_COMPILER_MSVC && CMT_PLATFORM_X64
+            unsigned long index; // NOLINT
+            _BitScanForward64(&index, value);
+            return static_cast<uint32_t>(index);
+#elif CMT_COMPILER_MSVC
+            const auto low = static_cast<uint32_t>(value);
+            return low != 0 ? CountTrailingZeros32(low) : 32 + CountTrailingZeros32(static_cast<uint32_t>(value >> 32));
+#else
+            return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+        }
+
+        // value must not be zero
+        inline uint32_t CountLeadingZeros32(const uint32_t value)
+        {
+#if CMT_COMPILER_MSVC
+            unsigned long index; // NOLINT
+            _BitScanReverse(&index, value);
+            return 31 - static_cast<uint32_t>(index);
+#else
+            return static_cast<uint32_t>(__builtin_clz(value));
+#endif
+        }
+
+        // value must not be zero
+        inline uint32_t CountLeadingZeros64(const uint64_t value)
+        {
+#if CMT_COMPILER_MSVC && CMT_PLATFORM_X64
+            unsigned long index; // NOLINT
+            _BitScanReverse64(&index, value);
+            return 63 - static_cast<uint32_t>(index);
+#elif CMT_COMPILER_MSVC
+            const auto high = static_cast<uint32_t>(value >> 32);
+            return high != 0 ? CountLeadingZeros32(high) : 32 + CountLeadingZeros32(static_cast<uint32_t>(value));
+#else
+            return static_cast<uint32_t>(__builtin_clzll(value));
+#endif
+        }
+
+        // 64 x 64 -> 128 bit multiplication, low half in first, high half in second
+        inline void Multiply128(uint64_t& first, uint64_t& second)
+        {
+#if defined(__SIZEOF_INT128__)
+            __uint128_t result = first;
+            result *= second;
+            first = static_cast<uint64_t>(result);
+            second = static_cast<uint64_t>(result >> 64);
+#elif CMT_COMPILER_MSVC && CMT_PLATFORM_X64
+            first = _umul128(first, second, &second);
+#else
+            const uint64_t firstHigh = first >> 32, firstLow = static_cast<uint32_t>(first);
+            const uint64_t secondHigh = second >> 32, secondLow = static_cast<uint32_t>(second);
+            const uint64_t high = firstHigh * secondHigh, middle0 = firstHigh * secondLow, middle1 = secondHigh * firstLow, low = firstLow * secondLow;
+            const uint64_t temp = low + (middle0 << 32);
+            uint64_t carry = temp < low;
+            const uint64_t resultLow = temp + (middle1 << 32);
+            carry += resultLow < temp;
+            first = resultLow;
+            second = high + (middle0 >> 32) + (middle1 >> 32) + carry;
+#endif
+        }
+
+        // lane helpers for character types of 1, 2 or 4 bytes
+        // movemask produces one bit per byte, LaneBits keeps the lowest bit of every lane
+        // CompareGreater is a signed comparison
+        template <size_t ElementSize>
+        struct TSimdLane;
+
+        template <>
+        struct TSimdLane<1>
+        {
+            static constexpr uint32_t LaneBits = 0xFFFFFFFFu;
+
+#if CMT_SIMD_SSE2
+            static __m128i Broadcast128(const uint32_t value)
+            {
+                return _mm_set1_epi8(static_cast<char>(value));
+            }
+
+            static __m128i CompareEqual128(const __m128i first, const __m128i second)
+            {
+                return _mm_cmpeq_epi8(first, second);
+            }
+
+            static __m128i CompareGreater128(const __m128i first, const __m128i second)
+            {
+                return _mm_cmpgt_epi8(first, second);
+            }
+#endif
+
+#if CMT_SIMD_AVX2
+            static __m256i Broadcast256(const uint32_t value)
+            {
+                return _mm256_set1_epi8(static_cast<char>(value));
+            }
+
+            static __m256i CompareEqual256(const __m256i first, const __m256i second)
+            {
+                return _mm256_cmpeq_epi8(first, second);
+            }
+
+            static __m256i CompareGreater256(const __m256i first, const __m256i second)
+            {
+                return _mm256_cmpgt_epi8(first, second);
+            }
+#endif
+        };
+
+        template <>
+        struct TSimdLane<2>
+        {
+            static constexpr uint32_t LaneBits = 0x55555555u;
+
+#if CMT_SIMD_SSE2
+            static __m128i Broadcast128(const uint32_t value)
+            {
+                return _mm_set1_epi16(static_cast<short>(value));
+            }
+
+            static __m128i CompareEqual128(const __m128i first, const __m128i second)
+            {
+                return _mm_cmpeq_epi16(first, second);
+            }
+
+            static __m128i CompareGreater128(const __m128i first, const __m128i second)
+            {
+                return _mm_cmpgt_epi16(first, second);
+            }
+#endif
+
+#if CMT_SIMD_AVX2
+            static __m256i Broadcast256(const uint32_t value)
+            {
+                return _mm256_set1_epi16(static_cast<short>(value));
+            }
+
+            static __m256i CompareEqual256(const __m256i first, const __m256i second)
+            {
+                return _mm256_cmpeq_epi16(first, second);
+            }
+
+            static __m256i CompareGreater256(const __m256i first, const __m256i second)
+            {
+                return _mm256_cmpgt_epi16(first, second);
+            }
+#endif
+        };
+
+        template <>
+        struct TSimdLane<4>
+        {
+            static constexpr uint32_t LaneBits = 0x11111111u;
+
+#if CMT_SIMD_SSE2
+            static __m128i Broadcast128(const uint32_t value)
+            {
+                return _mm_set1_epi32(static_cast<int>(value));
+            }
+
+            static __m128i CompareEqual128(const __m128i first, const __m128i second)
+            {
+                return _mm_cmpeq_epi32(first, second);
+            }
+
+            static __m128i CompareGreater128(const __m128i first, const __m128i second)
+            {
+                return _mm_cmpgt_epi32(first, second);
+            }
+#endif
+
+#if CMT_SIMD_AVX2
+            static __m256i Broadcast256(const uint32_t value)
+            {
+                return _mm256_set1_epi32(static_cast<int>(value));
+            }
+
+            static __m256i CompareEqual256(const __m256i first, const __m256i second)
+            {
+                return _mm256_cmpeq_epi32(first, second);
+            }
+
+            static __m256i CompareGreater256(const __m256i first, const __m256i second)
+            {
+                return _mm256_cmpgt_epi32(first, second);
+            }
+#endif
+        };
+    }
+}
@@ -0,0 +1,960 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <cwctype>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <Common/BuildConfig.hpp>
+#include <Common/Details/Simd.hpp>
+
+namespace CppMiniToolkit
+{
+    namespace Details
+    {
+        // case folding used by the ignore case searches
+        // ASCII letters are folded inline, wide characters outside of ASCII go through towlower
+        template <typename TCharType>
+        struct TCaseFolding;
+
+        template <>
+        struct TCaseFolding<char>
+        {
+            static char Fold(const char ch)
+            {
+                return ch >= 'A' && ch <= 'Z' ? static_cast<char>(ch | 0x20) : ch;
+            }
+        };
+
+        template <>
+        struct TCaseFolding<wchar_t>
+        {
+            static wchar_t Fold(const wchar_t ch)
+            {
+                if (ch >= L'A' && ch <= L'Z')
+                {
+                    return static_cast<wchar_t>(ch | 0x20);
+                }
+
+                return ch < 0x80 ? ch : static_cast<wchar_t>(towlower(static_cast<wint_t>(ch)));
+            }
+        };
+
+        template <typename TCharType, bool IgnoreCase>
+        struct TSearchPolicy;
+
+        template <typename TCharType>
+        struct TSearchPolicy<TCharType, false>
+        {
+            static TCharType Fold(const TCharType ch)
+            {
+                return ch;
+            }
+
+            // the first and the last characters are already known to be equal
+            static bool IsMatch(const TCharType* candidate, const TCharType* needle, const size_t needleLength, size_t& cost)
+            {
+                cost += needleLength;
+
+                return needleLength <= 2 || memcmp(candidate + 1, needle + 1, (needleLength - 2) * sizeof(TCharType)) == 0;
+            }
+
+#if CMT_SIMD_SSE2
+            static __m128i Fold128(const __m128i block)
+            {
+                return block;
+            }
+
+            static __m128i Escape128(const __m128i, const __m128i)
+            {
+                return _mm_setzero_si128();
+            }
+#endif
+
+#if CMT_SIMD_AVX2
+            static __m256i Fold256(const __m256i block)
+            {
+                return block;
+            }
+
+            static __m256i Escape256(const __m256i, const __m256i)
+            {
+                return _mm256_setzero_si256();
+            }
+#endif
+        };
+
+        template <typename TCharType>
+        struct TSearchPolicy<TCharType, true>
+        {
+            typedef TSimdLane<sizeof(TCharType)> LaneType;
+
+            static TCharType Fold(const TCharType ch)
+            {
+                return TCaseFolding<TCharType>::Fold(ch);
+            }
+
+            // escaped lanes arrive here without a folded comparison, so every character is checked
+            static bool IsMatch(const TCharType* candidate, const TCharType* needle, const size_t needleLength, size_t& cost)
+            {
+                for (size_t i = 0; i < needleLength; ++i)
+                {
+                    ++cost;
+
+                    if (Fold(candidate[i]) != Fold(needle[i]))
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+#if CMT_SIMD_SSE2
+            // lower ASCII letters, values outside of 'A'..'Z' are kept as they are
+            static __m128i Fold128(const __m128i block)
+            {
+                const __m128i upper = _mm_and_si128(
+                    LaneType::CompareGreater128(block, LaneType::Broadcast128('A' - 1)),
+                    LaneType::CompareGreater128(LaneType::Broadcast128('Z' + 1), block)
+                    );
+
+                return _mm_or_si128(block, _mm_and_si128(upper, LaneType::Broadcast128(0x20)));
+            }
+
+            // wide lanes outside of ASCII can't be folded here, they always become candidates
+            static __m128i Escape128(const __m128i first, const __m128i last)
+            {
+                if (sizeof(TCharType) == 1)
+                {
+                    return _mm_setzero_si128();
+                }
+
+                const __m128i highBits = _mm_and_si128(_mm_or_si128(first, last), LaneType::Broadcast128(~0x7Fu));
+
+                return _mm_andnot_si128(LaneType::CompareEqual128(highBits, _mm_setzero_si128()), _mm_set1_epi32(-1));
+            }
+#endif
+
+#if CMT_SIMD_AVX2
+            static __m256i Fold256(const __m256i block)
+            {
+                const __m256i upper = _mm256_and_si256(
+                    LaneType::CompareGreater256(block, LaneType::Broadcast256('A' - 1)),
+                    LaneType::CompareGreater256(LaneType::Broadcast256('Z' + 1), block)
+                    );
+
+                return _mm256_or_si256(block, _mm256_and_si256(upper, LaneType::Broadcast256(0x20)));
+            }
+
+            static __m256i Escape256(const __m256i first, const __m256i last)
+            {
+                if (sizeof(TCharType) == 1)
+                {
+                    return _mm256_setzero_si256();
+                }
+
+                const __m256i highBits = _mm256_and_si256(_mm256_or_si256(first, last), LaneType::Broadcast256(~0x7Fu));
+
+                return _mm256_andnot_si256(LaneType::CompareEqual256(highBits, _mm256_setzero_si256()), _mm256_set1_epi32(-1));
+            }
+#endif
+        };
+
+        // substring search kernels working on explicit lengths
+        // SIMD paths filter candidates by comparing the first and the last character of the needle
+        // against a whole block of positions at once, only the survivors are verified.
+        // if verification work grows beyond the haystack size (adversarial input), the search
+        // continues with a linear time KMP scan, so the worst case stays O(n + m)
+        template <typename TCharType>
+        class TStringSearchKernels
+        {
+        public:
+            CMT_DECLARE_TOOLKIT_CLASS_TYPE(TStringSearchKernels);
+
+            typedef std::char_traits<TCharType>   TraitsType;
+            typedef TSimdLane<sizeof(TCharType)>  LaneType;
+
+            // find the first occurrence of needle in haystack, returns nullptr if not found
+            static const TCharType* Find(const TCharType* haystack, const size_t haystackLength, const TCharType* needle, const size_t needleLength)
+            {
+                return FindCore<false>(haystack, haystackLength, needle, needleLength);
+            }
+
+            // find the first occurrence of needle in haystack, ignore case
+            // char folds ASCII letters only, wchar_t also folds other characters with towlower
+            static const TCharType* iFind(const TCharType* haystack, const size_t haystackLength, const TCharType* needle, const size_t needleLength)
+            {
+                return FindCore<true>(haystack, haystackLength, needle, needleLength);
+            }
+
+            // calls onMatch(offset) for every occurrence of needle from left to right in a single scan
+            // and returns how many there were. without overlapping the scan resumes after each match,
+            // so "aaaa" contains "aa" twice, with overlapping three times. an empty needle never matches
+            template <typename TCallback>
+            static size_t FindAll(const TCharType* haystack, const size_t haystackLength, const TCharType* needle, const size_t needleLength, const bool overlapping, TCallback& onMatch)
+            {
+                return FindAllCore<false>(haystack, haystackLength, needle, needleLength, overlapping, onMatch);
+            }
+
+            template <typename TCallback>
+            static size_t iFindAll(const TCharType* haystack, const size_t haystackLength, const TCharType* needle, const size_t needleLength, const bool overlapping, TCallback& onMatch)
+            {
+                return FindAllCore<true>(haystack, haystackLength, needle, needleLength, overlapping, onMatch);
+            }
+
+            // the non overlapping occurrences of needle one call at a time, for callers that stop between them
+            class TSearchCursor;
+
+            // find the last occurrence of ch, scanning backwards from the end
+            static const TCharType* rFind(const TCharType* haystack, const size_t haystackLength, const TCharType ch)
+            {
+                return FindLastOf<true>(haystack, haystackLength, &ch, 1);
+            }
+
+            // find the last occurrence of needle, an empty needle matches at the end of haystack
+            // candidates are filtered from the end backwards like Find does forwards, adversarial input
+            // continues with KMP over the reversed strings, so the search stays O(n + m)
+            static const TCharType* rFind(const TCharType* haystack, const size_t haystackLength, const TCharType* needle, const size_t needleLength)
+            {
+                if (needleLength == 0)
+                {
+                    return haystack + haystackLength;
+                }
+
+                if (needleLength > haystackLength)
+                {
+                    return nullptr;
+                }
+
+                if (needleLength == 1)
+                {
+                    return rFind(haystack, haystackLength, needle[0]);
+                }
+
+                return FindLastCore(haystack, haystackLength, needle, needleLength);
+            }
+
+            // the last character of haystack that is one of targets
+            static const TCharType* rFindAny(const TCharType* haystack, const size_t haystackLength, const TCharType* targets, const size_t targetsLength)
+            {
+                return FindLastOf<true>(haystack, haystackLength, targets, targetsLength);
+            }
+
+            // the last character of haystack that is none of targets
+            static const TCharType* rFindNotOfAny(const TCharType* haystack, const size_t haystackLength, const TCharType* targets, const size_t targetsLength)
+            {
+                return FindLastOf<false>(haystack, haystackLength, targets, targetsLength);
+            }
+
+        private:
+            struct SearchState
+            {
+                const TCharType*  Haystack;
+                const TCharType*  Needle;
+                size_t            NeedleLength;
+                // the last position a match can start at
+                size_t            LastStart;
+                size_t            Position;
+                // matches starting before this are not reported
+                size_t            NextStart;
+                size_t            Cost;
+                size_t            Budget;
+
+                bool IsExhausted() const
+                {
+                    return Cost > Budget;
+                }
+            };
+
+            template <bool IgnoreCase>
+            static const TCharType* FindCore(const TCharType* haystack, const size_t haystackLength, const TCharType* needle, const size_t needleLength)
+            {
+                if (needleLength == 0)
+                {
+                    return haystack;
+                }
+
+                if (needleLength > haystackLength)
+                {
+                    return nullptr;
+                }
+
+                if (!IgnoreCase && needleLength == 1)
+                {
+                    return TraitsType::find(haystack, haystackLength, needle[0]);
+                }
+
+                SearchState state = MakeState(haystack, haystackLength, needle, needleLength);
+                TFirstMatch visitor;
+
+                return Search<IgnoreCase>(state, visitor);
+            }
+
+            template <bool IgnoreCase, typename TCallback>
+            static size_t FindAllCore(const TCharType* haystack, const size_t haystackLength, const TCharType* needle, const size_t needleLength, const bool overlapping, TCallback& onMatch)
+            {
+                if (needleLength == 0 || needleLength > haystackLength)
+                {
+                    return 0;
+                }
+
+                SearchState state = MakeState(haystack, haystackLength, needle, needleLength);
+                TEveryMatch<TCallback> visitor = { onMatch, overlapping ? 1 : needleLength, 0 };
+
+                Search<IgnoreCase>(state, visitor);
+
+                return visitor.Count;
+            }
+
+            static SearchState MakeState(const TCharType* haystack, const size_t haystackLength, const TCharType* needle, const size_t needleLength)
+            {
+                SearchState state = { haystack, needle, needleLength, haystackLength - needleLength, 0, 0, 0, haystackLength * 2 + 1024 };
+                return state;
+            }
+
+            // visitors get every verified match and return true to stop the search there
+            struct TFirstMatch
+            {
+                bool operator ()(SearchState&, const TCharType*) const
+                {
+                    return true;
+                }
+            };
+
+            // stops at every match, the search goes on behind it on the next call
+            struct TNextMatch
+            {
+                bool operator ()(SearchState& state, const TCharType* match) const
+                {
+                    state.NextStart = static_cast<size_t>(match - state.Haystack) + state.NeedleLength;
+
+                    return true;
+                }
+            };
+
+            template <typename TCallback>
+            struct TEveryMatch
+            {
+                TCallback&  OnMatch;
+                size_t      Step;
+                size_t      Count;
+
+                bool operator ()(SearchState& state, const TCharType* match)
+                {
+                    const auto offset = static_cast<size_t>(match - state.Haystack);
+
+                    OnMatch(offset);
+                    ++Count;
+                    state.NextStart = offset + Step;
+
+                    return false;
+                }
+            };
+
+            template <bool IgnoreCase, typename TVisitor>
+            static const TCharType* Search(SearchState& state, TVisitor& visitor)
+            {
+                const TCharType* result = nullptr;
+
+                // a resumed search goes on behind the last match, with the filter or the linear scan it was using
+                if (state.Position < state.NextStart)
+                {
+                    state.Position = state.NextStart;
+                }
+
+                if (state.IsExhausted())
+                {
+                    return FindLinear<IgnoreCase>(state, visitor);
+                }
+
+#if CMT_SIMD_AVX2
+                if ((result = FindAvx2<IgnoreCase>(state, visitor)) != nullptr)
+                {
+                    return result;
+                }
+
+                if (state.IsExhausted())
+                {
+                    return FindLinear<IgnoreCase>(state, visitor);
+                }
+#endif
+
+#if CMT_SIMD_SSE2
+                if ((result = FindSse2<IgnoreCase>(state, visitor)) != nullptr)
+                {
+                    return result;
+                }
+
+                if (state.IsExhausted())
+                {
+                    return FindLinear<IgnoreCase>(state, visitor);
+                }
+#endif
+
+                if ((result = FindScalar<IgnoreCase>(state, visitor)) != nullptr)
+                {
+                    return result;
+                }
+
+                return state.IsExhausted() ? FindLinear<IgnoreCase>(state, visitor) : nullptr;
+            }
+
+            template <bool IgnoreCase, typename TVisitor>
+            static const TCharType* FindScalar(SearchState& state, TVisitor& visitor)
+            {
+                typedef TSearchPolicy<TCharType, IgnoreCase> PolicyType;
+
+                const TCharType first = PolicyType::Fold(state.Needle[0]);
+                const TCharType last = PolicyType::Fold(state.Needle[state.NeedleLength - 1]);
+
+                for (;;)
+                {
+                    if (state.Position < state.NextStart)
+                    {
+                        state.Position = state.NextStart;
+                    }
+
+                    if (state.Position > state.LastStart)
+                    {
+                        return nullptr;
+                    }
+
+                    const TCharType* candidate = state.Haystack + state.Position;
+
+                    if (!IgnoreCase)
+                    {
+                        candidate = TraitsType::find(candidate, state.LastStart - state.Position + 1, state.Needle[0]);
+
+                        if (candidate == nullptr)
+                        {
+                            return nullptr;
+                        }
+                    }
+
+                    state.Position = static_cast<size_t>(candidate - state.Haystack) + 1;
+
+                    if (PolicyType::Fold(candidate[state.NeedleLength - 1]) == last &&
+                        PolicyType::Fold(candidate[0]) == first &&
+                        PolicyType::IsMatch(candidate, state.Needle, state.NeedleLength, state.Cost) &&
+                        visitor(state, candidate))
+                    {
+                        return candidate;
+                    }
+
+                    if (state.IsExhausted())
+                    {
+                        return nullptr;
+                    }
+                }
+            }
+
+#if CMT_SIMD_SSE2
+            template <bool IgnoreCase, typename TVisitor>
+            static const TCharType* FindSse2(SearchState& state, TVisitor& visitor)
+            {
+                typedef TSearchPolicy<TCharType, IgnoreCase> PolicyType;
+
+                constexpr size_t LaneCount = sizeof(__m128i) / sizeof(TCharType);
+
+                const __m128i first = LaneType::Broadcast128(static_cast<uint32_t>(PolicyType::Fold(state.Needle[0])));
+                const __m128i last = LaneType::Broadcast128(static_cast<uint32_t>(PolicyType::Fold(state.Needle[state.NeedleLength - 1])));
+
+                for (; state.Position + LaneCount - 1 <= state.LastStart; state.Position += LaneCount)
+                {
+                    const TCharType* block = state.Haystack + state.Position;
+                    const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+                    const __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + state.NeedleLength - 1));
+                    const __m128i equal = _mm_or_si128(
+                        _mm_and_si128(
+                            LaneType::CompareEqual128(first, PolicyType::Fold128(blockFirst)),
+                            LaneType::CompareEqual128(last, PolicyType::Fold128(blockLast))
+                        ),
+                        PolicyType::Escape128(blockFirst, blockLast)
+                    );
+
+                    uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(equal)) & LaneType::LaneBits;
+
+                    while (mask != 0)
+                    {
+                        const TCharType* candidate = block + CountTrailingZeros32(mask) / sizeof(TCharType);
+
+                        if (candidate >= state.Haystack + state.NextStart &&
+                            PolicyType::IsMatch(candidate, state.Needle, state.NeedleLength, state.Cost) &&
+                            visitor(state, candidate))
+                        {
+                            return candidate;
+                        }
+
+                        if (state.IsExhausted())
+                        {
+                            state.Position = static_cast<size_t>(candidate - state.Haystack) + 1;
+                            return nullptr;
+                        }
+
+                        mask &= mask - 1;
+                    }
+                }
+
+                return nullptr;
+            }
+#endif
+
+#if CMT_SIMD_AVX2
+            template <bool IgnoreCase, typename TVisitor>
+            static const TCharType* FindAvx2(SearchState& state, TVisitor& visitor)
+            {
+                typedef TSearchPolicy<TCharType, IgnoreCase> PolicyType;
+
+                constexpr size_t LaneCount = sizeof(__m256i) / sizeof(TCharType);
+
+                const __m256i first = LaneType::Broadcast256(static_cast<uint32_t>(PolicyType::Fold(state.Needle[0])));
+                const __m256i last = LaneType::Broadcast256(static_cast<uint32_t>(PolicyType::Fold(state.Needle[state.NeedleLength - 1])));
+
+                for (; state.Position + LaneCount - 1 <= state.LastStart; state.Position += LaneCount)
+                {
+                    const TCharType* block = state.Haystack + state.Position;
+                    const __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+                    const __m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + state.NeedleLength - 1));
+                    const __m256i equal = _mm256_or_si256(
+                        _mm256_and_si256(
+                            LaneType::CompareEqual256(first, PolicyType::Fold256(blockFirst)),
+                            LaneType::CompareEqual256(last, PolicyType::Fold256(blockLast))
+                        ),
+                        PolicyType::Escape256(blockFirst, blockLast)
+                    );
+
+                    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(equal)) & LaneType::LaneBits;
+
+                    while (mask != 0)
+                    {
+                        const TCharType* candidate = block + CountTrailingZeros32(mask) / sizeof(TCharType);
+
+                        if (candidate >= state.Haystack + state.NextStart &&
+                            PolicyType::IsMatch(candidate, state.Needle, state.NeedleLength, state.Cost) &&
+                            visitor(state, candidate))
+                        {
+                            return candidate;
+                        }
+
+                        if (state.IsExhausted())
+                        {
+                            state.Position = static_cast<size_t>(candidate - state.Haystack) + 1;
+                            return nullptr;
+                        }
+
+                        mask &= mask - 1;
+                    }
+                }
+
+                return nullptr;
+            }
+#endif
+
+            // Knuth-Morris-Pratt over folded characters, used once the filtered search stops paying off
+            template <bool IgnoreCase, typename TVisitor>
+            static const TCharType* FindLinear(SearchState& state, TVisitor& visitor)
+            {
+                typedef TSearchPolicy<TCharType, IgnoreCase> PolicyType;
+
+                const TCharType* needle = state.Needle;
+                const size_t needleLength = state.NeedleLength;
+
+                std::vector<size_t> failure(needleLength, 0);
+
+                for (size_t i = 1, k = 0; i < needleLength; ++i)
+                {
+                    const TCharType ch = PolicyType::Fold(needle[i]);
+
+                    while (k > 0 && ch != PolicyType::Fold(needle[k]))
+                    {
+                        k = failure[k - 1];
+                    }
+
+                    if (ch == PolicyType::Fold(needle[k]))
+                    {
+                        ++k;
+                    }
+
+                    failure[i] = k;
+                }
+
+                const size_t haystackLength = state.LastStart + needleLength;
+
+                const size_t start = state.Position > state.NextStart ? state.Position : state.NextStart;
+
+                for (size_t i = start, k = 0; i < haystackLength; ++i)
+                {
+                    const TCharType ch = PolicyType::Fold(state.Haystack[i]);
+
+                    while (k > 0 && ch != PolicyType::Fold(needle[k]))
+                    {
+                        k = failure[k - 1];
+                    }
+
+                    if (ch == PolicyType::Fold(needle[k]))
+                    {
+                        ++k;
+                    }
+
+                    if (k == needleLength)
+                    {
+                        const TCharType* match = state.Haystack + i + 1 - needleLength;
+
+                        if (visitor(state, match))
+                        {
+                            return match;
+                        }
+
+                        // an overlapping match may share a border with this one
+                        k = state.NextStart > static_cast<size_t>(match - state.Haystack) + 1 ? 0 : failure[k - 1];
+                    }
+                }
+
+                return nullptr;
+            }
+
+            // sets up to this size are compared lane by lane, larger ones are looked up per character
+            constexpr static size_t MaxSimdTargets = 8;
+
+            // membership of a character set: a bitmap for code units below 256, the list for the others
+            struct TTargetSet
+            {
+                uint64_t            Bits[4];
+                const TCharType*    Targets;
+                size_t              TargetsLength;
+
+                TTargetSet(const TCharType* targets, const size_t targetsLength) :
+                    Bits(),
+                    Targets(targets),
+                    TargetsLength(targetsLength)
+                {
+                    for (size_t i = 0; i < targetsLength; ++i)
+                    {
+                        const auto value = ToUnsigned(targets[i]);
+
+                        if (value < 256)
+                        {
+                            Bits[value >> 6] |= static_cast<uint64_t>(1) << (value & 63);
+                        }
+                    }
+                }
+
+                bool Contains(const TCharType ch) const
+                {
+                    const auto value = ToUnsigned(ch);
+
+                    if (value < 256)
+                    {
+                        return (Bits[value >> 6] >> (value & 63) & 1) != 0;
+                    }
+
+                    return TraitsType::find(Targets, TargetsLength, ch) != nullptr;
+                }
+            };
+
+            static uint32_t ToUnsigned(const TCharType ch)
+            {
+                return static_cast<uint32_t>(static_cast<typename std::make_unsigned<TCharType>::type>(ch));
+            }
+
+            template <bool Member>
+            static const TCharType* FindLastOf(const TCharType* haystack, const size_t haystackLength, const TCharType* targets, const size_t targetsLength)
+            {
+                size_t end = haystackLength;
+
+                if (targetsLength <= MaxSimdTargets)
+                {
+#if CMT_SIMD_AVX2
+                    constexpr size_t LaneCount256 = sizeof(__m256i) / sizeof(TCharType);
+
+                    __m256i targets256[MaxSimdTargets];
+
+                    for (size_t i = 0; i < targetsLength; ++i)
+                    {
+                        targets256[i] = LaneType::Broadcast256(ToUnsigned(targets[i]));
+                    }
+
+                    for (; end >= LaneCount256; end -= LaneCount256)
+                    {
+                        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + end - LaneCount256));
+                        __m256i equal = _mm256_setzero_si256();
+
+                        for (size_t i = 0; i < targetsLength; ++i)
+                        {
+                            equal = _mm256_or_si256(equal, LaneType::CompareEqual256(block, targets256[i]));
+                        }
+
+                        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(equal));
+                        mask = (Member ? mask : ~mask) & LaneType::LaneBits;
+
+                        if (mask != 0)
+                        {
+                            return haystack + end - LaneCount256 + (31 - CountLeadingZeros32(mask)) / sizeof(TCharType);
+                        }
+                    }
+#endif
+
+#if CMT_SIMD_SSE2
+                    constexpr size_t LaneCount128 = sizeof(__m128i) / sizeof(TCharType);
+
+                    __m128i targets128[MaxSimdTargets];
+
+                    for (size_t i = 0; i < targetsLength; ++i)
+                    {
+                        targets128[i] = LaneType::Broadcast128(ToUnsigned(targets[i]));
+                    }
+
+                    for (; end >= LaneCount128; end -= LaneCount128)
+                    {
+                        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + end - LaneCount128));
+                        __m128i equal = _mm_setzero_si128();
+
+                        for (size_t i = 0; i < targetsLength; ++i)
+                        {
+                            equal = _mm_or_si128(equal, LaneType::CompareEqual128(block, targets128[i]));
+                        }
+
+                        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(equal));
+                        mask = (Member ? mask : ~mask) & LaneType::LaneBits & 0xFFFFu;
+
+                        if (mask != 0)
+                        {
+                            return haystack + end - LaneCount128 + (31 - CountLeadingZeros32(mask)) / sizeof(TCharType);
+                        }
+                    }
+#endif
+                }
+
+                const TTargetSet set(targets, targetsLength);
+
+                while (end > 0)
+                {
+                    --end;
+
+                    if (set.Contains(haystack[end]) == Member)
+                    {
+                        return haystack + end;
+                    }
+                }
+
+                return nullptr;
+            }
+
+            // candidates are visited from the last possible start backwards, the first verified one is the result
+            static const TCharType* FindLastCore(const TCharType* haystack, const size_t haystackLength, const TCharType* needle, const size_t needleLength)
+            {
+                typedef TSearchPolicy<TCharType, false> PolicyType;
+
+                // candidates starting before end are left to check
+                size_t end = haystackLength - needleLength + 1;
+                size_t cost = 0;
+                const size_t budget = haystackLength * 2 + 1024;
+
+#if CMT_SIMD_AVX2
+                {
+                    constexpr size_t LaneCount = sizeof(__m256i) / sizeof(TCharType);
+
+                    const __m256i first = LaneType::Broadcast256(ToUnsigned(needle[0]));
+                    const __m256i last = LaneType::Broadcast256(ToUnsigned(needle[needleLength - 1]));
+
+                    for (; end >= LaneCount && cost <= budget; end -= LaneCount)
+                    {
+                        const TCharType* block = haystack + end - LaneCount;
+                        const __m256i equal = _mm256_and_si256(
+                            LaneType::CompareEqual256(first, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block))),
+                            LaneType::CompareEqual256(last, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + needleLength - 1)))
+                        );
+
+                        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(equal)) & LaneType::LaneBits;
+
+                        while (mask != 0)
+                        {
+                            const uint32_t bit = 31 - CountLeadingZeros32(mask);
+                            const TCharType* candidate = block + bit / sizeof(TCharType);
+
+                            if (PolicyType::IsMatch(candidate, needle, needleLength, cost))
+                            {
+                                return candidate;
+                            }
+
+                            if (cost > budget)
+                            {
+                                end = static_cast<size_t>(candidate - haystack) + LaneCount;
+                                break;
+                            }
+
+                            mask &= ~(static_cast<uint32_t>(1) << bit);
+                        }
+                    }
+                }
+#endif
+
+#if CMT_SIMD_SSE2
+                {
+                    constexpr size_t LaneCount = sizeof(__m128i) / sizeof(TCharType);
+
+                    const __m128i first = LaneType::Broadcast128(ToUnsigned(needle[0]));
+                    const __m128i last = LaneType::Broadcast128(ToUnsigned(needle[needleLength - 1]));
+
+                    for (; end >= LaneCount && cost <= budget; end -= LaneCount)
+                    {
+                        const TCharType* block = haystack + end - LaneCount;
+                        const __m128i equal = _mm_and_si128(
+                            LaneType::CompareEqual128(first, _mm_loadu_si128(reinterpret_cast<const __m128i*>(block))),
+                            LaneType::CompareEqual128(last, _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + needleLength - 1)))
+                        );
+
+                        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(equal)) & LaneType::LaneBits;
+
+                        while (mask != 0)
+                        {
+                            const uint32_t bit = 31 - CountLeadingZeros32(mask);
+                            const TCharType* candidate = block + bit / sizeof(TCharType);
+
+                            if (PolicyType::IsMatch(candidate, needle, needleLength, cost))
+                            {
+                                return candidate;
+                            }
+
+                            if (cost > budget)
+                            {
+                                end = static_cast<size_t>(candidate - haystack) + LaneCount;
+                                break;
+                            }
+
+                            mask &= ~(static_cast<uint32_t>(1) << bit);
+                        }
+                    }
+                }
+#endif
+
+                for (; end > 0 && cost <= budget; --end)
+                {
+                    const TCharType* candidate = haystack + end - 1;
+
+                    if (candidate[0] == needle[0] &&
+                        candidate[needleLength - 1] == needle[needleLength - 1] &&
+                        PolicyType::IsMatch(candidate, needle, needleLength, cost))
+                    {
+                        return candidate;
+                    }
+                }
+
+                return end > 0 ? FindLastLinear(haystack, end, needle, needleLength) : nullptr;
+            }
+
+            // Knuth-Morris-Pratt from right to left, for the candidates starting before end
+            static const TCharType* FindLastLinear(const TCharType* haystack, const size_t end, const TCharType* needle, const size_t needleLength)
+            {
+                // failure function of the reversed needle
+                const auto reversed = [needle, needleLength](const size_t index) { return needle[needleLength - 1 - index]; };
+
+                std::vector<size_t> failure(needleLength, 0);
+
+                for (size_t i = 1, k = 0; i < needleLength; ++i)
+                {
+                    while (k > 0 && reversed(i) != reversed(k))
+                    {
+                        k = failure[k - 1];
+                    }
+
+                    if (reversed(i) == reversed(k))
+                    {
+                        ++k;
+                    }
+
+                    failure[i] = k;
+                }
+
+                for (size_t i = end + needleLength - 1, k = 0; i > 0; )
+                {
+                    const TCharType ch = haystack[--i];
+
+                    while (k > 0 && ch != reversed(k))
+                    {
+                        k = failure[k - 1];
+                    }
+
+                    if (ch == reversed(k))
+                    {
+                        ++k;
+                    }
+
+                    if (k == needleLength)
+                    {
+                        return haystack + i;
+                    }
+                }
+
+                return nullptr;
+            }
+        };
+
+        // the search state lives from one call to the next, so the comparison budget and the switch to
+        // the linear scan cover all occurrences together, and walking them costs what one FindAll does
+        template <typename TCharType>
+        class TStringSearchKernels<TCharType>::TSearchCursor
+        {
+        public:
+            TSearchCursor() :
+                State(),
+                Finished(true)
+            {
+            }
+
+            TSearchCursor(const TCharType* haystack, const size_t haystackLength, const TCharType* needle, const size_t needleLength) :
+                State(),
+                Finished(needleLength == 0 || needleLength > haystackLength)
+            {
+                if (!Finished)
+                {
+                    State = MakeState(haystack, haystackLength, needle, needleLength);
+                }
+            }
+
+            // the next occurrence starting at or after start, nullptr when there is none.
+            // start must not go back before the end of the previous occurrence
+            const TCharType* Next(const size_t start)
+            {
+                return NextCore<false>(start);
+            }
+
+            const TCharType* iNext(const size_t start)
+            {
+                return NextCore<true>(start);
+            }
+
+        private:
+            template <bool IgnoreCase>
+            const TCharType* NextCore(const size_t start)
+            {
+                if (Finished)
+                {
+                    return nullptr;
+                }
+
+                if (State.NextStart < start)
+                {
+                    State.NextStart = start;
+                }
+
+                TNextMatch visitor;
+                const TCharType* result = Search<IgnoreCase>(State, visitor);
+
+                Finished = result == nullptr;
+
+                return result;
+            }
+
+        private:
+            SearchState     State;
+            bool            Finished;
+        };
+
+        template <typename TCharType>
+        constexpr size_t TStringSearchKernels<TCharType>::MaxSimdTargets;
+    }
+}
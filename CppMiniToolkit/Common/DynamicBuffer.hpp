@@ -316,6 +316,18 @@ namespace CppMiniToolkit
                 Buffer = buf;
             }
         }
+
+        // keeps the content, added bytes are not initialized
+        void Resize(const SizeType size)
+        {
+            if (size > AllocatedSize)
+            {
+                Reserve(size > AllocatedSize * 2 ? size : AllocatedSize * 2);
+            }
+
+            Size = size;
+        }
+
     private:
         void Release()
         {
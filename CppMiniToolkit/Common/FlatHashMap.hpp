@@ -0,0 +1,807 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cassert>
+#include <new>
+#include <utility>
+#include <iterator>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <initializer_list>
+
+#include <Common/BuildConfig.hpp>
+#include <Common/Hash.hpp>
+#include <Common/Details/Simd.hpp>
+
+namespace CppMiniToolkit
+{
+    namespace Details
+    {
+        // string keys hash with THash and compare through TStringRef, so they can be looked up by
+        // TStringRef, std::basic_string or zero terminated strings without building a key
+        template <typename TKey>
+        struct TFlatHashDefaults
+        {
+            typedef std::hash<TKey>         HasherType;
+            typedef std::equal_to<TKey>     EqualType;
+        };
+
+        template <typename TCharType>
+        struct TFlatHashDefaults<std::basic_string<TCharType>>
+        {
+            typedef THash<TCharType>        HasherType;
+            typedef TEqual<TCharType>       EqualType;
+        };
+
+        // control bytes: empty and deleted slots are negative, a full slot stores 7 bits of its hash
+        // lookups check a group of 16 control bytes at once
+        struct TFlatHashGroup
+        {
+            constexpr static size_t Width = 16;
+            constexpr static int8_t Empty = -128;
+            constexpr static int8_t Deleted = -2;
+
+            // bit i is set when control[i] == value
+            static uint32_t Match(const int8_t* control, const int8_t value)
+            {
+#if CMT_SIMD_SSE2
+                const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+                return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(value))));
+#else
+                uint32_t mask = 0;
+
+                for (size_t i = 0; i < Width; ++i)
+                {
+                    mask |= static_cast<uint32_t>(control[i] == value) << i;
+                }
+
+                return mask;
+#endif
+            }
+
+            static uint32_t MatchEmpty(const int8_t* control)
+            {
+                return Match(control, Empty);
+            }
+
+            static uint32_t MatchEmptyOrDeleted(const int8_t* control)
+            {
+#if CMT_SIMD_SSE2
+                const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+                return static_cast<uint32_t>(_mm_movemask_epi8(group));
+#else
+                uint32_t mask = 0;
+
+                for (size_t i = 0; i < Width; ++i)
+                {
+                    mask |= static_cast<uint32_t>(control[i] < 0) << i;
+                }
+
+                return mask;
+#endif
+            }
+        };
+
+        // slot access of the table: the key of a slot, and moving a slot to new storage when rehashing
+        // (keys are const inside the table, they are moved out right before the old slot is destroyed)
+        template <typename TKey>
+        struct TFlatHashSetPolicy
+        {
+            static const TKey& GetKey(const TKey& slot)
+            {
+                return slot;
+            }
+
+            static void Relocate(void* destination, const TKey& slot)
+            {
+                new (destination) TKey(std::move(const_cast<TKey&>(slot)));
+            }
+        };
+
+        template <typename TKey, typename TValue>
+        struct TFlatHashMapPolicy
+        {
+            static const TKey& GetKey(const std::pair<const TKey, TValue>& slot)
+            {
+                return slot.first;
+            }
+
+            static void Relocate(void* destination, std::pair<const TKey, TValue>& slot)
+            {
+                new (destination) std::pair<const TKey, TValue>(std::move(const_cast<TKey&>(slot.first)), std::move(slot.second));
+            }
+        };
+
+        // the open addressing table behind TFlatHashMap and TFlatHashSet
+        // the capacity is a power of two and a multiple of the group width, groups are probed
+        // triangularly and the table grows when 7/8 of the slots are full or deleted
+        template <typename TKey, typename TSlot, typename TPolicy, typename THasher, typename TEqual>
+        class TFlatHashTable
+        {
+        public:
+            typedef TKey            KeyType;
+            typedef TSlot           ValueType;
+            typedef size_t          SizeType;
+            typedef THasher         HasherType;
+            typedef TEqual          EqualType;
+
+            template <bool IsConst>
+            class TIterator
+            {
+            public:
+                typedef std::forward_iterator_tag                                               iterator_category;
+                typedef TSlot                                                                   value_type;
+                typedef std::ptrdiff_t                                                          difference_type;
+                typedef typename std::conditional<IsConst, const TSlot*, TSlot*>::type          pointer;
+                typedef typename std::conditional<IsConst, const TSlot&, TSlot&>::type          reference;
+
+                TIterator() :
+                    Control(nullptr),
+                    Slot(nullptr),
+                    End(nullptr)
+                {
+                }
+
+                // iterator to const iterator
+                template <bool OtherConst, typename = typename std::enable_if<IsConst && !OtherConst>::type>
+                TIterator(const TIterator<OtherConst>& other) : // NOLINT(google-explicit-constructor)
+                    Control(other.Control),
+                    Slot(other.Slot),
+                    End(other.End)
+                {
+                }
+
+                reference operator *() const
+                {
+                    return *Slot;
+                }
+
+                pointer operator ->() const
+                {
+                    return Slot;
+                }
+
+                TIterator& operator ++()
+                {
+                    ++Control;
+                    ++Slot;
+                    SkipFree();
+                    return *this;
+                }
+
+                TIterator operator ++(int)
+                {
+                    TIterator result = *this;
+                    ++*this;
+                    return result;
+                }
+
+                bool operator == (const TIterator& other) const
+                {
+                    return Slot == other.Slot;
+                }
+
+                bool operator != (const TIterator& other) const
+                {
+                    return Slot != other.Slot;
+                }
+
+            private:
+                friend class TFlatHashTable;
+                template <bool> friend class TIterator;
+
+                TIterator(const int8_t* control, pointer slot, const int8_t* end) :
+                    Control(control),
+                    Slot(slot),
+                    End(end)
+                {
+                }
+
+                void SkipFree()
+                {
+                    while (Control != End && *Control < 0)
+                    {
+                        ++Control;
+                        ++Slot;
+                    }
+                }
+
+            private:
+                const int8_t*   Control;
+                pointer         Slot;
+                const int8_t*   End;
+            };
+
+            typedef TIterator<false>    Iterator;
+            typedef TIterator<true>     ConstIterator;
+
+            explicit TFlatHashTable(const HasherType& hasher = HasherType(), const EqualType& equal = EqualType()) :
+                Control(nullptr),
+                Slots(nullptr),
+                Capacity(0),
+                Size(0),
+                GrowthLeft(0),
+                Hasher(hasher),
+                Equal(equal)
+            {
+            }
+
+            TFlatHashTable(const TFlatHashTable& other) :
+                TFlatHashTable(other.Hasher, other.Equal)
+            {
+                Reserve(other.Size);
+
+                for (const auto& value : other)
+                {
+                    InsertUnique(value);
+                }
+            }
+
+            TFlatHashTable(TFlatHashTable&& other) noexcept :
+                TFlatHashTable(other.Hasher, other.Equal)
+            {
+                Swap(other);
+            }
+
+            ~TFlatHashTable()
+            {
+                Release();
+            }
+
+            TFlatHashTable& operator = (const TFlatHashTable& other)
+            {
+                if (this != &other)
+                {
+                    TFlatHashTable copy(other);
+                    Swap(copy);
+                }
+
+                return *this;
+            }
+
+            TFlatHashTable& operator = (TFlatHashTable&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    Release();
+                    Swap(other);
+                }
+
+                return *this;
+            }
+
+            void Swap(TFlatHashTable& other) noexcept
+            {
+                std::swap(Control, other.Control);
+                std::swap(Slots, other.Slots);
+                std::swap(Capacity, other.Capacity);
+                std::swap(Size, other.Size);
+                std::swap(GrowthLeft, other.GrowthLeft);
+                std::swap(Hasher, other.Hasher);
+                std::swap(Equal, other.Equal);
+            }
+
+            Iterator begin()
+            {
+                Iterator result(Control, Slots, Control + Capacity);
+                result.SkipFree();
+                return result;
+            }
+
+            Iterator end()
+            {
+                return Iterator(Control + Capacity, Slots + Capacity, Control + Capacity);
+            }
+
+            ConstIterator begin() const
+            {
+                ConstIterator result(Control, Slots, Control + Capacity);
+                result.SkipFree();
+                return result;
+            }
+
+            ConstIterator end() const
+            {
+                return ConstIterator(Control + Capacity, Slots + Capacity, Control + Capacity);
+            }
+
+            SizeType GetSize() const
+            {
+                return Size;
+            }
+
+            bool IsEmpty() const
+            {
+                return Size == 0;
+            }
+
+            SizeType GetCapacity() const
+            {
+                return Capacity;
+            }
+
+            float GetLoadFactor() const
+            {
+                return Capacity > 0 ? static_cast<float>(Size) / static_cast<float>(Capacity) : 0.0f;
+            }
+
+            // bytes owned by the table, memory owned by the keys and values themselves is not included
+            SizeType GetMemoryUsage() const
+            {
+                return sizeof(*this) + Capacity * (sizeof(int8_t) + sizeof(TSlot));
+            }
+
+            void Clear()
+            {
+                DestroySlots();
+
+                if (Capacity > 0)
+                {
+                    memset(Control, TFlatHashGroup::Empty, Capacity);
+                }
+
+                Size = 0;
+                GrowthLeft = MaxLoad(Capacity);
+            }
+
+            // make room for count elements without rehashing
+            void Reserve(const SizeType count)
+            {
+                const SizeType capacity = CapacityFor(count);
+
+                if (capacity > Capacity)
+                {
+                    Resize(capacity);
+                }
+            }
+
+            // rebuild the table with room for at least count elements, dropping deleted slots
+            // Rehash(0) shrinks the table to fit the current elements
+            void Rehash(const SizeType count)
+            {
+                const SizeType capacity = CapacityFor(count > Size ? count : Size);
+
+                if (capacity == 0)
+                {
+                    Release();
+                    return;
+                }
+
+                Resize(capacity);
+            }
+
+            template <typename TLookupKey>
+            Iterator Find(const TLookupKey& key)
+            {
+                const SizeType index = FindIndex(key, HashOf(key));
+
+                return index != InvalidIndex ? Iterator(Control + index, Slots + index, Control + Capacity) : end();
+            }
+
+            template <typename TLookupKey>
+            ConstIterator Find(const TLookupKey& key) const
+            {
+                const SizeType index = FindIndex(key, HashOf(key));
+
+                return index != InvalidIndex ? ConstIterator(Control + index, Slots + index, Control + Capacity) : end();
+            }
+
+            template <typename TLookupKey>
+            bool Contains(const TLookupKey& key) const
+            {
+                return FindIndex(key, HashOf(key)) != InvalidIndex;
+            }
+
+            template <typename TLookupKey>
+            SizeType Erase(const TLookupKey& key)
+            {
+                const SizeType index = FindIndex(key, HashOf(key));
+
+                if (index == InvalidIndex)
+                {
+                    return 0;
+                }
+
+                EraseAt(index);
+                return 1;
+            }
+
+            // returns the iterator following the erased element
+            Iterator Erase(Iterator position)
+            {
+                return Erase(ConstIterator(position));
+            }
+
+            Iterator Erase(ConstIterator position)
+            {
+                const auto index = static_cast<SizeType>(position.Control - Control);
+
+                EraseAt(index);
+
+                Iterator result(Control + index, Slots + index, Control + Capacity);
+                result.SkipFree();
+                return result;
+            }
+
+        protected:
+            constexpr static SizeType InvalidIndex = static_cast<SizeType>(-1);
+
+            template <typename TLookupKey>
+            uint64_t HashOf(const TLookupKey& key) const
+            {
+                // spread weak hashes such as the identity std::hash of integers
+                uint64_t hash = static_cast<uint64_t>(Hasher(key)) * 0x9E3779B97F4A7C15ull;
+                return hash ^ (hash >> 32);
+            }
+
+            static int8_t Hash2(const uint64_t hash)
+            {
+                return static_cast<int8_t>(hash & 0x7F);
+            }
+
+            static SizeType MaxLoad(const SizeType capacity)
+            {
+                return capacity - capacity / 8;
+            }
+
+            static SizeType CapacityFor(const SizeType count)
+            {
+                if (count == 0)
+                {
+                    return 0;
+                }
+
+                SizeType capacity = TFlatHashGroup::Width;
+
+                while (MaxLoad(capacity) < count)
+                {
+                    capacity *= 2;
+                }
+
+                return capacity;
+            }
+
+            template <typename TLookupKey>
+            SizeType FindIndex(const TLookupKey& key, const uint64_t hash) const
+            {
+                if (Capacity == 0)
+                {
+                    return InvalidIndex;
+                }
+
+                const SizeType groupMask = Capacity / TFlatHashGroup::Width - 1;
+                const int8_t hash2 = Hash2(hash);
+                SizeType group = static_cast<SizeType>(hash >> 7) & groupMask;
+
+                for (SizeType step = 1; ; ++step)
+                {
+                    const SizeType offset = group * TFlatHashGroup::Width;
+                    const int8_t* control = Control + offset;
+
+                    for (uint32_t mask = TFlatHashGroup::Match(control, hash2); mask != 0; mask &= mask - 1)
+                    {
+                        const SizeType index = offset + CountTrailingZeros32(mask);
+
+                        if (Equal(TPolicy::GetKey(Slots[index]), key))
+                        {
+                            return index;
+                        }
+                    }
+
+                    // a group with an empty slot ends every probe sequence passing through it
+                    if (TFlatHashGroup::MatchEmpty(control) != 0 || step > groupMask)
+                    {
+                        return InvalidIndex;
+                    }
+
+                    group = (group + step) & groupMask;
+                }
+            }
+
+            // index of a free slot for hash, the table must have room left
+            SizeType FindFreeIndex(const uint64_t hash) const
+            {
+                const SizeType groupMask = Capacity / TFlatHashGroup::Width - 1;
+                SizeType group = static_cast<SizeType>(hash >> 7) & groupMask;
+
+                for (SizeType step = 1; ; ++step)
+                {
+                    const SizeType offset = group * TFlatHashGroup::Width;
+                    const uint32_t mask = TFlatHashGroup::MatchEmptyOrDeleted(Control + offset);
+
+                    if (mask != 0)
+                    {
+                        return offset + CountTrailingZeros32(mask);
+                    }
+
+                    group = (group + step) & groupMask;
+                }
+            }
+
+            // find key, or construct a slot for it from args
+            template <typename TLookupKey, typename... TArgs>
+            std::pair<Iterator, bool> FindOrEmplace(const TLookupKey& key, TArgs&&... args)
+            {
+                auto construct = [&](void* storage) { new (storage) TSlot(std::forward<TArgs>(args)...); };
+
+                return FindOrConstruct(key, construct);
+            }
+
+            // find key, or call construct(storage) to build the slot for it, so nothing is built for a key that exists
+            template <typename TLookupKey, typename TConstructor>
+            std::pair<Iterator, bool> FindOrConstruct(const TLookupKey& key, TConstructor& construct)
+            {
+                uint64_t hash = HashOf(key);
+                SizeType index = FindIndex(key, hash);
+
+                if (index != InvalidIndex)
+                {
+                    return std::make_pair(Iterator(Control + index, Slots + index, Control + Capacity), false);
+                }
+
+                if (GrowthLeft == 0)
+                {
+                    // rehashing in place is enough when deleted slots use up the room
+                    Resize(Size * 2 < MaxLoad(Capacity) ? Capacity : (Capacity > 0 ? Capacity * 2 : TFlatHashGroup::Width));
+                }
+
+                index = FindFreeIndex(hash);
+
+                construct(GetStorage(index));
+
+                if (Control[index] == TFlatHashGroup::Empty)
+                {
+                    --GrowthLeft;
+                }
+
+                Control[index] = Hash2(hash);
+                ++Size;
+
+                return std::make_pair(Iterator(Control + index, Slots + index, Control + Capacity), true);
+            }
+
+            void InsertUnique(const TSlot& value)
+            {
+                const uint64_t hash = HashOf(TPolicy::GetKey(value));
+                const SizeType index = FindFreeIndex(hash);
+
+                new (GetStorage(index)) TSlot(value);
+                Control[index] = Hash2(hash);
+                ++Size;
+                --GrowthLeft;
+            }
+
+            void EraseAt(const SizeType index)
+            {
+                Slots[index].~TSlot();
+                --Size;
+
+                // probes only pass a group without empty slots, so a slot in any other group can become empty again
+                const SizeType offset = index & ~(TFlatHashGroup::Width - 1);
+
+                if (TFlatHashGroup::MatchEmpty(Control + offset) != 0)
+                {
+                    Control[index] = TFlatHashGroup::Empty;
+                    ++GrowthLeft;
+                }
+                else
+                {
+                    Control[index] = TFlatHashGroup::Deleted;
+                }
+            }
+
+            void Resize(const SizeType capacity)
+            {
+                assert(capacity >= TFlatHashGroup::Width && (capacity & (capacity - 1)) == 0 && MaxLoad(capacity) >= Size);
+
+                int8_t* oldControl = Control;
+                TSlot* oldSlots = Slots;
+                const SizeType oldCapacity = Capacity;
+
+                Control = new int8_t[capacity];
+                Slots = static_cast<TSlot*>(::operator new(capacity * sizeof(TSlot)));
+                Capacity = capacity;
+                GrowthLeft = MaxLoad(capacity) - Size;
+
+                memset(Control, TFlatHashGroup::Empty, capacity);
+
+                for (SizeType i = 0; i < oldCapacity; ++i)
+                {
+                    if (oldControl[i] >= 0)
+                    {
+                        const uint64_t hash = HashOf(TPolicy::GetKey(oldSlots[i]));
+                        const SizeType index = FindFreeIndex(hash);
+
+                        TPolicy::Relocate(GetStorage(index), oldSlots[i]);
+                        Control[index] = Hash2(hash);
+
+                        oldSlots[i].~TSlot();
+                    }
+                }
+
+                delete[] oldControl;
+                ::operator delete(const_cast<void*>(static_cast<const void*>(oldSlots)));
+            }
+
+            // set slots are const
+            void* GetStorage(const SizeType index) const
+            {
+                return const_cast<void*>(static_cast<const void*>(Slots + index));
+            }
+
+            void DestroySlots()
+            {
+                for (SizeType i = 0; i < Capacity && Size > 0; ++i)
+                {
+                    if (Control[i] >= 0)
+                    {
+                        Slots[i].~TSlot();
+                    }
+                }
+            }
+
+            void Release()
+            {
+                DestroySlots();
+
+                delete[] Control;
+                ::operator delete(GetStorage(0));
+
+                Control = nullptr;
+                Slots = nullptr;
+                Capacity = 0;
+                Size = 0;
+                GrowthLeft = 0;
+            }
+
+        protected:
+            int8_t*         Control;
+            TSlot*          Slots;
+            SizeType        Capacity;
+            SizeType        Size;
+            SizeType        GrowthLeft;
+            HasherType      Hasher;
+            EqualType       Equal;
+        };
+
+        template <typename TKey, typename TSlot, typename TPolicy, typename THasher, typename TEqual>
+        constexpr typename TFlatHashTable<TKey, TSlot, TPolicy, THasher, TEqual>::SizeType TFlatHashTable<TKey, TSlot, TPolicy, THasher, TEqual>::InvalidIndex;
+    }
+
+    // open addressing hash map storing its elements inline (SwissTable layout), one allocation for the
+    // control bytes and one for the slots. Find/Contains/Erase accept any key type the hasher and the
+    // equal functor accept: a TFlatHashMap<std::string, int> is searched by TStringRef without allocating.
+    // case insensitive tables use TIHash and TIEqual.
+    // inserting or rehashing invalidates iterators and references
+    template <
+        typename TKey,
+        typename TValue,
+        typename THasher = typename Details::TFlatHashDefaults<TKey>::HasherType,
+        typename TEqual = typename Details::TFlatHashDefaults<TKey>::EqualType
+    >
+    class TFlatHashMap :
+        public Details::TFlatHashTable<TKey, std::pair<const TKey, TValue>, Details::TFlatHashMapPolicy<TKey, TValue>, THasher, TEqual>
+    {
+        typedef Details::TFlatHashTable<TKey, std::pair<const TKey, TValue>, Details::TFlatHashMapPolicy<TKey, TValue>, THasher, TEqual> Super;
+
+    public:
+        typedef TValue                              MappedType;
+        typedef typename Super::ValueType           ValueType;
+        typedef typename Super::Iterator            Iterator;
+        typedef typename Super::ConstIterator       ConstIterator;
+
+        explicit TFlatHashMap(const THasher& hasher = THasher(), const TEqual& equal = TEqual()) :
+            Super(hasher, equal)
+        {
+        }
+
+        TFlatHashMap(std::initializer_list<ValueType> values)
+        {
+            this->Reserve(values.size());
+
+            for (const auto& value : values)
+            {
+                Insert(value);
+            }
+        }
+
+        std::pair<Iterator, bool> Insert(const ValueType& value)
+        {
+            return this->FindOrEmplace(value.first, value);
+        }
+
+        std::pair<Iterator, bool> Insert(const TKey& key, const TValue& value)
+        {
+            return this->FindOrEmplace(key, key, value);
+        }
+
+        // the key is only constructed (TKey(key)) when it is missing, so a TStringRef can be used
+        // for the lookup of a std::basic_string key
+        template <typename TLookupKey, typename... TArgs>
+        std::pair<Iterator, bool> Emplace(const TLookupKey& key, TArgs&&... args)
+        {
+            auto construct = [&](void* storage)
+                {
+                    new (storage) ValueType(
+                        std::piecewise_construct,
+                        std::forward_as_tuple(static_cast<TKey>(key)),
+                        std::forward_as_tuple(std::forward<TArgs>(args)...)
+                    );
+                };
+
+            return this->FindOrConstruct(key, construct);
+        }
+
+        template <typename TLookupKey>
+        TValue& operator [](const TLookupKey& key)
+        {
+            return Emplace(key).first->second;
+        }
+
+        template <typename TLookupKey>
+        TValue* TryGet(const TLookupKey& key)
+        {
+            const auto iter = this->Find(key);
+            return iter != this->end() ? &iter->second : nullptr;
+        }
+
+        template <typename TLookupKey>
+        const TValue* TryGet(const TLookupKey& key) const
+        {
+            const auto iter = this->Find(key);
+            return iter != this->end() ? &iter->second : nullptr;
+        }
+    };
+
+    template <
+        typename TKey,
+        typename THasher = typename Details::TFlatHashDefaults<TKey>::HasherType,
+        typename TEqual = typename Details::TFlatHashDefaults<TKey>::EqualType
+    >
+    class TFlatHashSet :
+        public Details::TFlatHashTable<TKey, const TKey, Details::TFlatHashSetPolicy<TKey>, THasher, TEqual>
+    {
+        typedef Details::TFlatHashTable<TKey, const TKey, Details::TFlatHashSetPolicy<TKey>, THasher, TEqual> Super;
+
+    public:
+        typedef typename Super::Iterator            Iterator;
+        typedef typename Super::ConstIterator       ConstIterator;
+
+        explicit TFlatHashSet(const THasher& hasher = THasher(), const TEqual& equal = TEqual()) :
+            Super(hasher, equal)
+        {
+        }
+
+        TFlatHashSet(std::initializer_list<TKey> values)
+        {
+            this->Reserve(values.size());
+
+            for (const auto& value : values)
+            {
+                Insert(value);
+            }
+        }
+
+        std::pair<Iterator, bool> Insert(const TKey& key)
+        {
+            return this->FindOrEmplace(key, key);
+        }
+
+        std::pair<Iterator, bool> Insert(TKey&& key)
+        {
+            return this->FindOrEmplace(key, std::move(key));
+        }
+
+        // the key is only constructed when it is missing
+        template <typename TLookupKey>
+        std::pair<Iterator, bool> Emplace(const TLookupKey& key)
+        {
+            auto construct = [&key](void* storage) { new (storage) TKey(static_cast<TKey>(key)); };
+
+            return this->FindOrConstruct(key, construct);
+        }
+    };
+}
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include <Common/BuildConfig.hpp>
+#include <Common/StringRef.hpp>
+#include <Common/Details/Simd.hpp>
+#include <Common/Details/StringSearchKernels.hpp>
+
+namespace CppMiniToolkit
+{
+    namespace Details
+    {
+        inline uint64_t HashMix(uint64_t first, uint64_t second)
+        {
+            Multiply128(first, second);
+            return first ^ second;
+        }
+
+        // words of up to 8 bytes, missing bytes are zero
+        struct THashPlainReader
+        {
+            static uint64_t Load(const uint8_t* data, const size_t length)
+            {
+                uint64_t word = 0;
+                memcpy(&word, data, length);
+                return word;
+            }
+        };
+
+        // loads words with the characters folded the same way as TCaseFolding,
+        // every word starts at a character boundary because 8 is a multiple of the character size
+        template <typename TCharType>
+        struct THashFoldingReader;
+
+        template <>
+        struct THashFoldingReader<char>
+        {
+            // SWAR: 0x20 is added to the bytes in 'A'..'Z', bytes of 0x80 and above are kept as they are
+            static uint64_t Fold(const uint64_t word)
+            {
+                const uint64_t ones = 0x0101010101010101ull;
+                const uint64_t heptets = word & (ones * 0x7F);
+                const uint64_t aboveA = heptets + ones * (0x80 - 'A');
+                const uint64_t aboveZ = heptets + ones * (0x80 - 'Z' - 1);
+                const uint64_t upper = (aboveA ^ aboveZ) & ~word & (ones * 0x80);
+
+                return word | (upper >> 2);
+            }
+
+            static uint64_t Load(const uint8_t* data, const size_t length)
+            {
+                return Fold(THashPlainReader::Load(data, length));
+            }
+        };
+
+        template <>
+        struct THashFoldingReader<wchar_t>
+        {
+            constexpr static size_t CharsPerWord = 8 / sizeof(wchar_t);
+
+            static uint64_t LaneOnes()
+            {
+                return sizeof(wchar_t) == 2 ? 0x0001000100010001ull : 0x0000000100000001ull;
+            }
+
+            static uint64_t Fold(const uint64_t word)
+            {
+                const uint64_t ones = LaneOnes();
+
+                // words of ASCII characters are folded with SWAR, the others character by character
+                if ((word & ~(ones * 0x7F)) == 0)
+                {
+                    const uint64_t upper = ((word + ones * (0x80 - 'A')) ^ (word + ones * (0x80 - 'Z' - 1))) & (ones * 0x80);
+
+                    return word | (upper >> 2);
+                }
+
+                wchar_t chars[CharsPerWord];
+                memcpy(chars, &word, sizeof(chars));
+
+                for (size_t i = 0; i < CharsPerWord; ++i)
+                {
+                    chars[i] = TCaseFolding<wchar_t>::Fold(chars[i]);
+                }
+
+                uint64_t result;
+                memcpy(&result, chars, sizeof(result));
+                return result;
+            }
+
+            static uint64_t Load(const uint8_t* data, const size_t length)
+            {
+                return Fold(THashPlainReader::Load(data, length));
+            }
+        };
+
+        // a wyhash style 64 bit hash: 48 byte stripes go through three independent multiply-mix lanes,
+        // the rest is consumed 16 bytes at a time
+        template <typename TReader>
+        inline uint64_t HashBytes(const void* data, const size_t length, uint64_t seed)
+        {
+            const uint64_t secret0 = 0x2d358dccaa6c78a5ull;
+            const uint64_t secret1 = 0x8bb84b93962eacc9ull;
+            const uint64_t secret2 = 0x4b33a62ed433d4a3ull;
+            const uint64_t secret3 = 0x4d5a2da51de1aa47ull;
+
+            const auto* bytes = static_cast<const uint8_t*>(data);
+            size_t remaining = length;
+
+            seed ^= HashMix(seed ^ secret0, secret1);
+
+            if (remaining > 48)
+            {
+                uint64_t seed1 = seed;
+                uint64_t seed2 = seed;
+
+                do
+                {
+                    seed = HashMix(TReader::Load(bytes, 8) ^ secret1, TReader::Load(bytes + 8, 8) ^ seed);
+                    seed1 = HashMix(TReader::Load(bytes + 16, 8) ^ secret2, TReader::Load(bytes + 24, 8) ^ seed1);
+                    seed2 = HashMix(TReader::Load(bytes + 32, 8) ^ secret3, TReader::Load(bytes + 40, 8) ^ seed2);
+
+                    bytes += 48;
+                    remaining -= 48;
+                } while (remaining > 48);
+
+                seed ^= seed1 ^ seed2;
+            }
+
+            while (remaining > 16)
+            {
+                seed = HashMix(TReader::Load(bytes, 8) ^ secret1, TReader::Load(bytes + 8, 8) ^ seed);
+
+                bytes += 16;
+                remaining -= 16;
+            }
+
+            uint64_t first = remaining > 0 ? TReader::Load(bytes, remaining < 8 ? remaining : 8) : 0;
+            uint64_t second = remaining > 8 ? TReader::Load(bytes + 8, remaining - 8) : 0;
+
+            first ^= secret1;
+            second ^= seed;
+            Multiply128(first, second);
+
+            return HashMix(first ^ secret0 ^ length, second ^ secret1);
+        }
+    }
+
+    // fast non cryptographic 64 bit hashing for hash table keys, not suitable against hostile input
+    // the ignore case variants fold characters like TCaseFolding, which agrees with StringAlgorithm::iEqual
+    // in the "C" locale: ASCII letters for char, towlower for wchar_t
+    class StringHash
+    {
+    public:
+        CMT_DECLARE_TOOLKIT_CLASS_TYPE(StringHash);
+
+        static uint64_t Calculate(const void* data, const size_t length, const uint64_t seed = 0)
+        {
+            return Details::HashBytes<Details::THashPlainReader>(data, length, seed);
+        }
+
+        template <typename TCharType>
+        static uint64_t Calculate(const TStringRef<TCharType>& str, const uint64_t seed = 0)
+        {
+            return Calculate(str.GetData(), str.GetLength() * sizeof(TCharType), seed);
+        }
+
+        template <typename TCharType>
+        static uint64_t Calculate(const std::basic_string<TCharType>& str, const uint64_t seed = 0)
+        {
+            return Calculate(str.c_str(), str.size() * sizeof(TCharType), seed);
+        }
+
+        template <typename TCharType>
+        static uint64_t iCalculate(const TStringRef<TCharType>& str, const uint64_t seed = 0)
+        {
+            return Details::HashBytes<Details::THashFoldingReader<TCharType>>(str.GetData(), str.GetLength() * sizeof(TCharType), seed);
+        }
+
+        template <typename TCharType>
+        static uint64_t iCalculate(const std::basic_string<TCharType>& str, const uint64_t seed = 0)
+        {
+            return iCalculate(TStringRef<TCharType>(str), seed);
+        }
+
+        // equality under the same folding as iCalculate, compared a word at a time
+        template <typename TCharType>
+        static bool iEqual(const TStringRef<TCharType>& first, const TStringRef<TCharType>& second)
+        {
+            typedef Details::THashFoldingReader<TCharType> ReaderType;
+
+            if (first.GetLength() != second.GetLength())
+            {
+                return false;
+            }
+
+            const auto* firstBytes = reinterpret_cast<const uint8_t*>(first.GetData());
+            const auto* secondBytes = reinterpret_cast<const uint8_t*>(second.GetData());
+            const size_t length = first.GetLength() * sizeof(TCharType);
+
+            for (size_t i = 0; i < length; i += 8)
+            {
+                const size_t count = length - i < 8 ? length - i : 8;
+
+                if (ReaderType::Load(firstBytes + i, count) != ReaderType::Load(secondBytes + i, count))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+    // std::hash compatible functors, e.g. std::unordered_map<std::string, int, iHash, iEqualTo>
+    // keys can be std::basic_string, TStringRef or zero terminated strings
+    template <typename TCharType>
+    struct THash
+    {
+        size_t operator ()(const TStringRef<TCharType>& str) const
+        {
+            return static_cast<size_t>(StringHash::Calculate(str));
+        }
+    };
+
+    template <typename TCharType>
+    struct TIHash
+    {
+        size_t operator ()(const TStringRef<TCharType>& str) const
+        {
+            return static_cast<size_t>(StringHash::iCalculate(str));
+        }
+    };
+
+    template <typename TCharType>
+    struct TEqual
+    {
+        bool operator ()(const TStringRef<TCharType>& first, const TStringRef<TCharType>& second) const
+        {
+            return first == second;
+        }
+    };
+
+    template <typename TCharType>
+    struct TIEqual
+    {
+        bool operator ()(const TStringRef<TCharType>& first, const TStringRef<TCharType>& second) const
+        {
+            return StringHash::iEqual(first, second);
+        }
+    };
+
+    typedef THash<char>         Hash;
+    typedef THash<wchar_t>      WHash;
+    typedef TEqual<char>        EqualTo;
+    typedef TEqual<wchar_t>     WEqualTo;
+    typedef TIHash<char>        iHash;
+    typedef TIHash<wchar_t>     iWHash;
+    typedef TIEqual<char>       iEqualTo;
+    typedef TIEqual<wchar_t>    iWEqualTo;
+}
@@ -0,0 +1,360 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <cassert>
+#include <string>
+
+#include <Common/CharTraits.hpp>
+#include <Common/StringRef.hpp>
+
+namespace CppMiniToolkit
+{
+    // a string with room for InlineLength characters inside the object, for short results built in loops
+    // (file names, combined paths, trimmed tokens) without touching the heap.
+    // it is a TStringRef to its own characters, so it can be passed to every TStringRef overload of
+    // StringAlgorithm and PathUtils, and GetData is always zero terminated for TCharTraits.
+    // when the content does not fit:
+    //   SpillToHeap == false: the content is cut at InlineLength characters and IsTruncated() turns true
+    //   SpillToHeap == true: the characters move to a heap buffer, growing like std::basic_string
+    template <typename TCharType, size_t InlineLength, bool SpillToHeap = false>
+    class TInlineString : public TStringRef<TCharType>
+    {
+        typedef TStringRef<TCharType> Super;
+
+    public:
+        typedef TStringRef<TCharType>               RefType;
+        typedef std::basic_string<TCharType>        StringType;
+        typedef typename RefType::SizeType          SizeType;
+        typedef TCharType*                          Iterator;
+        typedef const TCharType*                    ConstIterator;
+
+        constexpr static SizeType InlineCapacity = InlineLength;
+
+        TInlineString() :
+            Buffer(Inline),
+            Capacity(InlineLength),
+            Truncated(false)
+        {
+            SetLength(0);
+        }
+
+        explicit TInlineString(const TCharType* str) :
+            TInlineString()
+        {
+            Assign(RefType(str));
+        }
+
+        explicit TInlineString(const TCharType* str, const SizeType length) :
+            TInlineString()
+        {
+            Assign(str, length);
+        }
+
+        explicit TInlineString(const RefType& str) :
+            TInlineString()
+        {
+            Assign(str);
+        }
+
+        explicit TInlineString(const StringType& str) :
+            TInlineString()
+        {
+            Assign(RefType(str));
+        }
+
+        TInlineString(const TInlineString& other) :
+            TInlineString()
+        {
+            Assign(other);
+            Truncated = other.Truncated;
+        }
+
+        TInlineString(TInlineString&& other) noexcept :
+            TInlineString()
+        {
+            MoveFrom(other);
+        }
+
+        ~TInlineString()
+        {
+            ReleaseHeap();
+        }
+
+        TInlineString& operator = (const TInlineString& other)
+        {
+            if (this != &other)
+            {
+                Assign(other);
+                Truncated = other.Truncated;
+            }
+
+            return *this;
+        }
+
+        TInlineString& operator = (TInlineString&& other) noexcept
+        {
+            if (this != &other)
+            {
+                MoveFrom(other);
+            }
+
+            return *this;
+        }
+
+        TInlineString& operator = (const RefType& str)
+        {
+            return Assign(str);
+        }
+
+        TInlineString& operator += (const RefType& str)
+        {
+            return Append(str);
+        }
+
+        TInlineString& operator += (const TCharType ch)
+        {
+            return Append(ch);
+        }
+
+        using Super::GetData;
+        using Super::begin;
+        using Super::end;
+        using Super::operator[];
+
+        TCharType* GetData()
+        {
+            return Buffer;
+        }
+
+        Iterator begin()
+        {
+            return Buffer;
+        }
+
+        Iterator end()
+        {
+            return Buffer + this->GetLength();
+        }
+
+        TCharType& operator [](const SizeType index)
+        {
+            assert(index < this->GetLength());
+            return Buffer[index];
+        }
+
+        SizeType GetCapacity() const
+        {
+            return Capacity;
+        }
+
+        // false once the characters spilled to the heap
+        bool IsInline() const
+        {
+            return Buffer == Inline;
+        }
+
+        // true when characters were dropped since the last Assign or Clear, never for SpillToHeap
+        bool IsTruncated() const
+        {
+            return Truncated;
+        }
+
+        // str may refer to the characters of this string
+        TInlineString& Assign(const TCharType* str, const SizeType length)
+        {
+            Truncated = false;
+
+            const SizeType newLength = Fit(length, str);
+
+            if (newLength > 0)
+            {
+                memmove(Buffer, str, newLength * sizeof(TCharType));
+            }
+
+            SetLength(newLength);
+            return *this;
+        }
+
+        TInlineString& Assign(const RefType& str)
+        {
+            return Assign(str.GetData(), str.GetLength());
+        }
+
+        // str may refer to the characters of this string
+        TInlineString& Append(const TCharType* str, const SizeType length)
+        {
+            const SizeType oldLength = this->GetLength();
+            const SizeType newLength = Fit(oldLength + length, str);
+
+            if (newLength > oldLength)
+            {
+                memmove(Buffer + oldLength, str, (newLength - oldLength) * sizeof(TCharType));
+            }
+
+            SetLength(newLength);
+            return *this;
+        }
+
+        TInlineString& Append(const RefType& str)
+        {
+            return Append(str.GetData(), str.GetLength());
+        }
+
+        TInlineString& Append(const TCharType ch, const SizeType count = 1)
+        {
+            const SizeType oldLength = this->GetLength();
+            const TCharType* source = nullptr;
+            const SizeType newLength = Fit(oldLength + count, source);
+
+            for (SizeType i = oldLength; i < newLength; ++i)
+            {
+                Buffer[i] = ch;
+            }
+
+            SetLength(newLength);
+            return *this;
+        }
+
+        // shortens the string, or pads it with ch
+        TInlineString& Resize(const SizeType length, const TCharType ch = TCharType())
+        {
+            if (length <= this->GetLength())
+            {
+                SetLength(length);
+                return *this;
+            }
+
+            return Append(ch, length - this->GetLength());
+        }
+
+        // only a string that spills to the heap can grow beyond InlineLength
+        void Reserve(const SizeType capacity)
+        {
+            const TCharType* source = nullptr;
+
+            if (SpillToHeap && capacity > Capacity)
+            {
+                Fit(capacity, source);
+            }
+        }
+
+        // unlike the TStringRef versions these change the content, the characters stay at the start of the buffer
+        void RemovePrefix(const SizeType count)
+        {
+            assert(count <= this->GetLength());
+
+            const SizeType length = this->GetLength() - count;
+
+            if (count > 0 && length > 0)
+            {
+                memmove(Buffer, Buffer + count, length * sizeof(TCharType));
+            }
+
+            SetLength(length);
+        }
+
+        void RemoveSuffix(const SizeType count)
+        {
+            assert(count <= this->GetLength());
+
+            SetLength(this->GetLength() - count);
+        }
+
+        // the heap buffer is kept for reuse
+        void Clear()
+        {
+            Truncated = false;
+            SetLength(0);
+        }
+
+    private:
+        void SetLength(const SizeType length)
+        {
+            Buffer[length] = TCharType();
+            static_cast<Super&>(*this) = Super(Buffer, length);
+        }
+
+        // makes room for length characters and returns how many of them fit,
+        // source is moved along when it points into the old heap buffer
+        SizeType Fit(const SizeType length, const TCharType*& source)
+        {
+            if (length <= Capacity)
+            {
+                return length;
+            }
+
+            if (!SpillToHeap)
+            {
+                Truncated = true;
+                return Capacity;
+            }
+
+            const SizeType capacity = Capacity * 2 > length ? Capacity * 2 : length;
+            const SizeType oldLength = this->GetLength();
+            TCharType* buffer = new TCharType[capacity + 1];
+
+            memcpy(buffer, Buffer, (oldLength + 1) * sizeof(TCharType));
+
+            if (source != nullptr && source >= Buffer && source <= Buffer + oldLength)
+            {
+                source = buffer + (source - Buffer);
+            }
+
+            ReleaseHeap();
+
+            Buffer = buffer;
+            Capacity = capacity;
+            SetLength(oldLength);
+
+            return length;
+        }
+
+        void MoveFrom(TInlineString& other)
+        {
+            if (other.IsInline())
+            {
+                Assign(other);
+            }
+            else
+            {
+                ReleaseHeap();
+
+                Buffer = other.Buffer;
+                Capacity = other.Capacity;
+                SetLength(other.GetLength());
+
+                other.Buffer = other.Inline;
+                other.Capacity = InlineLength;
+            }
+
+            Truncated = other.Truncated;
+            other.Clear();
+        }
+
+        void ReleaseHeap()
+        {
+            if (Buffer != Inline)
+            {
+                delete[] Buffer;
+                Buffer = Inline;
+                Capacity = InlineLength;
+            }
+        }
+
+    private:
+        TCharType*      Buffer;
+        SizeType        Capacity;
+        bool            Truncated;
+        TCharType       Inline[InlineLength + 1];
+    };
+
+    template <typename TCharType, size_t InlineLength, bool SpillToHeap>
+    constexpr typename TInlineString<TCharType, InlineLength, SpillToHeap>::SizeType TInlineString<TCharType, InlineLength, SpillToHeap>::InlineCapacity;
+
+    template <size_t InlineLength, bool SpillToHeap = false>
+    using InlineString = TInlineString<char, InlineLength, SpillToHeap>;
+
+    template <size_t InlineLength, bool SpillToHeap = false>
+    using WInlineString = TInlineString<wchar_t, InlineLength, SpillToHeap>;
+}
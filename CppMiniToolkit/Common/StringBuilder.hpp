@@ -0,0 +1,502 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cassert>
+#include <cerrno>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include <type_traits>
+#include <utility>
+
+#include <Common/BuildConfig.hpp>
+#include <Common/CharTraits.hpp>
+#include <Common/DynamicBuffer.hpp>
+#include <Common/StringRef.hpp>
+#include <Common/Details/NumberConversionKernels.hpp>
+
+#if CMT_PLATFORM_WINDOWS
+#include <io.h>
+#else
+#include <unistd.h>
+#include <sys/uio.h>
+#endif
+
+namespace CppMiniToolkit
+{
+    namespace Details
+    {
+        template <typename TCharType>
+        struct TIsCharacterType
+        {
+            constexpr static bool Value =
+                std::is_same<TCharType, char>::value ||
+                std::is_same<TCharType, wchar_t>::value ||
+                std::is_same<TCharType, char16_t>::value ||
+                std::is_same<TCharType, char32_t>::value;
+        };
+    }
+
+    // builds long text out of many pieces: characters are appended into a list of fixed size chunks,
+    // so growing never moves what was already written, and the result is produced once at the end
+    // with ToString, WriteTo(DynamicBuffer) or WriteTo(file descriptor).
+    // Clear keeps the chunks, so a builder reused for every report allocates only while it is warming up
+    template <typename TCharType>
+    class TStringBuilder
+    {
+    public:
+        typedef TCharType                       CharType;
+        typedef std::basic_string<TCharType>    StringType;
+        typedef TStringRef<TCharType>           StringRefType;
+        typedef size_t                          SizeType;
+
+        // characters per chunk
+        constexpr static SizeType DefaultChunkLength = 16 * 1024 / sizeof(TCharType);
+
+        explicit TStringBuilder(const SizeType chunkLength = DefaultChunkLength) :
+            ChunkLength(chunkLength > 0 ? chunkLength : DefaultChunkLength),
+            CurrentIndex(0),
+            Length(0)
+        {
+        }
+
+        // the source is left empty, with its chunk length, and can be appended to again
+        TStringBuilder(TStringBuilder&& other) noexcept :
+            TStringBuilder(other.ChunkLength)
+        {
+            Swap(other);
+        }
+
+        TStringBuilder& operator = (TStringBuilder&& other) noexcept
+        {
+            if (this != &other)
+            {
+                TStringBuilder moved(std::move(other));
+                Swap(moved);
+            }
+
+            return *this;
+        }
+
+        TStringBuilder(const TStringBuilder&) = delete;
+        TStringBuilder& operator = (const TStringBuilder&) = delete;
+
+        void Swap(TStringBuilder& other) noexcept
+        {
+            std::swap(Chunks, other.Chunks);
+            std::swap(ChunkLength, other.ChunkLength);
+            std::swap(CurrentIndex, other.CurrentIndex);
+            std::swap(Length, other.Length);
+        }
+
+        SizeType GetLength() const
+        {
+            return Length;
+        }
+
+        bool IsEmpty() const
+        {
+            return Length == 0;
+        }
+
+        // allocated characters
+        SizeType GetCapacity() const
+        {
+            return Chunks.size() * ChunkLength;
+        }
+
+        void Clear()
+        {
+            for (auto& chunk : Chunks)
+            {
+                chunk.Length = 0;
+            }
+
+            CurrentIndex = 0;
+            Length = 0;
+        }
+
+        TStringBuilder& Append(const TCharType* str, SizeType length)
+        {
+            Length += length;
+
+            while (length > 0)
+            {
+                TChunk& chunk = GetWritableChunk();
+                const SizeType count = ChunkLength - chunk.Length < length ? ChunkLength - chunk.Length : length;
+
+                memcpy(chunk.Data.get() + chunk.Length, str, count * sizeof(TCharType));
+
+                chunk.Length += count;
+                str += count;
+                length -= count;
+            }
+
+            return *this;
+        }
+
+        TStringBuilder& Append(const StringRefType& str)
+        {
+            return Append(str.GetData(), str.GetLength());
+        }
+
+        TStringBuilder& Append(const TCharType ch, SizeType count = 1)
+        {
+            Length += count;
+
+            while (count > 0)
+            {
+                TChunk& chunk = GetWritableChunk();
+                const SizeType fill = ChunkLength - chunk.Length < count ? ChunkLength - chunk.Length : count;
+
+                std::fill_n(chunk.Data.get() + chunk.Length, fill, ch);
+
+                chunk.Length += fill;
+                count -= fill;
+            }
+
+            return *this;
+        }
+
+        // decimal, characters passed here are written as numbers
+        template <typename TInteger>
+        typename std::enable_if<std::is_integral<TInteger>::value, TStringBuilder&>::type AppendInteger(const TInteger value)
+        {
+            typedef Details::TIntegerFormatter<TCharType> FormatterType;
+
+            TCharType buffer[FormatterType::MaxLength];
+            TCharType* const end = buffer + FormatterType::MaxLength;
+            const TCharType* begin = std::is_signed<TInteger>::value ?
+                FormatterType::FormatSigned(end, static_cast<int64_t>(value)) :
+                FormatterType::FormatUnsigned(end, static_cast<uint64_t>(value));
+
+            return Append(begin, static_cast<SizeType>(end - begin));
+        }
+
+        // at least minDigits digits, padded with zeros, without a prefix
+        TStringBuilder& AppendHex(const uint64_t value, const SizeType minDigits = 0, const bool upper = false)
+        {
+            typedef Details::TIntegerFormatter<TCharType> FormatterType;
+
+            TCharType buffer[FormatterType::MaxLength];
+            TCharType* const end = buffer + FormatterType::MaxLength;
+            const TCharType* begin = FormatterType::FormatHex(end, value, minDigits, upper);
+
+            return Append(begin, static_cast<SizeType>(end - begin));
+        }
+
+        // the shortest digits that read back as value: 0.1, 1e+100
+        template <typename TFloat>
+        typename std::enable_if<std::is_floating_point<TFloat>::value, TStringBuilder&>::type AppendFloat(const TFloat value)
+        {
+            typedef typename std::conditional<std::is_same<TFloat, float>::value, float, double>::type FormatType;
+
+            char buffer[Details::TShortestFormatter::MaxLength];
+            const size_t length = Details::TShortestFormatter::Format(static_cast<FormatType>(value), buffer);
+
+            return AppendNarrow(buffer, length);
+        }
+
+        // rounded to decimals digits after the point like printf("%.*f"), decimals is at most 9
+        TStringBuilder& AppendFixed(const double value, const int decimals)
+        {
+            char buffer[Details::TFixedFormatter::MaxLength];
+            const size_t length = Details::TFixedFormatter::Format(value, decimals, buffer);
+
+            return AppendNarrow(buffer, length);
+        }
+
+        // every {} in format is replaced by the next argument, {{ and }} stand for { and }
+        // arguments can be strings, string references, characters, integers, floating point values and bool:
+        // builder.AppendFormat("{} files in {}", count, directory)
+        template <typename... TArgs>
+        TStringBuilder& AppendFormat(const StringRefType& format, const TArgs&... args)
+        {
+            FormatCore(format.GetData(), format.GetData() + format.GetLength(), args...);
+            return *this;
+        }
+
+        template <typename T>
+        TStringBuilder& operator << (const T& value)
+        {
+            AppendValue(value);
+            return *this;
+        }
+
+        // visitor receives (pointer, length) of every chunk in order
+        template <typename TVisitor>
+        void ForEachChunk(TVisitor visitor) const
+        {
+            for (SizeType i = 0; i < Chunks.size() && Chunks[i].Length > 0; ++i)
+            {
+                visitor(static_cast<const TCharType*>(Chunks[i].Data.get()), Chunks[i].Length);
+            }
+        }
+
+        StringType ToString() const
+        {
+            StringType result;
+            result.reserve(Length);
+
+            ForEachChunk([&result](const TCharType* data, const SizeType length) { result.append(data, length); });
+
+            return result;
+        }
+
+        // the buffer receives the raw characters appended to its content, without terminating zero
+        template <int AlignLength>
+        TDynamicBuffer<AlignLength>& WriteTo(TDynamicBuffer<AlignLength>& buffer) const
+        {
+            buffer.Reserve(buffer.GetSize() + Length * sizeof(TCharType));
+
+            ForEachChunk([&buffer](const TCharType* data, const SizeType length) { buffer.Append(data, length * sizeof(TCharType)); });
+
+            return buffer;
+        }
+
+        // writes the raw characters to an open file descriptor, false on a write error
+        bool WriteTo(const int fd) const
+        {
+#if CMT_PLATFORM_WINDOWS
+            bool succeeded = true;
+
+            ForEachChunk([fd, &succeeded](const TCharType* data, const SizeType length)
+                {
+                    const auto* bytes = reinterpret_cast<const char*>(data);
+                    SizeType remaining = length * sizeof(TCharType);
+
+                    while (succeeded && remaining > 0)
+                    {
+                        const unsigned int count = remaining < 0x40000000u ? static_cast<unsigned int>(remaining) : 0x40000000u;
+                        const int written = _write(fd, bytes, count);
+
+                        if (written <= 0)
+                        {
+                            succeeded = false;
+                            break;
+                        }
+
+                        bytes += written;
+                        remaining -= static_cast<SizeType>(written);
+                    }
+                });
+
+            return succeeded;
+#else
+            // writev sends up to MaxVectors chunks per system call
+            constexpr SizeType MaxVectors = 64;
+
+            SizeType chunkIndex = 0;
+            SizeType offset = 0;
+            const SizeType chunkCount = CurrentIndex < Chunks.size() ? CurrentIndex + 1 : 0;
+
+            while (chunkIndex < chunkCount)
+            {
+                iovec vectors[MaxVectors];
+                int count = 0;
+
+                for (SizeType i = chunkIndex; i < chunkCount && static_cast<SizeType>(count) < MaxVectors; ++i, ++count)
+                {
+                    const SizeType skip = i == chunkIndex ? offset : 0;
+
+                    vectors[count].iov_base = const_cast<char*>(reinterpret_cast<const char*>(Chunks[i].Data.get())) + skip;
+                    vectors[count].iov_len = Chunks[i].Length * sizeof(TCharType) - skip;
+                }
+
+                const ssize_t result = ::writev(fd, vectors, count);
+
+                if (result < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    return false;
+                }
+
+                // step over what was written, a short write resumes inside a chunk
+                auto written = static_cast<SizeType>(result);
+
+                while (chunkIndex < chunkCount)
+                {
+                    const SizeType remaining = Chunks[chunkIndex].Length * sizeof(TCharType) - offset;
+
+                    if (written < remaining)
+                    {
+                        offset += written;
+                        break;
+                    }
+
+                    written -= remaining;
+                    offset = 0;
+                    ++chunkIndex;
+                }
+            }
+
+            return true;
+#endif
+        }
+
+    private:
+        struct TChunk
+        {
+            std::unique_ptr<TCharType[]>    Data;
+            SizeType                        Length;
+        };
+
+        TChunk& GetWritableChunk()
+        {
+            if (Chunks.empty())
+            {
+                AddChunk();
+            }
+            else if (Chunks[CurrentIndex].Length == ChunkLength)
+            {
+                // chunks kept by Clear are reused first
+                if (++CurrentIndex == Chunks.size())
+                {
+                    AddChunk();
+                }
+            }
+
+            return Chunks[CurrentIndex];
+        }
+
+        void AddChunk()
+        {
+            Chunks.push_back(TChunk());
+            Chunks.back().Data.reset(new TCharType[ChunkLength]);
+            Chunks.back().Length = 0;
+        }
+
+        void AppendValue(const StringRefType& value)
+        {
+            Append(value);
+        }
+
+        void AppendValue(const TCharType* value)
+        {
+            Append(StringRefType(value));
+        }
+
+        void AppendValue(const StringType& value)
+        {
+            Append(value.c_str(), value.size());
+        }
+
+        void AppendValue(const TCharType value)
+        {
+            Append(value);
+        }
+
+        template <typename TBool>
+        typename std::enable_if<std::is_same<TBool, bool>::value>::type AppendValue(const TBool value)
+        {
+            static const TCharType S_True[] = { 't', 'r', 'u', 'e', 0 };
+            static const TCharType S_False[] = { 'f', 'a', 'l', 's', 'e', 0 };
+
+            Append(value ? StringRefType(S_True, 4) : StringRefType(S_False, 5));
+        }
+
+        template <typename TInteger>
+        typename std::enable_if<
+            std::is_integral<TInteger>::value && !std::is_same<TInteger, bool>::value && !Details::TIsCharacterType<TInteger>::Value
+        >::type AppendValue(const TInteger value)
+        {
+            AppendInteger(value);
+        }
+
+        template <typename TFloat>
+        typename std::enable_if<std::is_floating_point<TFloat>::value>::type AppendValue(const TFloat value)
+        {
+            AppendFloat(value);
+        }
+
+        TStringBuilder& AppendNarrow(const char* str, const size_t length)
+        {
+            TCharType buffer[Details::TShortestFormatter::MaxLength];
+
+            for (size_t i = 0; i < length; ++i)
+            {
+                buffer[i] = static_cast<TCharType>(str[i]);
+            }
+
+            return Append(buffer, static_cast<SizeType>(length));
+        }
+
+        // appends format up to the next {}, unescaping {{ and }}, and returns the position after the {}
+        // or nullptr at the end of format
+        const TCharType* AppendFormatText(const TCharType* format, const TCharType* end)
+        {
+            const TCharType* text = format;
+
+            while (format != end)
+            {
+                if ((*format == TCharType('{') || *format == TCharType('}')) && format + 1 != end && format[1] == *format)
+                {
+                    Append(text, static_cast<SizeType>(format + 1 - text));
+                    format += 2;
+                    text = format;
+                }
+                else if (*format == TCharType('{') && format + 1 != end && format[1] == TCharType('}'))
+                {
+                    Append(text, static_cast<SizeType>(format - text));
+                    return format + 2;
+                }
+                else
+                {
+                    ++format;
+                }
+            }
+
+            Append(text, static_cast<SizeType>(format - text));
+            return nullptr;
+        }
+
+        void FormatCore(const TCharType* format, const TCharType* end)
+        {
+            const TCharType* next = AppendFormatText(format, end);
+
+            assert(next == nullptr && "more {} than arguments");
+
+            // the remaining placeholders stay in the output
+            while (next != nullptr)
+            {
+                static const TCharType S_Placeholder[] = { '{', '}' };
+
+                Append(S_Placeholder, 2);
+                next = AppendFormatText(next, end);
+            }
+        }
+
+        template <typename TFirst, typename... TArgs>
+        void FormatCore(const TCharType* format, const TCharType* end, const TFirst& first, const TArgs&... args)
+        {
+            const TCharType* next = AppendFormatText(format, end);
+
+            assert(next != nullptr && "more arguments than {}");
+
+            if (next != nullptr)
+            {
+                AppendValue(first);
+                FormatCore(next, end, args...);
+            }
+        }
+
+    private:
+        std::vector<TChunk>     Chunks;
+        SizeType                ChunkLength;
+        SizeType                CurrentIndex;
+        SizeType                Length;
+    };
+
+    template <typename TCharType>
+    constexpr typename TStringBuilder<TCharType>::SizeType TStringBuilder<TCharType>::DefaultChunkLength;
+
+    typedef TStringBuilder<char>        StringBuilder;
+    typedef TStringBuilder<wchar_t>     WStringBuilder;
+}
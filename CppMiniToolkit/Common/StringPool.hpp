@@ -0,0 +1,245 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cassert>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <Common/StringRef.hpp>
+#include <Common/Hash.hpp>
+#include <Common/FlatHashMap.hpp>
+
+namespace CppMiniToolkit
+{
+    // an atom table: every distinct string is stored once and identified by a 32 bit handle,
+    // so interned strings compare by handle and repeated strings (extensions, directory names)
+    // cost 4 bytes instead of a std::basic_string each.
+    // the characters live in arena chunks that are never moved or freed before the pool,
+    // views returned by GetString are zero terminated and stay valid as long as the pool.
+    // with IgnoreCase, strings differing only in case share a handle and the first spelling is kept.
+    // Intern and Find lock a mutex, GetString of a handle already returned does not lock
+    template <typename TCharType, bool IgnoreCase = false>
+    class TStringPool
+    {
+    public:
+        typedef TCharType                   CharType;
+        typedef TStringRef<TCharType>       StringRefType;
+        typedef uint32_t                    HandleType;
+        typedef size_t                      SizeType;
+
+        constexpr static HandleType InvalidHandle = static_cast<HandleType>(-1);
+
+        // characters per arena chunk, longer strings get a chunk of their own
+        constexpr static SizeType DefaultChunkLength = 16 * 1024 / sizeof(TCharType);
+
+        explicit TStringPool(const SizeType chunkLength = DefaultChunkLength) :
+            Current(nullptr),
+            ChunkLength(chunkLength > 0 ? chunkLength : DefaultChunkLength),
+            ChunkPosition(0),
+            ChunkCapacity(0),
+            Count(0),
+            ArenaSize(0)
+        {
+            for (auto& segment : Segments)
+            {
+                segment.store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        ~TStringPool()
+        {
+            for (auto& segment : Segments)
+            {
+                delete[] segment.load(std::memory_order_relaxed);
+            }
+        }
+
+        TStringPool(const TStringPool&) = delete;
+        TStringPool& operator = (const TStringPool&) = delete;
+
+        // returns the handle of str, adding a copy of it when it is new
+        HandleType Intern(const StringRefType& str)
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+
+            const HandleType* existing = Handles.TryGet(str);
+
+            if (existing != nullptr)
+            {
+                return *existing;
+            }
+
+            assert(Count.load(std::memory_order_relaxed) < InvalidHandle && "too many strings in the pool");
+
+            const HandleType handle = Count.load(std::memory_order_relaxed);
+
+            // the key refers to the pool's own copy, not to the caller's characters
+            const StringRefType stored = Store(str);
+            Handles.Insert(stored, handle);
+
+            GetEntry(handle) = stored;
+            Count.store(handle + 1, std::memory_order_release);
+
+            return handle;
+        }
+
+        // Intern, returning the stored string instead of its handle
+        StringRefType InternView(const StringRefType& str)
+        {
+            return GetString(Intern(str));
+        }
+
+        // the handle of str, InvalidHandle if it was never interned
+        HandleType Find(const StringRefType& str) const
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+
+            const HandleType* handle = Handles.TryGet(str);
+
+            return handle != nullptr ? *handle : InvalidHandle;
+        }
+
+        bool Contains(const StringRefType& str) const
+        {
+            return Find(str) != InvalidHandle;
+        }
+
+        StringRefType GetString(const HandleType handle) const
+        {
+            assert(handle < Count.load(std::memory_order_acquire));
+
+            const uint64_t index = static_cast<uint64_t>(handle) + FirstSegmentLength;
+            const SizeType segment = SegmentOf(index);
+
+            return Segments[segment].load(std::memory_order_acquire)[static_cast<SizeType>(index - (static_cast<uint64_t>(FirstSegmentLength) << segment))];
+        }
+
+        // number of distinct strings
+        SizeType GetSize() const
+        {
+            return Count.load(std::memory_order_acquire);
+        }
+
+        bool IsEmpty() const
+        {
+            return GetSize() == 0;
+        }
+
+        // arena chunks, handle table and lookup table in bytes
+        SizeType GetMemoryUsage() const
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+
+            SizeType entries = 0;
+
+            for (SizeType i = 0; i < SegmentCount && Segments[i].load(std::memory_order_relaxed) != nullptr; ++i)
+            {
+                entries += FirstSegmentLength << i;
+            }
+
+            return sizeof(*this) +
+                ArenaSize * sizeof(TCharType) +
+                Chunks.capacity() * sizeof(Chunks[0]) +
+                entries * sizeof(StringRefType) +
+                Handles.GetMemoryUsage() - sizeof(Handles);
+        }
+
+    private:
+        typedef typename std::conditional<IgnoreCase, TIHash<TCharType>, THash<TCharType>>::type     HasherType;
+        typedef typename std::conditional<IgnoreCase, TIEqual<TCharType>, TEqual<TCharType>>::type   EqualType;
+
+        // handles index a table of segments doubling in size, segments never move once allocated
+        constexpr static SizeType FirstSegmentBits = 8;
+        constexpr static SizeType FirstSegmentLength = static_cast<SizeType>(1) << FirstSegmentBits;
+        constexpr static SizeType SegmentCount = 33 - FirstSegmentBits;
+
+        static SizeType SegmentOf(const uint64_t index)
+        {
+            return 63 - Details::CountLeadingZeros64(index) - FirstSegmentBits;
+        }
+
+        StringRefType& GetEntry(const HandleType handle)
+        {
+            const uint64_t index = static_cast<uint64_t>(handle) + FirstSegmentLength;
+            const SizeType segment = SegmentOf(index);
+
+            StringRefType* entries = Segments[segment].load(std::memory_order_relaxed);
+
+            if (entries == nullptr)
+            {
+                entries = new StringRefType[FirstSegmentLength << segment];
+                Segments[segment].store(entries, std::memory_order_release);
+            }
+
+            return entries[static_cast<SizeType>(index - (static_cast<uint64_t>(FirstSegmentLength) << segment))];
+        }
+
+        // copies str into the arena, zero terminated
+        StringRefType Store(const StringRefType& str)
+        {
+            const SizeType length = str.GetLength() + 1;
+            TCharType* destination;
+
+            if (length > ChunkLength / 4)
+            {
+                // long strings get their own chunk, so the current one is not wasted
+                Chunks.emplace_back(new TCharType[length]);
+                destination = Chunks.back().get();
+                ArenaSize += length;
+            }
+            else
+            {
+                if (ChunkCapacity - ChunkPosition < length)
+                {
+                    Chunks.emplace_back(new TCharType[ChunkLength]);
+                    ChunkPosition = 0;
+                    ChunkCapacity = ChunkLength;
+                    ArenaSize += ChunkLength;
+                    Current = Chunks.back().get();
+                }
+
+                destination = Current + ChunkPosition;
+                ChunkPosition += length;
+            }
+
+            if (str.GetLength() > 0)
+            {
+                memcpy(destination, str.GetData(), str.GetLength() * sizeof(TCharType));
+            }
+
+            destination[str.GetLength()] = TCharType();
+
+            return StringRefType(destination, str.GetLength());
+        }
+
+    private:
+        mutable std::mutex                                              Mutex;
+        TFlatHashMap<StringRefType, HandleType, HasherType, EqualType>  Handles;
+        std::vector<std::unique_ptr<TCharType[]>>                       Chunks;
+        TCharType*                                                      Current;
+        SizeType                                                        ChunkLength;
+        SizeType                                                        ChunkPosition;
+        SizeType                                                        ChunkCapacity;
+        std::atomic<StringRefType*>                                     Segments[SegmentCount];
+        std::atomic<HandleType>                                         Count;
+        SizeType                                                        ArenaSize;
+    };
+
+    template <typename TCharType, bool IgnoreCase>
+    constexpr typename TStringPool<TCharType, IgnoreCase>::HandleType TStringPool<TCharType, IgnoreCase>::InvalidHandle;
+
+    template <typename TCharType, bool IgnoreCase>
+    constexpr typename TStringPool<TCharType, IgnoreCase>::SizeType TStringPool<TCharType, IgnoreCase>::DefaultChunkLength;
+
+    template <typename TCharType, bool IgnoreCase>
+    constexpr typename TStringPool<TCharType, IgnoreCase>::SizeType TStringPool<TCharType, IgnoreCase>::FirstSegmentLength;
+
+    typedef TStringPool<char>               StringPool;
+    typedef TStringPool<wchar_t>            WStringPool;
+    typedef TStringPool<char, true>         iStringPool;
+    typedef TStringPool<wchar_t, true>      iWStringPool;
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <string>
+#include <cassert>
+
+#include <Common/CharTraits.hpp>
+
+namespace CppMiniToolkit
+{
+    // a non owning reference to a run of characters (pointer + length), like std::basic_string_view of C++17
+    // the referenced characters are not required to be zero terminated, and must outlive the reference
+    template <typename TCharType>
+    class TStringRef
+    {
+    public:
+        typedef TCharType                           CharType;
+        typedef std::basic_string<TCharType>        StringType;
+        typedef typename StringType::size_type      SizeType;
+        typedef const TCharType*                    ConstIterator;
+
+        constexpr static SizeType npos = StringType::npos;
+
+        constexpr TStringRef() :
+            Data(nullptr),
+            Length(0)
+        {
+        }
+
+        TStringRef(const TCharType* str) : // NOLINT(google-explicit-constructor)
+            Data(str),
+            Length(str != nullptr ? TCharTraits<TCharType>::length(str) : 0)
+        {
+        }
+
+        constexpr TStringRef(const TCharType* str, const SizeType length) :
+            Data(str),
+            Length(length)
+        {
+        }
+
+        TStringRef(const StringType& str) : // NOLINT(google-explicit-constructor)
+            Data(str.c_str()),
+            Length(str.size())
+        {
+        }
+
+        constexpr const TCharType* GetData() const
+        {
+            return Data;
+        }
+
+        constexpr SizeType GetLength() const
+        {
+            return Length;
+        }
+
+        constexpr bool IsEmpty() const
+        {
+            return Length == 0;
+        }
+
+        ConstIterator begin() const
+        {
+            return Data;
+        }
+
+        ConstIterator end() const
+        {
+            return Data + Length;
+        }
+
+        const TCharType& operator [](const SizeType index) const
+        {
+            assert(index < Length);
+            return Data[index];
+        }
+
+        // count is clamped to the end of the reference
+        TStringRef SubRef(const SizeType pos, const SizeType count = npos) const
+        {
+            assert(pos <= Length);
+
+            return TStringRef(Data + pos, count < Length - pos ? count : Length - pos);
+        }
+
+        void RemovePrefix(const SizeType count)
+        {
+            assert(count <= Length);
+
+            Data += count;
+            Length -= count;
+        }
+
+        void RemoveSuffix(const SizeType count)
+        {
+            assert(count <= Length);
+
+            Length -= count;
+        }
+
+        StringType ToString() const
+        {
+            return Length > 0 ? StringType(Data, Length) : StringType();
+        }
+
+        explicit operator StringType() const
+        {
+            return ToString();
+        }
+
+        friend bool operator == (const TStringRef& first, const TStringRef& second)
+        {
+            return first.Length == second.Length &&
+                (first.Length == 0 || TCharTraits<TCharType>::compare(first.Data, second.Data, first.Length) == 0);
+        }
+
+        friend bool operator != (const TStringRef& first, const TStringRef& second)
+        {
+            return !(first == second);
+        }
+
+    private:
+        const TCharType*    Data;
+        SizeType            Length;
+    };
+
+    template <typename TCharType>
+    constexpr typename TStringRef<TCharType>::SizeType TStringRef<TCharType>::npos;
+
+    typedef TStringRef<char>        StringRef;
+    typedef TStringRef<wchar_t>     WStringRef;
+
+    namespace Details
+    {
+        // keeps a parameter out of template argument deduction, so it accepts anything convertible
+        template <typename T>
+        struct TNonDeduced
+        {
+            typedef T Type;
+        };
+
+        // a string reference parameter that also takes strings and pointers of the deduced character type
+        template <typename TCharType>
+        using TStringRefArgument = typename TNonDeduced<TStringRef<TCharType>>::Type;
+    }
+
+    namespace Shims
+    {
+        template <typename TCharType>
+        inline const TCharType* PtrOf(const TStringRef<TCharType>& str)
+        {
+            return str.GetData();
+        }
+
+        template <typename TCharType>
+        inline size_t LengthOf(const TStringRef<TCharType>& str)
+        {
+            return str.GetLength();
+        }
+    }
+}
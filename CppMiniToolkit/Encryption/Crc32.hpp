@@ -7,6 +7,9 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <string>
+
+#include <Text/HexBase64.hpp>
 
 #define CMT_CRC32_USE_LOOKUP_TABLE_BYTE
 #define CMT_CRC32_USE_LOOKUP_TABLE_SLICING_BY_4
@@ -542,6 +545,14 @@ public:
 #endif
         }
 
+        /// eight hexadecimal digits, most significant first
+        static std::string ToHexString(uint32_t crc32, bool upper = false)
+        {
+            const uint8_t bytes[4] = { uint8_t(crc32 >> 24), uint8_t(crc32 >> 16), uint8_t(crc32 >> 8), uint8_t(crc32) };
+
+            return HexCodec::Encode(bytes, sizeof(bytes), upper);
+        }
+
 
         /// merge two CRC32 such that result = crc32(dataB, lengthB, crc32(dataA, lengthA))
         static uint32_t Combine(uint32_t crcA, uint32_t crcB, size_t lengthB)
@@ -9,6 +9,7 @@
 #include <fstream>
 
 #include <Common/CharTraits.hpp>
+#include <Text/HexBase64.hpp>
 
 namespace CppMiniToolkit
 {
@@ -23,24 +24,12 @@ namespace CppMiniToolkit
         // Convert to a string of hexadecimal digits
         std::string ToHexString() const
         {
-            char buffer[36];
-            for (int i = 0; i < 16; ++i)
-            {
-                TCharTraits<char>::StringPrintf(buffer + i * 2, 36 - i * 2, "%02x", Bytes[i]);  // NOLINT(bugprone-implicit-widening-of-multiplication-result)
-            }
-
-            return buffer;
+            return HexCodec::Encode(Bytes, sizeof(Bytes));
         }
 
         std::string ToHexUpperString() const
         {
-            char buffer[36];
-            for (int i = 0; i < 16; ++i)
-            {
-                TCharTraits<char>::StringPrintf(buffer + i * 2, 36 - i * 2, "%02X", Bytes[i]);  // NOLINT(bugprone-implicit-widening-of-multiplication-result)
-            }
-
-            return buffer;
+            return HexCodec::Encode(Bytes, sizeof(Bytes), true);
         }
     };
 
@@ -206,7 +206,8 @@ namespace CppMiniToolkit
                 closedir(dir);
             }
 
-            static void WalkThoughDirectory(const char* directory, const std::function<bool(const char*, bool)>& visitor, bool recursively, bool includeDirectories) // NOLINT(*-no-recursion)
+            // filter tests the name of an entry before its path is built, directories are walked into either way
+            static void WalkThoughDirectory(const char* directory, const std::function<bool(const char*, bool)>& visitor, bool recursively, bool includeDirectories, const std::function<bool(const char*)>& filter = nullptr) // NOLINT(*-no-recursion)
             {
                 DIR* dir = opendir(directory);
                 if (!dir)
@@ -222,17 +223,24 @@ namespace CppMiniToolkit
                         continue;
                     }
 
+                    bool isDirectory = entry->d_type == DT_DIR;
+                    bool isAccepted = (!isDirectory || includeDirectories) && (!filter || filter(entry->d_name));
+
+                    if (!isAccepted && !(isDirectory && recursively))
+                    {
+                        continue;
+                    }
+
                     std::string fullPath(directory);
                     fullPath += "/";
                     fullPath += entry->d_name;
 
-                    bool isDirectory = entry->d_type == DT_DIR;
                     if (isDirectory && recursively)
                     {
-                        WalkThoughDirectory(fullPath.c_str(), visitor, true, includeDirectories);
+                        WalkThoughDirectory(fullPath.c_str(), visitor, true, includeDirectories, filter);
                     }
 
-                    if (isDirectory || includeDirectories)
+                    if (isAccepted)
                     {
                         if (!visitor(fullPath.c_str(), isDirectory))
                         {
@@ -521,7 +521,8 @@ namespace CppMiniToolkit
             }
 
 
-            static void WalkThoughDirectory(const std::string& directory, const std::function<bool (const char*, bool)>& visitor, const bool recursively, const bool includeDirectories) // NOLINT(*-no-recursion)
+            // filter tests the name of an entry before its path is built, directories are walked into either way
+            static void WalkThoughDirectory(const std::string& directory, const std::function<bool (const char*, bool)>& visitor, const bool recursively, const bool includeDirectories, const std::function<bool(const char*)>& filter = nullptr) // NOLINT(*-no-recursion)
             {
                 WIN32_FIND_DATAA win32_find_dataa;
                 const HANDLE hFind = FindFirstFileA((directory + "\\*").c_str(), &win32_find_dataa); // NOLINT(*-misplaced-const)
@@ -535,10 +536,12 @@ namespace CppMiniToolkit
                             continue;
                         }
 
+                        const bool isAccepted = !filter || filter(win32_find_dataa.cFileName);
+
                         // this is directory
                         if ((win32_find_dataa.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
                         {
-                            if (includeDirectories)
+                            if (includeDirectories && isAccepted)
                             {
                                 if (!visitor((directory + "\\" + win32_find_dataa.cFileName).c_str(), true))
                                 {
@@ -548,10 +551,10 @@ namespace CppMiniToolkit
 
                             if (recursively)
                             {
-                                WalkThoughDirectory(directory + "\\" + win32_find_dataa.cFileName, visitor, recursively, includeDirectories);
+                                WalkThoughDirectory(directory + "\\" + win32_find_dataa.cFileName, visitor, recursively, includeDirectories, filter);
                             }
                         }
-                        else
+                        else if (isAccepted)
                         {
                             if (!visitor((directory + "\\" + win32_find_dataa.cFileName).c_str(), false))
                             {
@@ -564,7 +567,8 @@ namespace CppMiniToolkit
                 }
             }
 
-            static void WalkThoughDirectory(const std::wstring& directory, const std::function<bool(const wchar_t*, bool)>& visitor, const bool recursively, const bool includeDirectories) // NOLINT(*-no-recursion)
+            // filter tests the name of an entry before its path is built, directories are walked into either way
+            static void WalkThoughDirectory(const std::wstring& directory, const std::function<bool(const wchar_t*, bool)>& visitor, const bool recursively, const bool includeDirectories, const std::function<bool(const wchar_t*)>& filter = nullptr) // NOLINT(*-no-recursion)
             {
                 WIN32_FIND_DATAW win32_find_dataw;
                 const HANDLE hFind = FindFirstFileW((directory + L"\\*").c_str(), &win32_find_dataw); // NOLINT(*-misplaced-const)
@@ -578,10 +582,12 @@ namespace CppMiniToolkit
                             continue;
                         }
 
+                        const bool isAccepted = !filter || filter(win32_find_dataw.cFileName);
+
                         // this is directory
                         if ((win32_find_dataw.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
                         {
-                            if (includeDirectories)
+                            if (includeDirectories && isAccepted)
                             {
                                 if (!visitor((directory + L"\\" + win32_find_dataw.cFileName).c_str(), true))
                                 {
@@ -591,10 +597,10 @@ namespace CppMiniToolkit
 
                             if (recursively)
                             {
-                                WalkThoughDirectory(directory + L"\\" + win32_find_dataw.cFileName, visitor, recursively, includeDirectories);
+                                WalkThoughDirectory(directory + L"\\" + win32_find_dataw.cFileName, visitor, recursively, includeDirectories, filter);
                             }
                         }
-                        else
+                        else if (isAccepted)
                         {
                             if (!visitor((directory + L"\\" + win32_find_dataw.cFileName).c_str(), false))
                             {
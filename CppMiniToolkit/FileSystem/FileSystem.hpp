@@ -2,6 +2,7 @@
 
 #include <Common/BuildConfig.hpp>
 #include <Common/DynamicBuffer.hpp>
+#include <Algorithm/GlobPattern.hpp>
 #include <fstream>
 #include <functional>
 
@@ -107,6 +108,15 @@ namespace CppMiniToolkit
             FileSystemDetails::WalkThoughDirectory(directory, visitor, recursively, includeDirectories);
         }
 
+        // walk though the entries whose name matches filter, e.g. TGlobPattern<char, true>("*.log")
+        // names are tested before the path of the entry is built, directories are walked into even if their name doesn't match
+        template <typename TCharType, bool IgnoreCase>
+        static void WalkThoughDirectoryEx(const TCharType* directory, const TGlobPattern<TCharType, IgnoreCase>& filter, typename Details::TNonDeduced<std::function<bool (const TCharType*,bool)>>::Type visitor, bool recursively = false, bool includeDirectories = true)
+        {
+            auto nameFilter = [&filter](const TCharType* name) { return filter.Match(name); };
+            FileSystemDetails::WalkThoughDirectory(directory, visitor, recursively, includeDirectories, nameFilter);
+        }
+
         // walk though without visitor
         template <typename TCharType>
         static void WalkThoughDirectory(const TCharType* directory, bool recursively = false, bool includeDirectories = true)
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include <Common/BuildConfig.hpp>
+#include <Common/DynamicBuffer.hpp>
+#include <Common/StringRef.hpp>
+
+namespace CppMiniToolkit
+{
+    // reads text line by line without holding the whole file in memory:
+    //     LineReader reader;
+    //     if (reader.OpenFile("server.log"))
+    //         for (StringRef line; reader.ReadLine(line); ) ...
+    // the file is read in blocks of blockSize bytes, line ends are found with memchr, which the
+    // C library vectorizes, and a line cut by the end of a block is moved to the front of the buffer
+    // before the next block is read behind it. a line longer than a block grows the buffer, and only
+    // the newly read bytes of it are searched, so long lines still cost one pass.
+    // lines end with "\n" or "\r\n", the last line may have no line end.
+    // lines are views into the buffer (or into the text given to OpenText), valid until the next ReadLine
+    class LineReader
+    {
+    public:
+        constexpr static size_t DefaultBlockSize = 1024 * 1024;
+
+        explicit LineReader(const size_t blockSize = DefaultBlockSize) :
+            Data(nullptr),
+            BlockSize(blockSize),
+            Begin(0),
+            Scanned(0),
+            End(0),
+            LineNumber(0),
+            EndOfInput(true),
+            Error(false)
+        {
+            assert(blockSize > 0);
+        }
+
+        LineReader(const LineReader&) = delete;
+        LineReader& operator = (const LineReader&) = delete;
+
+        // lines of a file, false if it can't be opened
+        template <typename TCharType>
+        bool OpenFile(const TCharType* path)
+        {
+            assert(path != nullptr);
+
+            Close();
+
+            // the blocks are read straight into Buffer, the stream doesn't need its own
+            File.rdbuf()->pubsetbuf(nullptr, 0);
+            File.open(path, std::ios::binary);
+
+            if (!File)
+            {
+                return false;
+            }
+
+            EndOfInput = false;
+            return true;
+        }
+
+        // lines of text in memory, which is not copied and must outlive the reader
+        void OpenText(const StringRef& text)
+        {
+            Close();
+
+            Data = text.GetData();
+            End = text.GetLength();
+        }
+
+        // a temporary string would be destroyed before the lines are used
+        void OpenText(std::string&& text) = delete;
+
+        void Close()
+        {
+            if (File.is_open())
+            {
+                File.close();
+            }
+
+            File.clear();
+
+            Data = nullptr;
+            Begin = Scanned = End = 0;
+            LineNumber = 0;
+            EndOfInput = true;
+            Error = false;
+        }
+
+        bool IsOpen() const
+        {
+            return Data != nullptr || File.is_open();
+        }
+
+        // the next line without its line end, false at the end of the input or if reading failed
+        bool ReadLine(StringRef& line)
+        {
+            for (;;)
+            {
+                if (Begin < End)
+                {
+                    const char* begin = Data + Begin;
+                    const auto newline = Scanned < End ? static_cast<const char*>(memchr(Data + Scanned, '\n', End - Scanned)) : nullptr;
+
+                    if (newline != nullptr)
+                    {
+                        const auto length = static_cast<size_t>(newline - begin);
+
+                        Begin += length + 1;
+                        Scanned = Begin;
+                        line = StringRef(begin, length > 0 && newline[-1] == '\r' ? length - 1 : length);
+                        ++LineNumber;
+
+                        return true;
+                    }
+
+                    Scanned = End;
+
+                    if (EndOfInput)
+                    {
+                        line = StringRef(begin, End - Begin);
+                        Begin = End;
+                        ++LineNumber;
+
+                        return true;
+                    }
+                }
+                else if (EndOfInput)
+                {
+                    return false;
+                }
+
+                ReadBlock();
+            }
+        }
+
+        // number of lines returned by ReadLine so far
+        size_t GetLineNumber() const
+        {
+            return LineNumber;
+        }
+
+        // reading the file failed before its end, the lines returned so far are valid
+        bool HasError() const
+        {
+            return Error;
+        }
+
+    private:
+        // keeps the unfinished line and appends the next block behind it
+        void ReadBlock()
+        {
+            const size_t remaining = End - Begin;
+
+            if (remaining > 0 && Begin > 0)
+            {
+                memmove(Buffer.GetData(), Buffer.GetData(Begin), remaining);
+            }
+
+            Buffer.Resize(remaining + BlockSize);
+
+            File.read(reinterpret_cast<char*>(Buffer.GetData(remaining)), static_cast<std::streamsize>(BlockSize));
+
+            const auto count = static_cast<size_t>(File.gcount());
+
+            if (count < BlockSize)
+            {
+                EndOfInput = true;
+                Error = File.bad();
+            }
+
+            Data = reinterpret_cast<const char*>(Buffer.GetData());
+            Scanned -= Begin;
+            Begin = 0;
+            End = remaining + count;
+        }
+
+    private:
+        std::ifstream   File;
+        DynamicBuffer   Buffer;
+        const char*     Data;
+        size_t          BlockSize;
+        // characters not returned yet are Data[Begin, End), the ones before Scanned have no line end
+        size_t          Begin;
+        size_t          Scanned;
+        size_t          End;
+        size_t          LineNumber;
+        bool            EndOfInput;
+        bool            Error;
+    };
+}
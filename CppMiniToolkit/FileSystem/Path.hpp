@@ -3,6 +3,8 @@
 #include <Common/BuildConfig.hpp>
 #include <string>
 #include <Common/CharTraits.hpp>
+#include <Common/StringRef.hpp>
+#include <Common/InlineString.hpp>
 
 namespace CppMiniToolkit
 {
@@ -19,6 +21,12 @@ namespace CppMiniToolkit
             return S_SplitFlags;
         }
 
+        template <typename TCharType>
+        static bool IsSplitFlag(const TCharType ch)
+        {
+            return ch == TCharType('\\') || ch == TCharType('/');
+        }
+
     public:
         template <typename TCharType>
         static std::basic_string<TCharType> GetFileName(const TCharType* path)
@@ -46,6 +54,26 @@ namespace CppMiniToolkit
             return pos;
         }
 
+        // string reference versions return references into path instead of new strings
+        template <typename TCharType>
+        static TStringRef<TCharType> GetFileName(const TStringRef<TCharType>& path)
+        {
+            const auto pos = TCharTraits<TCharType>::rFindAny(path.GetData(), path.GetLength(), GetSplitFlags<TCharType>(), 2);
+
+            return pos == nullptr ? path : path.SubRef(static_cast<size_t>(pos - path.GetData()) + 1);
+        }
+
+        // only the file name part is searched, so a dot in a directory name is not an extension
+        template <typename TCharType>
+        static TStringRef<TCharType> GetExtension(const TStringRef<TCharType>& path)
+        {
+            const auto fileName = GetFileName(path);
+
+            const auto pos = TCharTraits<TCharType>::rFind(fileName.GetData(), fileName.GetLength(), TCharType('.'));
+
+            return fileName.SubRef(pos == nullptr ? fileName.GetLength() : static_cast<size_t>(pos - fileName.GetData()));
+        }
+
         template <typename TCharType>
         static std::basic_string<TCharType> GetFileNameWithoutExtension(const TCharType* path)
         {
@@ -87,7 +115,7 @@ namespace CppMiniToolkit
         static std::basic_string<TCharType> GetDirectoryPath(const TCharType* path)
         {
             auto len = std::char_traits<TCharType>::length(path);
-            auto pos = TCharTraits<TCharType>::rFindAny(path, GetSplitFlags<TCharType>());
+            auto pos = TCharTraits<TCharType>::rFindAny(path, len, GetSplitFlags<TCharType>(), 2);
 
             return pos != nullptr ? std::basic_string<TCharType>(path, pos) : std::basic_string<TCharType>();
         }
@@ -99,14 +127,18 @@ namespace CppMiniToolkit
         }
 
     private:
+        // TStringType is std::basic_string or TInlineString
         template <typename TCharType, typename T0, typename... T>
         struct CombineHelper
         {
-            static std::basic_string<TCharType>& Combine(std::basic_string<TCharType>& path, const T0& arg0, const T... args)
+            template <typename TStringType>
+            static TStringType& Combine(TStringType& path, const T0& arg0, const T... args)
             {
-                if (!path.empty() && *path.rbegin() != '/' && *path.rbegin() != '\\')
+                const TStringRef<TCharType> current(path);
+
+                if (!current.IsEmpty() && !IsSplitFlag(current[current.GetLength() - 1]))
                 {
-                    path.push_back(TCharTraits<TCharType>::StaticPathSeparator());
+                    path += TCharTraits<TCharType>::StaticPathSeparator();
                 }
 
                 path += Shims::PtrOf(arg0);
@@ -120,11 +152,14 @@ namespace CppMiniToolkit
         template <typename TCharType, typename T>
         struct CombineHelper<TCharType, T>
         {
-            static std::basic_string<TCharType>& Combine(std::basic_string<TCharType>& path, const T& arg0)
+            template <typename TStringType>
+            static TStringType& Combine(TStringType& path, const T& arg0)
             {
-                if (!path.empty() && *path.rbegin() != '/' && *path.rbegin() != '\\')
+                const TStringRef<TCharType> current(path);
+
+                if (!current.IsEmpty() && !IsSplitFlag(current[current.GetLength() - 1]))
                 {
-                    path.push_back(TCharTraits<TCharType>::StaticPathSeparator());
+                    path += TCharTraits<TCharType>::StaticPathSeparator();
                 }
                 
                 path += Shims::PtrOf(arg0);
@@ -143,6 +178,13 @@ namespace CppMiniToolkit
             return Result;
         }
 
+        // append to path in place, a TInlineString reused in a loop combines without allocating
+        template <typename TCharType, size_t InlineLength, bool SpillToHeap, typename... T>
+        static TInlineString<TCharType, InlineLength, SpillToHeap>& Combine(TInlineString<TCharType, InlineLength, SpillToHeap>& path, T... args)
+        {
+            return CombineHelper<TCharType, T...>::Combine(path, args...);
+        }
+
         template <typename TCharType>
         static bool IsAbsolutePath(const TCharType* path)
         {
@@ -9,6 +9,7 @@
 // ReSharper disable once CppUnusedIncludeDirective
 #include <tchar.h>
 #include <Dbghelp.h>
+#include <Common/CharTraits.hpp>
 #include <Common/ScopedExit.hpp>
 
 #pragma comment(lib, "Dbghelp")
@@ -63,11 +64,14 @@ namespace CppMiniToolkit
                     finalVal /= 1024;
                 }
 
-                TCHAR buffer[64] = {};
+                TCHAR buffer[32];
+                const TCHAR* end = TCharTraits<TCHAR>::ToCharsFixed(buffer, buffer + 32, finalVal, 2);
 
-                _stprintf_s(buffer, _T("%.2f %s"), finalVal, units[Index]);
+                StringT result(buffer, end);
+                result += _T(' ');
+                result += units[Index];
 
-                return buffer;
+                return result;
             }
 
             static bool DumpProcess(const int processId, const StringT& path)
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <Common/BuildConfig.hpp>
+#include <Common/DynamicBuffer.hpp>
+#include <Common/StringRef.hpp>
+#include <Text/Details/CsvKernels.hpp>
+
+namespace CppMiniToolkit
+{
+    // splits delimited text (CSV of RFC 4180, TSV with '\t') into rows and fields in one pass:
+    //     CsvTokenizer csv;
+    //     if (csv.Parse(text))
+    //         for (size_t row = 0; row < csv.GetRowCount(); ++row) ... csv.GetField(row, 0) ...
+    // fields may be quoted with '"' and then contain delimiters, line breaks and doubled quotes.
+    // rows end with "\n" or "\r\n", the last row may have no line end.
+    // the index is a structure of arrays: the end offset of every field and the number of fields up
+    // to the end of every row, kept in buffers that are reused by the next Parse, so parsing batch
+    // after batch with one tokenizer does not allocate once the buffers are large enough.
+    // fields are views into the parsed text, which must outlive the index. texts are limited to 4 GiB
+    class CsvTokenizer
+    {
+    public:
+        explicit CsvTokenizer(const char delimiter = ',') :
+            Delimiter(delimiter),
+            FieldCount(0),
+            RowCount(0)
+        {
+            assert(delimiter != '"' && delimiter != '\n' && delimiter != '\r');
+        }
+
+        // replaces the index with the one of text, false when a quoted field is not closed,
+        // the rows before it are still indexed then
+        bool Parse(const StringRef& text)
+        {
+            assert(text.GetLength() < UINT32_MAX);
+
+            Text = text;
+            FieldCount = 0;
+            RowCount = 0;
+
+            auto onBlock = [this](const size_t offset, uint64_t separators, const uint64_t lineFeeds)
+            {
+                Reserve(FieldEnds, FieldCount + Details::TCsvKernels::BlockLength);
+                Reserve(RowEnds, RowCount + Details::TCsvKernels::BlockLength);
+
+                uint32_t* fieldEnds = GetArray(FieldEnds);
+                uint32_t* rowEnds = GetArray(RowEnds);
+
+                while (separators != 0)
+                {
+                    const uint32_t index = Details::CountTrailingZeros64(separators);
+
+                    fieldEnds[FieldCount++] = static_cast<uint32_t>(offset + index);
+
+                    if ((lineFeeds >> index & 1) != 0)
+                    {
+                        rowEnds[RowCount++] = static_cast<uint32_t>(FieldCount);
+                    }
+
+                    separators &= separators - 1;
+                }
+            };
+
+            const bool closed = Details::TCsvKernels::Tokenize(text.GetData(), text.GetLength(), Delimiter, onBlock);
+
+            if (!closed)
+            {
+                // drop the unfinished row
+                FieldCount = RowCount > 0 ? GetArray(RowEnds)[RowCount - 1] : 0;
+                return false;
+            }
+
+            // the last row without a line end, or with a delimiter before the end of the text
+            const bool rowsComplete = RowCount > 0 && GetArray(RowEnds)[RowCount - 1] == FieldCount;
+
+            if (!text.IsEmpty() && !(rowsComplete && GetArray(FieldEnds)[FieldCount - 1] == text.GetLength() - 1))
+            {
+                Reserve(FieldEnds, FieldCount + 1);
+                Reserve(RowEnds, RowCount + 1);
+
+                GetArray(FieldEnds)[FieldCount++] = static_cast<uint32_t>(text.GetLength());
+                GetArray(RowEnds)[RowCount++] = static_cast<uint32_t>(FieldCount);
+            }
+
+            return true;
+        }
+
+        char GetDelimiter() const
+        {
+            return Delimiter;
+        }
+
+        size_t GetRowCount() const
+        {
+            return RowCount;
+        }
+
+        // fields of all rows
+        size_t GetFieldCount() const
+        {
+            return FieldCount;
+        }
+
+        size_t GetColumnCount(const size_t row) const
+        {
+            return GetRowEnd(row) - GetRowBegin(row);
+        }
+
+        // the field without its surrounding quotes, doubled quotes inside are kept, see GetValue
+        StringRef GetField(const size_t row, const size_t column) const
+        {
+            const StringRef field = GetRawField(GetFieldIndex(row, column));
+
+            if (field.GetLength() >= 2 && field[0] == '"' && field[field.GetLength() - 1] == '"')
+            {
+                return field.SubRef(1, field.GetLength() - 2);
+            }
+
+            return field;
+        }
+
+        // the field as written in the text, including quotes, without the "\r" of a "\r\n" row end
+        StringRef GetRawField(const size_t index) const
+        {
+            assert(index < FieldCount);
+
+            const uint32_t* fieldEnds = GetArray(FieldEnds);
+            const size_t begin = index > 0 ? fieldEnds[index - 1] + 1 : 0;
+            size_t end = fieldEnds[index];
+
+            if (end > begin && end < Text.GetLength() && Text[end] == '\n' && Text[end - 1] == '\r')
+            {
+                --end;
+            }
+
+            return Text.SubRef(begin, end - begin);
+        }
+
+        // the unquoted field with doubled quotes collapsed, assigned to value
+        std::string& GetValue(const size_t row, const size_t column, std::string& value) const
+        {
+            const StringRef field = GetField(row, column);
+
+            value.clear();
+
+            for (size_t i = 0; i < field.GetLength(); ++i)
+            {
+                value += field[i];
+
+                if (field[i] == '"' && i + 1 < field.GetLength() && field[i + 1] == '"')
+                {
+                    ++i;
+                }
+            }
+
+            return value;
+        }
+
+        std::string GetValue(const size_t row, const size_t column) const
+        {
+            std::string value;
+            return GetValue(row, column, value);
+        }
+
+    private:
+        size_t GetRowBegin(const size_t row) const
+        {
+            assert(row < RowCount);
+
+            return row > 0 ? GetArray(RowEnds)[row - 1] : 0;
+        }
+
+        size_t GetRowEnd(const size_t row) const
+        {
+            assert(row < RowCount);
+
+            return GetArray(RowEnds)[row];
+        }
+
+        size_t GetFieldIndex(const size_t row, const size_t column) const
+        {
+            assert(column < GetColumnCount(row));
+
+            return GetRowBegin(row) + column;
+        }
+
+        // room for count offsets, growing geometrically and keeping the content
+        static void Reserve(DynamicBuffer& buffer, const size_t count)
+        {
+            if (buffer.GetSize() < count * sizeof(uint32_t))
+            {
+                buffer.Resize(count * sizeof(uint32_t));
+            }
+        }
+
+        static uint32_t* GetArray(DynamicBuffer& buffer)
+        {
+            return reinterpret_cast<uint32_t*>(buffer.GetBuffer());
+        }
+
+        static const uint32_t* GetArray(const DynamicBuffer& buffer)
+        {
+            return reinterpret_cast<const uint32_t*>(buffer.GetBuffer());
+        }
+
+    private:
+        char            Delimiter;
+        StringRef       Text;
+        // end offsets of the fields, the delimiter or line feed after them or the end of the text
+        DynamicBuffer   FieldEnds;
+        // FieldCount at the end of each row
+        DynamicBuffer   RowEnds;
+        size_t          FieldCount;
+        size_t          RowCount;
+    };
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <Common/BuildConfig.hpp>
+#include <Common/Details/Simd.hpp>
+
+namespace CppMiniToolkit
+{
+    namespace Details
+    {
+        // structural characters of delimited text, found 64 bytes at a time (the simdcsv scheme):
+        // each block is turned into bit masks of quotes, delimiters and line feeds, the characters
+        // inside quotes are the prefix xor of the quote mask, and only the delimiters and line feeds
+        // outside of them separate fields. a doubled quote inside a quoted field toggles twice,
+        // so it leaves the state as it was
+        class TCsvKernels
+        {
+        public:
+            constexpr static size_t BlockLength = 64;
+
+            // bit i of every mask describes character i of the block
+            struct TBlockMasks
+            {
+                uint64_t    Quotes;
+                uint64_t    Delimiters;
+                uint64_t    LineFeeds;
+            };
+
+            // calls onBlock(offset, separators, lineFeeds) for every block of text that has separators,
+            // lineFeeds is the part of separators ending rows.
+            // returns false when text ends inside a quoted field
+            template <typename TCallback>
+            static bool Tokenize(const char* text, const size_t length, const char delimiter, TCallback& onBlock)
+            {
+                // all bits set while the previous block ended inside quotes
+                uint64_t carry = 0;
+                size_t offset = 0;
+
+                for (; offset + BlockLength <= length; offset += BlockLength)
+                {
+                    ScanBlock(text + offset, offset, delimiter, carry, onBlock);
+                }
+
+                if (offset < length)
+                {
+                    // the tail is padded with zeros, which are no structural characters
+                    char tail[BlockLength] = {};
+                    memcpy(tail, text + offset, length - offset);
+
+                    ScanBlock(tail, offset, delimiter, carry, onBlock);
+                }
+
+                return carry == 0;
+            }
+
+            static void Classify(const char* block, const char delimiter, TBlockMasks& masks)
+            {
+#if CMT_SIMD_AVX2
+                const __m256i quote = _mm256_set1_epi8('"');
+                const __m256i separator = _mm256_set1_epi8(delimiter);
+                const __m256i lineFeed = _mm256_set1_epi8('\n');
+
+                const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+                const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+
+                masks.Quotes = Combine32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, quote)), _mm256_movemask_epi8(_mm256_cmpeq_epi8(high, quote)));
+                masks.Delimiters = Combine32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, separator)), _mm256_movemask_epi8(_mm256_cmpeq_epi8(high, separator)));
+                masks.LineFeeds = Combine32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, lineFeed)), _mm256_movemask_epi8(_mm256_cmpeq_epi8(high, lineFeed)));
+#elif CMT_SIMD_SSE2
+                const __m128i quote = _mm_set1_epi8('"');
+                const __m128i separator = _mm_set1_epi8(delimiter);
+                const __m128i lineFeed = _mm_set1_epi8('\n');
+
+                masks.Quotes = masks.Delimiters = masks.LineFeeds = 0;
+
+                for (size_t i = 0; i < BlockLength; i += 16)
+                {
+                    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+
+                    masks.Quotes |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quote)))) << i;
+                    masks.Delimiters |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, separator)))) << i;
+                    masks.LineFeeds |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, lineFeed)))) << i;
+                }
+#else
+                masks.Quotes = masks.Delimiters = masks.LineFeeds = 0;
+
+                for (size_t i = 0; i < BlockLength; ++i)
+                {
+                    const uint64_t bit = static_cast<uint64_t>(1) << i;
+
+                    masks.Quotes |= block[i] == '"' ? bit : 0;
+                    masks.Delimiters |= block[i] == delimiter ? bit : 0;
+                    masks.LineFeeds |= block[i] == '\n' ? bit : 0;
+                }
+#endif
+            }
+
+            // bit i of the result is the xor of bits 0..i, computed in log steps within the register
+            static uint64_t PrefixXor(uint64_t bits)
+            {
+                bits ^= bits << 1;
+                bits ^= bits << 2;
+                bits ^= bits << 4;
+                bits ^= bits << 8;
+                bits ^= bits << 16;
+                bits ^= bits << 32;
+
+                return bits;
+            }
+
+        private:
+            template <typename TCallback>
+            static void ScanBlock(const char* block, const size_t offset, const char delimiter, uint64_t& carry, TCallback& onBlock)
+            {
+                TBlockMasks masks;
+                Classify(block, delimiter, masks);
+
+                const uint64_t quoted = PrefixXor(masks.Quotes) ^ carry;
+                carry = static_cast<uint64_t>(0) - (quoted >> 63);
+
+                const uint64_t separators = (masks.Delimiters | masks.LineFeeds) & ~quoted;
+
+                if (separators != 0)
+                {
+                    onBlock(offset, separators, masks.LineFeeds & separators);
+                }
+            }
+
+#if CMT_SIMD_AVX2
+            static uint64_t Combine32(const int low, const int high)
+            {
+                return static_cast<uint64_t>(static_cast<uint32_t>(low)) | static_cast<uint64_t>(static_cast<uint32_t>(high)) << 32;
+            }
+#endif
+        };
+    }
+}
@@ -0,0 +1,470 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <Common/BuildConfig.hpp>
+#include <Common/Details/Simd.hpp>
+
+namespace CppMiniToolkit
+{
+    namespace Details
+    {
+        // byte to text lookup tables, built once
+        struct TCodecDecodeTable
+        {
+            constexpr static uint8_t Invalid = 0xFF;
+
+            uint8_t Values[256];
+
+            explicit TCodecDecodeTable(const char* alphabet)
+            {
+                memset(Values, Invalid, sizeof(Values));
+
+                for (uint8_t i = 0; alphabet[i] != 0; ++i)
+                {
+                    Values[static_cast<uint8_t>(alphabet[i])] = i;
+                }
+            }
+        };
+
+        // hexadecimal, two digits per byte with the high nibble first
+        // decoding accepts both cases
+        class THexKernels
+        {
+        public:
+            static void Encode(const uint8_t* source, const size_t length, char* destination, const bool upper)
+            {
+                const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+                size_t i = 0;
+
+#if CMT_SIMD_AVX2
+                {
+                    const __m256i table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(digits)));
+                    const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+                    for (; i + 32 <= length; i += 32)
+                    {
+                        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+                        const __m256i high = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble));
+                        const __m256i low = _mm256_shuffle_epi8(table, _mm256_and_si256(block, nibble));
+
+                        // unpack works inside the 128 bit lanes, the lanes are put back in order afterwards
+                        const __m256i first = _mm256_unpacklo_epi8(high, low);
+                        const __m256i second = _mm256_unpackhi_epi8(high, low);
+
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 2), _mm256_permute2x128_si256(first, second, 0x20));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 2 + 32), _mm256_permute2x128_si256(first, second, 0x31));
+                    }
+                }
+#endif
+
+#if CMT_SIMD_SSSE3
+                {
+                    const __m128i table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits));
+                    const __m128i nibble = _mm_set1_epi8(0x0F);
+
+                    for (; i + 16 <= length; i += 16)
+                    {
+                        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                        const __m128i high = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(block, 4), nibble));
+                        const __m128i low = _mm_shuffle_epi8(table, _mm_and_si128(block, nibble));
+
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 2), _mm_unpacklo_epi8(high, low));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 2 + 16), _mm_unpackhi_epi8(high, low));
+                    }
+                }
+#endif
+
+                for (; i < length; ++i)
+                {
+                    destination[i * 2] = digits[source[i] >> 4];
+                    destination[i * 2 + 1] = digits[source[i] & 0x0F];
+                }
+            }
+
+            // length is the number of digits and must be even, false on any other character
+            static bool Decode(const char* source, const size_t length, uint8_t* destination)
+            {
+                if (length % 2 != 0)
+                {
+                    return false;
+                }
+
+                size_t i = 0;
+
+#if CMT_SIMD_AVX2
+                for (; i + 64 <= length; i += 64)
+                {
+                    __m256i first;
+                    __m256i second;
+
+                    if (!DecodeValues256(source + i, first) || !DecodeValues256(source + i + 32, second))
+                    {
+                        return false;
+                    }
+
+                    // the pack works inside the 128 bit lanes, the quadwords are put back in order afterwards
+                    const __m256i bytes = _mm256_packus_epi16(CombinePairs256(first), CombinePairs256(second));
+
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i / 2), _mm256_permute4x64_epi64(bytes, 0xD8));
+                }
+#endif
+
+#if CMT_SIMD_SSSE3
+                for (; i + 32 <= length; i += 32)
+                {
+                    __m128i first;
+                    __m128i second;
+
+                    if (!DecodeValues128(source + i, first) || !DecodeValues128(source + i + 16, second))
+                    {
+                        return false;
+                    }
+
+                    const __m128i weights = _mm_set1_epi16(0x0110);
+
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i / 2), _mm_packus_epi16(_mm_maddubs_epi16(first, weights), _mm_maddubs_epi16(second, weights)));
+                }
+#endif
+
+                static const TCodecDecodeTable S_Table("0123456789abcdef");
+                static const TCodecDecodeTable S_UpperTable("0123456789ABCDEF");
+
+                for (; i < length; i += 2)
+                {
+                    const uint8_t high = Lookup(S_Table, S_UpperTable, source[i]);
+                    const uint8_t low = Lookup(S_Table, S_UpperTable, source[i + 1]);
+
+                    if ((high | low) > 0x0F)
+                    {
+                        return false;
+                    }
+
+                    destination[i / 2] = static_cast<uint8_t>(high << 4 | low);
+                }
+
+                return true;
+            }
+
+        private:
+            static uint8_t Lookup(const TCodecDecodeTable& lower, const TCodecDecodeTable& upper, const char ch)
+            {
+                const uint8_t value = lower.Values[static_cast<uint8_t>(ch)];
+
+                return value != TCodecDecodeTable::Invalid ? value : upper.Values[static_cast<uint8_t>(ch)];
+            }
+
+#if CMT_SIMD_SSSE3
+            // the nibble value of every digit, false when a character is not a digit
+            static bool DecodeValues128(const char* source, __m128i& values)
+            {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+                const __m128i digits = _mm_sub_epi8(block, _mm_set1_epi8('0'));
+                const __m128i letters = _mm_sub_epi8(_mm_or_si128(block, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+
+                // unsigned range checks: digits in 0..9, letters in 0..5
+                const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+                const __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letters, _mm_set1_epi8(5)), letters);
+
+                values = _mm_or_si128(_mm_and_si128(isDigit, digits), _mm_and_si128(isLetter, _mm_add_epi8(letters, _mm_set1_epi8(10))));
+
+                return _mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) == 0xFFFF;
+            }
+#endif
+
+#if CMT_SIMD_AVX2
+            static bool DecodeValues256(const char* source, __m256i& values)
+            {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source));
+                const __m256i digits = _mm256_sub_epi8(block, _mm256_set1_epi8('0'));
+                const __m256i letters = _mm256_sub_epi8(_mm256_or_si256(block, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+
+                const __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digits, _mm256_set1_epi8(9)), digits);
+                const __m256i isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letters, _mm256_set1_epi8(5)), letters);
+
+                values = _mm256_or_si256(_mm256_and_si256(isDigit, digits), _mm256_and_si256(isLetter, _mm256_add_epi8(letters, _mm256_set1_epi8(10))));
+
+                return _mm256_movemask_epi8(_mm256_or_si256(isDigit, isLetter)) == -1;
+            }
+
+            // high * 16 + low for every pair of nibbles, one per 16 bit lane
+            static __m256i CombinePairs256(const __m256i values)
+            {
+                return _mm256_maddubs_epi16(values, _mm256_set1_epi16(0x0110));
+            }
+#endif
+        };
+
+        // Base64 of RFC 4648 with the standard alphabet and '=' padding
+        // the SIMD paths follow Muła and Lemire, "Faster Base64 Encoding and Decoding using AVX2 Instructions"
+        class TBase64Kernels
+        {
+        public:
+            static const char* GetAlphabet()
+            {
+                return "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            }
+
+            // writes (length + 2) / 3 * 4 characters
+            static void Encode(const uint8_t* source, const size_t length, char* destination)
+            {
+                const char* alphabet = GetAlphabet();
+                size_t i = 0;
+                char* output = destination;
+
+#if CMT_SIMD_AVX2
+                // two 16 byte loads of which 12 bytes are used
+                for (; i + 28 <= length; i += 24)
+                {
+                    const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                    const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i + 12));
+                    const __m256i block = _mm256_inserti128_si256(_mm256_castsi128_si256(first), second, 1);
+
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), EncodeBlock256(block));
+                    output += 32;
+                }
+#endif
+
+#if CMT_SIMD_SSSE3
+                for (; i + 16 <= length; i += 12)
+                {
+                    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(output), EncodeBlock128(block));
+                    output += 16;
+                }
+#endif
+
+                for (; i + 3 <= length; i += 3)
+                {
+                    const uint32_t triple = static_cast<uint32_t>(source[i]) << 16 | static_cast<uint32_t>(source[i + 1]) << 8 | source[i + 2];
+
+                    output[0] = alphabet[triple >> 18];
+                    output[1] = alphabet[(triple >> 12) & 0x3F];
+                    output[2] = alphabet[(triple >> 6) & 0x3F];
+                    output[3] = alphabet[triple & 0x3F];
+                    output += 4;
+                }
+
+                if (i < length)
+                {
+                    const uint32_t triple = static_cast<uint32_t>(source[i]) << 16 | (i + 1 < length ? static_cast<uint32_t>(source[i + 1]) << 8 : 0);
+
+                    output[0] = alphabet[triple >> 18];
+                    output[1] = alphabet[(triple >> 12) & 0x3F];
+                    output[2] = i + 1 < length ? alphabet[(triple >> 6) & 0x3F] : '=';
+                    output[3] = '=';
+                }
+            }
+
+            // bytes encoded by length characters, 0 when length is not a multiple of 4
+            static size_t GetDecodedLength(const char* source, const size_t length)
+            {
+                if (length % 4 != 0 || length == 0)
+                {
+                    return 0;
+                }
+
+                return length / 4 * 3 - (source[length - 1] == '=' ? 1 : 0) - (source[length - 2] == '=' ? 1 : 0);
+            }
+
+            // length must be a multiple of 4 with at most two '=' at the end,
+            // destination receives GetDecodedLength bytes. false on any other character
+            static bool Decode(const char* source, const size_t length, uint8_t* destination)
+            {
+                if (length % 4 != 0)
+                {
+                    return false;
+                }
+
+                size_t i = 0;
+                uint8_t* output = destination;
+
+                // the blocks store 4 or 8 bytes more than they decode, so they stop well before the padding
+#if CMT_SIMD_AVX2
+                for (; i + 48 <= length; i += 32)
+                {
+                    __m256i bytes;
+
+                    if (!DecodeBlock256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i)), bytes))
+                    {
+                        return false;
+                    }
+
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), bytes);
+                    output += 24;
+                }
+#endif
+
+#if CMT_SIMD_SSSE3
+                for (; i + 24 <= length; i += 16)
+                {
+                    __m128i bytes;
+
+                    if (!DecodeBlock128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i)), bytes))
+                    {
+                        return false;
+                    }
+
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(output), bytes);
+                    output += 12;
+                }
+#endif
+
+                static const TCodecDecodeTable S_Table(GetAlphabet());
+
+                for (; i < length; i += 4)
+                {
+                    const uint8_t* values = S_Table.Values;
+                    const uint8_t a = values[static_cast<uint8_t>(source[i])];
+                    const uint8_t b = values[static_cast<uint8_t>(source[i + 1])];
+                    uint8_t c = values[static_cast<uint8_t>(source[i + 2])];
+                    uint8_t d = values[static_cast<uint8_t>(source[i + 3])];
+
+                    // padding only in the last quantum: "xx==" or "xxx="
+                    size_t count = 3;
+
+                    if (i + 4 == length && source[i + 3] == '=')
+                    {
+                        count = source[i + 2] == '=' ? 1 : 2;
+                        c = count == 1 ? 0 : c;
+                        d = 0;
+                    }
+
+                    // Invalid has the high bits set that no 6 bit value has
+                    if (((a | b | c | d) & 0xC0) != 0)
+                    {
+                        return false;
+                    }
+
+                    const uint32_t triple = static_cast<uint32_t>(a) << 18 | static_cast<uint32_t>(b) << 12 | static_cast<uint32_t>(c) << 6 | d;
+
+                    output[0] = static_cast<uint8_t>(triple >> 16);
+
+                    if (count > 1)
+                    {
+                        output[1] = static_cast<uint8_t>(triple >> 8);
+                    }
+
+                    if (count > 2)
+                    {
+                        output[2] = static_cast<uint8_t>(triple);
+                    }
+
+                    output += count;
+                }
+
+                return true;
+            }
+
+        private:
+#if CMT_SIMD_SSSE3
+            // 12 bytes in the low part of block to 16 characters
+            static __m128i EncodeBlock128(__m128i block)
+            {
+                // every 3 bytes s0 s1 s2 become the 32 bit word s1 s0 s2 s1, then each 6 bit index moves to a byte of its own
+                block = _mm_shuffle_epi8(block, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+                const __m128i first = _mm_mulhi_epu16(_mm_and_si128(block, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+                const __m128i second = _mm_mullo_epi16(_mm_and_si128(block, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+                const __m128i indices = _mm_or_si128(first, second);
+
+                // the offset from index to character for the ranges A-Z, a-z, 0-9, + and /
+                __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+                range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+
+                const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+                return _mm_add_epi8(_mm_shuffle_epi8(offsets, range), indices);
+            }
+
+            // 16 characters to 12 bytes in the low part of bytes, false when a character is outside of the alphabet
+            static bool DecodeBlock128(const __m128i block, __m128i& bytes)
+            {
+                const __m128i highNibbles = _mm_and_si128(_mm_srli_epi32(block, 4), _mm_set1_epi8(0x0F));
+                const __m128i lowNibbles = _mm_and_si128(block, _mm_set1_epi8(0x0F));
+
+                // a character is valid when the bits for its low and high nibble have nothing in common
+                const __m128i lowBits = _mm_shuffle_epi8(_mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A), lowNibbles);
+                const __m128i highBits = _mm_shuffle_epi8(_mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10), highNibbles);
+
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lowBits, highBits), _mm_setzero_si128())) != 0xFFFF)
+                {
+                    return false;
+                }
+
+                // '/' shares its high nibble with '+' but needs another offset
+                const __m128i isSlash = _mm_cmpeq_epi8(block, _mm_set1_epi8('/'));
+                const __m128i offsets = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+                const __m128i values = _mm_add_epi8(block, _mm_shuffle_epi8(offsets, _mm_add_epi8(isSlash, highNibbles)));
+
+                // 4 x 6 bits to 24 bits in every 32 bit word, then the 3 bytes of every word in big endian order
+                const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+                const __m128i words = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+
+                bytes = _mm_shuffle_epi8(words, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+                return true;
+            }
+#endif
+
+#if CMT_SIMD_AVX2
+            static __m256i EncodeBlock256(__m256i block)
+            {
+                block = _mm256_shuffle_epi8(block, _mm256_set_epi8(
+                    10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+                    10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+                const __m256i first = _mm256_mulhi_epu16(_mm256_and_si256(block, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+                const __m256i second = _mm256_mullo_epi16(_mm256_and_si256(block, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+                const __m256i indices = _mm256_or_si256(first, second);
+
+                __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+                range = _mm256_or_si256(range, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+
+                const __m256i offsets = _mm256_setr_epi8(
+                    'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+                    'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+                return _mm256_add_epi8(_mm256_shuffle_epi8(offsets, range), indices);
+            }
+
+            // 32 characters to 24 bytes in the low part of bytes
+            static bool DecodeBlock256(const __m256i block, __m256i& bytes)
+            {
+                const __m256i highNibbles = _mm256_and_si256(_mm256_srli_epi32(block, 4), _mm256_set1_epi8(0x0F));
+                const __m256i lowNibbles = _mm256_and_si256(block, _mm256_set1_epi8(0x0F));
+
+                const __m256i lowBits = _mm256_shuffle_epi8(_mm256_setr_epi8(
+                    0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                    0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A), lowNibbles);
+                const __m256i highBits = _mm256_shuffle_epi8(_mm256_setr_epi8(
+                    0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                    0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10), highNibbles);
+
+                if (!_mm256_testz_si256(lowBits, highBits))
+                {
+                    return false;
+                }
+
+                const __m256i isSlash = _mm256_cmpeq_epi8(block, _mm256_set1_epi8('/'));
+                const __m256i offsets = _mm256_setr_epi8(
+                    0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                    0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+                const __m256i values = _mm256_add_epi8(block, _mm256_shuffle_epi8(offsets, _mm256_add_epi8(isSlash, highNibbles)));
+
+                const __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+                const __m256i words = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+                const __m256i packed = _mm256_shuffle_epi8(words, _mm256_setr_epi8(
+                    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+                // 12 bytes at the start of each lane, moved next to each other
+                bytes = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+                return true;
+            }
+#endif
+        };
+    }
+}
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <Common/BuildConfig.hpp>
+#include <Common/DynamicBuffer.hpp>
+#include <Common/StringRef.hpp>
+#include <Text/Details/HexBase64Kernels.hpp>
+
+namespace CppMiniToolkit
+{
+    // bytes to hexadecimal text and back, e.g. for digests: HexCodec::Encode(md5.Bytes, 16)
+    // encoding writes two digits per byte, decoding accepts upper and lower case digits
+    class HexCodec
+    {
+    public:
+        CMT_DECLARE_TOOLKIT_CLASS_TYPE(HexCodec);
+
+        static size_t GetEncodedLength(const size_t length)
+        {
+            return length * 2;
+        }
+
+        // writes GetEncodedLength(length) characters without terminating zero, returns the end of them
+        static char* Encode(char* output, const void* data, const size_t length, const bool upper = false)
+        {
+            Details::THexKernels::Encode(static_cast<const uint8_t*>(data), length, output, upper);
+
+            return output + GetEncodedLength(length);
+        }
+
+        static std::string Encode(const void* data, const size_t length, const bool upper = false)
+        {
+            std::string result;
+            return EncodeInto(result, data, length, upper);
+        }
+
+        // append the text to output
+        static std::string& EncodeInto(std::string& output, const void* data, const size_t length, const bool upper = false)
+        {
+            const size_t offset = output.size();
+
+            output.resize(offset + GetEncodedLength(length));
+
+            if (length > 0)
+            {
+                Encode(&output[offset], data, length, upper);
+            }
+
+            return output;
+        }
+
+        template <int AlignLength>
+        static TDynamicBuffer<AlignLength>& EncodeInto(TDynamicBuffer<AlignLength>& output, const void* data, const size_t length, const bool upper = false)
+        {
+            const size_t offset = output.GetSize();
+
+            if (length > 0)
+            {
+                output.Resize(offset + GetEncodedLength(length));
+                Encode(reinterpret_cast<char*>(output.GetData(offset)), data, length, upper);
+            }
+
+            return output;
+        }
+
+        static size_t GetDecodedLength(const size_t length)
+        {
+            return length / 2;
+        }
+
+        // writes GetDecodedLength(length) bytes, false when length is odd or a character is not a digit
+        static bool Decode(void* output, const char* text, const size_t length)
+        {
+            return Details::THexKernels::Decode(text, length, static_cast<uint8_t*>(output));
+        }
+
+        // append the bytes to output, which is left as it was when text is not valid
+        static bool DecodeInto(std::string& output, const StringRef& text)
+        {
+            const size_t offset = output.size();
+
+            output.resize(offset + GetDecodedLength(text.GetLength()));
+
+            if (!Decode(&output[0] + offset, text.GetData(), text.GetLength()))
+            {
+                output.resize(offset);
+                return false;
+            }
+
+            return true;
+        }
+
+        template <int AlignLength>
+        static bool DecodeInto(TDynamicBuffer<AlignLength>& output, const StringRef& text)
+        {
+            const size_t offset = output.GetSize();
+
+            if (text.GetLength() % 2 != 0)
+            {
+                return false;
+            }
+
+            if (text.IsEmpty())
+            {
+                return true;
+            }
+
+            output.Resize(offset + GetDecodedLength(text.GetLength()));
+
+            if (!Decode(output.GetData(offset), text.GetData(), text.GetLength()))
+            {
+                output.Resize(offset);
+                return false;
+            }
+
+            return true;
+        }
+    };
+
+    // Base64 of RFC 4648: standard alphabet, '=' padding, no line breaks
+    class Base64Codec
+    {
+    public:
+        CMT_DECLARE_TOOLKIT_CLASS_TYPE(Base64Codec);
+
+        static size_t GetEncodedLength(const size_t length)
+        {
+            return (length + 2) / 3 * 4;
+        }
+
+        // writes GetEncodedLength(length) characters without terminating zero, returns the end of them
+        static char* Encode(char* output, const void* data, const size_t length)
+        {
+            Details::TBase64Kernels::Encode(static_cast<const uint8_t*>(data), length, output);
+
+            return output + GetEncodedLength(length);
+        }
+
+        static std::string Encode(const void* data, const size_t length)
+        {
+            std::string result;
+            return EncodeInto(result, data, length);
+        }
+
+        // append the text to output
+        static std::string& EncodeInto(std::string& output, const void* data, const size_t length)
+        {
+            const size_t offset = output.size();
+
+            output.resize(offset + GetEncodedLength(length));
+
+            if (length > 0)
+            {
+                Encode(&output[offset], data, length);
+            }
+
+            return output;
+        }
+
+        template <int AlignLength>
+        static TDynamicBuffer<AlignLength>& EncodeInto(TDynamicBuffer<AlignLength>& output, const void* data, const size_t length)
+        {
+            const size_t offset = output.GetSize();
+
+            if (length > 0)
+            {
+                output.Resize(offset + GetEncodedLength(length));
+                Encode(reinterpret_cast<char*>(output.GetData(offset)), data, length);
+            }
+
+            return output;
+        }
+
+        // bytes encoded by text, 0 when its length is not a multiple of 4
+        static size_t GetDecodedLength(const char* text, const size_t length)
+        {
+            return Details::TBase64Kernels::GetDecodedLength(text, length);
+        }
+
+        // writes GetDecodedLength(text, length) bytes, false when text is not valid Base64
+        static bool Decode(void* output, const char* text, const size_t length)
+        {
+            return Details::TBase64Kernels::Decode(text, length, static_cast<uint8_t*>(output));
+        }
+
+        // append the bytes to output, which is left as it was when text is not valid
+        static bool DecodeInto(std::string& output, const StringRef& text)
+        {
+            if (text.GetLength() % 4 != 0)
+            {
+                return false;
+            }
+
+            const size_t offset = output.size();
+
+            output.resize(offset + GetDecodedLength(text.GetData(), text.GetLength()));
+
+            if (!Decode(&output[0] + offset, text.GetData(), text.GetLength()))
+            {
+                output.resize(offset);
+                return false;
+            }
+
+            return true;
+        }
+
+        template <int AlignLength>
+        static bool DecodeInto(TDynamicBuffer<AlignLength>& output, const StringRef& text)
+        {
+            if (text.GetLength() % 4 != 0)
+            {
+                return false;
+            }
+
+            if (text.IsEmpty())
+            {
+                return true;
+            }
+
+            const size_t offset = output.GetSize();
+
+            output.Resize(offset + GetDecodedLength(text.GetData(), text.GetLength()));
+
+            if (!Decode(output.GetData(offset), text.GetData(), text.GetLength()))
+            {
+                output.Resize(offset);
+                return false;
+            }
+
+            return true;
+        }
+    };
+}
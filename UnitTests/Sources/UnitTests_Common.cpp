@@ -1,6 +1,24 @@
 #include <gtest/gtest.h>
 #include <Common/DynamicBuffer.hpp>
 #include <Common/HasSignature.hpp>
+#include <Common/CharSet.hpp>
+#include <Common/AsciiCharTraits.hpp>
+#include <Common/Hash.hpp>
+#include <Common/FlatHashMap.hpp>
+#include <Common/StringPool.hpp>
+#include <Common/InlineString.hpp>
+#include <Common/StringBuilder.hpp>
+#include <unordered_map>
+#include <unordered_set>
+#include <random>
+#include <thread>
+#include <vector>
+#include <cctype>
+#include <cstring>
+#include <cstdio>
+#include <climits>
+#include <cmath>
+#include <string>
 
 using namespace CppMiniToolkit;
 
@@ -109,3 +127,833 @@ struct NoFoo {};
 static_assert(HasStaticFooMemberFunction<StaticFoo>::Value, "Unexpected value");
 static_assert(!HasStaticFooMemberFunction<NormalFoo>::Value, "Unexpected value");
 static_assert(!HasStaticFooMemberFunction<NoFoo>::Value, "Unexpected value");
+
+TEST(CharSet, Membership)
+{
+    CharSet set(" ,;");
+    EXPECT_TRUE(set.Contains(' '));
+    EXPECT_TRUE(set(','));
+    EXPECT_FALSE(set.Contains('a'));
+    EXPECT_FALSE(set.Contains('\0'));
+
+    set.Add(static_cast<char>(0xE9));
+    EXPECT_TRUE(set.Contains(static_cast<char>(0xE9)));
+
+    const auto spaces = CharSet::FromPredicate(TCharTraits<char>::IsSpace);
+    EXPECT_TRUE(spaces.Contains('\t'));
+    EXPECT_TRUE(spaces.Contains('\n'));
+    EXPECT_FALSE(spaces.Contains('x'));
+
+    const auto wideSpaces = WCharSet::FromPredicate(TCharTraits<wchar_t>::IsSpace);
+    EXPECT_TRUE(wideSpaces.Contains(L' '));
+    EXPECT_FALSE(wideSpaces.Contains(static_cast<wchar_t>(0x120)));
+}
+
+TEST(CharSet, Find)
+{
+    // every byte value in every position of the SIMD blocks
+    for (int member = 0; member < 256; ++member)
+    {
+        CharSet set;
+        set.Add(static_cast<char>(member));
+
+        std::string text(70, static_cast<char>(member == 'x' ? 'y' : 'x'));
+        EXPECT_EQ(set.FindFirstOf(text.c_str(), text.size()), nullptr);
+        EXPECT_EQ(set.FindFirstNotOf(text.c_str(), text.size()), text.c_str());
+
+        for (size_t position : { 0, 15, 16, 31, 33, 69 })
+        {
+            std::string probe = text;
+            probe[position] = static_cast<char>(member);
+
+            EXPECT_EQ(set.FindFirstOf(probe.c_str(), probe.size()), probe.c_str() + position);
+            EXPECT_EQ(set.FindLastOf(probe.c_str(), probe.size()), probe.c_str() + position);
+        }
+    }
+
+    const CharSet digits("0123456789");
+    const std::string number = "0000000000000000000000000000000000000012345x6";
+    EXPECT_EQ(digits.FindFirstNotOf(number.c_str(), number.size()), number.c_str() + 43);
+    EXPECT_EQ(digits.FindLastNotOf(number.c_str(), number.size()), number.c_str() + 43);
+    EXPECT_EQ(digits.FindLastNotOf(number.c_str(), 43), nullptr);
+
+    // wide characters above 255 are never members, even if their low byte is
+    const WCharSet wide(L"a;");
+    std::wstring wideText(40, static_cast<wchar_t>(0x100 | L'a'));
+    EXPECT_EQ(wide.FindFirstOf(wideText.c_str(), wideText.size()), nullptr);
+    wideText[37] = L';';
+    wideText[20] = L'a';
+    EXPECT_EQ(wide.FindFirstOf(wideText.c_str(), wideText.size()), wideText.c_str() + 20);
+    EXPECT_EQ(wide.FindLastOf(wideText.c_str(), wideText.size()), wideText.c_str() + 37);
+    EXPECT_EQ(wide.FindFirstNotOf(wideText.c_str() + 20, 1), nullptr);
+}
+
+TEST(AsciiCharTraits, MatchesCLocale)
+{
+    // the tests run in the "C" locale
+    for (int i = 0; i < 256; ++i)
+    {
+        const auto ch = static_cast<char>(i);
+        const int value = i < 128 ? i : EOF;
+
+        EXPECT_EQ(AsciiCharTraits::IsAlnum(ch) != 0, i < 128 && isalnum(value) != 0) << i;
+        EXPECT_EQ(AsciiCharTraits::IsAlpha(ch) != 0, i < 128 && isalpha(value) != 0) << i;
+        EXPECT_EQ(AsciiCharTraits::IsLower(ch) != 0, i < 128 && islower(value) != 0) << i;
+        EXPECT_EQ(AsciiCharTraits::IsUpper(ch) != 0, i < 128 && isupper(value) != 0) << i;
+        EXPECT_EQ(AsciiCharTraits::IsDigit(ch) != 0, i < 128 && isdigit(value) != 0) << i;
+        EXPECT_EQ(AsciiCharTraits::IsXDigit(ch) != 0, i < 128 && isxdigit(value) != 0) << i;
+        EXPECT_EQ(AsciiCharTraits::IsCntrl(ch) != 0, i < 128 && iscntrl(value) != 0) << i;
+        EXPECT_EQ(AsciiCharTraits::IsGraph(ch) != 0, i < 128 && isgraph(value) != 0) << i;
+        EXPECT_EQ(AsciiCharTraits::IsPrint(ch) != 0, i < 128 && isprint(value) != 0) << i;
+        EXPECT_EQ(AsciiCharTraits::IsPunct(ch) != 0, i < 128 && ispunct(value) != 0) << i;
+        EXPECT_EQ(AsciiCharTraits::IsSpace(ch) != 0, i < 128 && isspace(value) != 0) << i;
+        EXPECT_EQ(static_cast<char>(AsciiCharTraits::ToLower(ch)), i < 128 ? static_cast<char>(tolower(i)) : ch) << i;
+        EXPECT_EQ(static_cast<char>(AsciiCharTraits::ToUpper(ch)), i < 128 ? static_cast<char>(toupper(i)) : ch) << i;
+    }
+
+    EXPECT_EQ(AsciiCharTraits::iCompare("Hello World", "hELLO wORLD"), 0);
+    EXPECT_LT(AsciiCharTraits::iCompare("abc", "ABD"), 0);
+    EXPECT_GT(AsciiCharTraits::iCompare("abcd", "ABC"), 0);
+    EXPECT_EQ(AsciiCharTraits::iCompareN("PREFIX-a", "prefix-b", 7), 0);
+    EXPECT_NE(AsciiCharTraits::iCompareN("PREFIX-a", "prefix-b", 8), 0);
+    EXPECT_EQ(AsciiCharTraits::iCompareN("ab", "AB", 10), 0);
+}
+
+TEST(StringHash, Calculate)
+{
+    std::unordered_set<uint64_t> hashes;
+    std::string text;
+
+    for (int i = 0; i < 200; ++i)
+    {
+        hashes.insert(StringHash::Calculate(text));
+        text += static_cast<char>('a' + i % 26);
+    }
+
+    // lengths and contents are all distinct
+    EXPECT_EQ(hashes.size(), 200u);
+    EXPECT_NE(StringHash::Calculate(std::string("abc")), StringHash::Calculate(std::string("abd")));
+    EXPECT_NE(StringHash::Calculate(std::string("abc")), StringHash::Calculate(std::string("abc"), 1));
+    EXPECT_EQ(StringHash::Calculate(StringRef("hello world")), StringHash::Calculate(std::string("hello world")));
+    EXPECT_NE(StringHash::Calculate(std::string("a\0", 2)), StringHash::Calculate(std::string("a")));
+}
+
+TEST(StringHash, IgnoreCase)
+{
+    std::string lower;
+    std::string mixed;
+
+    for (int i = 0; i < 150; ++i)
+    {
+        const char ch = i % 5 == 0 ? '[' : (i % 7 == 0 ? '\xC9' : static_cast<char>('a' + i % 26));
+        lower += ch;
+        mixed += i % 3 == 0 ? static_cast<char>(AsciiCharTraits::ToUpper(ch)) : ch;
+
+        EXPECT_EQ(StringHash::iCalculate(lower), StringHash::iCalculate(mixed)) << i;
+        EXPECT_TRUE(StringHash::iEqual(StringRef(lower), StringRef(mixed))) << i;
+    }
+
+    EXPECT_NE(StringHash::iCalculate(std::string("@")), StringHash::iCalculate(std::string("`")));
+    EXPECT_FALSE(StringHash::iEqual(StringRef("abc@"), StringRef("ABC`")));
+    EXPECT_FALSE(StringHash::iEqual(StringRef("abc"), StringRef("abcd")));
+
+    std::wstring wideLower;
+    std::wstring wideMixed;
+
+    for (int i = 0; i < 60; ++i)
+    {
+        const wchar_t ch = i % 9 == 0 ? static_cast<wchar_t>(0x4E2D) : static_cast<wchar_t>(L'a' + i % 26);
+        wideLower += ch;
+        wideMixed += i % 2 == 0 ? static_cast<wchar_t>(towupper(ch)) : ch;
+
+        EXPECT_EQ(StringHash::iCalculate(wideLower), StringHash::iCalculate(wideMixed)) << i;
+        EXPECT_TRUE(StringHash::iEqual(WStringRef(wideLower), WStringRef(wideMixed))) << i;
+    }
+
+    std::unordered_map<std::string, int, iHash, iEqualTo> map;
+    map["Content-Type"] = 1;
+    map["content-length"] = 2;
+
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_EQ(map.at("CONTENT-TYPE"), 1);
+    EXPECT_EQ(map.at("Content-Length"), 2);
+    EXPECT_EQ(map.count("Content-Encoding"), 0u);
+
+    std::unordered_map<std::wstring, int, iWHash, iWEqualTo> wideMap;
+    wideMap[L"Key"] = 3;
+    EXPECT_EQ(wideMap.at(L"kEY"), 3);
+
+    std::unordered_map<std::string, int, Hash> plainMap;
+    plainMap["Key"] = 4;
+    EXPECT_EQ(plainMap.count("key"), 0u);
+}
+
+TEST(FlatHashMap, InsertFindErase)
+{
+    TFlatHashMap<int, int> map;
+    EXPECT_TRUE(map.IsEmpty());
+    EXPECT_EQ(map.GetCapacity(), 0u);
+    EXPECT_TRUE(map.Find(1) == map.end());
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_TRUE(map.Insert(i, i * 2).second);
+    }
+
+    EXPECT_FALSE(map.Insert(10, 0).second);
+    EXPECT_EQ(map.GetSize(), 1000u);
+    EXPECT_LE(map.GetLoadFactor(), 0.875f);
+
+    for (int i = 0; i < 1000; i += 2)
+    {
+        EXPECT_EQ(map.Erase(i), 1u);
+    }
+
+    EXPECT_EQ(map.Erase(0), 0u);
+    EXPECT_EQ(map.GetSize(), 500u);
+
+    int sum = 0;
+    for (const auto& pair : map)
+    {
+        EXPECT_EQ(pair.first % 2, 1);
+        EXPECT_EQ(pair.second, pair.first * 2);
+        sum += pair.first;
+    }
+
+    EXPECT_EQ(sum, 250000);
+
+    for (auto iter = map.begin(); iter != map.end();)
+    {
+        iter = iter->first % 3 == 0 ? map.Erase(iter) : std::next(iter);
+    }
+
+    EXPECT_FALSE(map.Contains(3));
+    EXPECT_TRUE(map.Contains(5));
+    EXPECT_EQ(*map.TryGet(5), 10);
+    EXPECT_EQ(map.TryGet(6), nullptr);
+
+    map[5] = 7;
+    map[2000] += 3;
+    EXPECT_EQ(map[5], 7);
+    EXPECT_EQ(map[2000], 3);
+
+    TFlatHashMap<int, int> copy = map;
+    map.Clear();
+    EXPECT_TRUE(map.IsEmpty());
+    EXPECT_FALSE(map.Contains(5));
+    EXPECT_EQ(copy[5], 7);
+    EXPECT_EQ(copy.GetSize(), 334u);
+}
+
+TEST(FlatHashMap, ReserveRehash)
+{
+    TFlatHashMap<int, std::string> map;
+    map.Reserve(100);
+
+    const size_t capacity = map.GetCapacity();
+    EXPECT_GE(capacity, 100u);
+    EXPECT_EQ(map.GetMemoryUsage(), sizeof(map) + capacity * (1 + sizeof(std::pair<const int, std::string>)));
+
+    for (int i = 0; i < 100; ++i)
+    {
+        map.Insert(i, std::to_string(i));
+    }
+
+    // reserved room is used without growing
+    EXPECT_EQ(map.GetCapacity(), capacity);
+
+    for (int i = 0; i < 60; ++i)
+    {
+        map.Erase(i);
+    }
+
+    // insert and erase cycles reuse deleted slots or clean them up instead of growing
+    for (int i = 100; i < 10000; ++i)
+    {
+        map.Insert(i, std::to_string(i));
+        map.Erase(i - 40);
+    }
+
+    EXPECT_EQ(map.GetCapacity(), capacity);
+    EXPECT_EQ(map.GetSize(), 40u);
+
+    map.Reserve(10);
+    EXPECT_EQ(map.GetCapacity(), capacity);
+
+    map.Rehash(5000);
+    EXPECT_GE(map.GetCapacity(), 5000u);
+    EXPECT_EQ(*map.TryGet(9999), "9999");
+
+    map.Rehash(0);
+    EXPECT_EQ(map.GetCapacity(), 64u);
+
+    for (int i = 9960; i < 10000; ++i)
+    {
+        EXPECT_EQ(*map.TryGet(i), std::to_string(i));
+    }
+
+    map.Clear();
+    map.Rehash(0);
+    EXPECT_EQ(map.GetCapacity(), 0u);
+}
+
+TEST(FlatHashMap, StringKeys)
+{
+    TFlatHashMap<std::string, int> map = { { "alpha", 1 }, { "beta", 2 } };
+
+    const char text[] = "alpha,beta,gamma";
+
+    // lookups by reference do not build a std::string
+    EXPECT_EQ(*map.TryGet(StringRef(text, 5)), 1);
+    EXPECT_EQ(*map.TryGet(StringRef(text + 6, 4)), 2);
+    EXPECT_EQ(map.TryGet(StringRef(text + 11, 5)), nullptr);
+    EXPECT_TRUE(map.Contains("beta"));
+    EXPECT_TRUE(map.Contains(std::string("alpha")));
+
+    // the key is only constructed when it is missing
+    EXPECT_FALSE(map.Emplace(StringRef(text, 5), 10).second);
+    EXPECT_TRUE(map.Emplace(StringRef(text + 11, 5), 3).second);
+    EXPECT_EQ(map["gamma"], 3);
+    EXPECT_EQ(map.Erase(StringRef(text + 6, 4)), 1u);
+    EXPECT_EQ(map.GetSize(), 2u);
+
+    TFlatHashMap<std::string, int, iHash, iEqualTo> headers;
+    headers["Content-Type"] = 1;
+    headers["content-length"] = 2;
+    headers["CONTENT-TYPE"] = 3;
+
+    EXPECT_EQ(headers.GetSize(), 2u);
+    EXPECT_EQ(*headers.TryGet("content-type"), 3);
+    EXPECT_EQ(headers.Find(StringRef("Content-Length"))->first, "content-length");
+
+    TFlatHashMap<std::wstring, int, iWHash, iWEqualTo> wideMap;
+    wideMap[L"Key"] = 4;
+    EXPECT_EQ(*wideMap.TryGet(L"kEY"), 4);
+}
+
+static size_t CountedKeyAllocations = 0;
+
+template <typename T>
+struct CountingAllocator
+{
+    typedef T value_type;
+
+    CountingAllocator() = default;
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&)
+    {
+    }
+
+    T* allocate(const size_t count)
+    {
+        ++CountedKeyAllocations;
+        return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t)
+    {
+        ::operator delete(ptr);
+    }
+
+    template <typename U>
+    bool operator == (const CountingAllocator<U>&) const
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator != (const CountingAllocator<U>&) const
+    {
+        return false;
+    }
+};
+
+typedef std::basic_string<char, std::char_traits<char>, CountingAllocator<char>> CountedKey;
+
+struct CountedKeyHash
+{
+    size_t operator ()(const CountedKey& key) const
+    {
+        return Hash()(StringRef(key.data(), key.size()));
+    }
+
+    size_t operator ()(const char* key) const
+    {
+        return Hash()(StringRef(key));
+    }
+};
+
+struct CountedKeyEqual
+{
+    bool operator ()(const CountedKey& first, const CountedKey& second) const
+    {
+        return first == second;
+    }
+
+    bool operator ()(const CountedKey& first, const char* second) const
+    {
+        return first == second;
+    }
+};
+
+TEST(FlatHashMap, EmplaceExistingKey)
+{
+    // longer than the small string buffer, so every constructed key allocates
+    const char* key = "a key that does not fit into the small string buffer";
+
+    TFlatHashMap<CountedKey, int, CountedKeyHash, CountedKeyEqual> map;
+    EXPECT_TRUE(map.Emplace(key, 1).second);
+
+    CountedKeyAllocations = 0;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_FALSE(map.Emplace(key, i).second);
+        ++map[key];
+    }
+
+    EXPECT_EQ(CountedKeyAllocations, 0u);
+    EXPECT_EQ(*map.TryGet(key), 1001);
+
+    TFlatHashSet<CountedKey, CountedKeyHash, CountedKeyEqual> set;
+    EXPECT_TRUE(set.Emplace(key).second);
+
+    CountedKeyAllocations = 0;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_FALSE(set.Emplace(key).second);
+    }
+
+    EXPECT_EQ(CountedKeyAllocations, 0u);
+    EXPECT_EQ(set.GetSize(), 1u);
+}
+
+TEST(FlatHashMap, MatchesUnorderedMap)
+{
+    std::mt19937 random(42);
+    TFlatHashMap<std::string, int> map;
+    std::unordered_map<std::string, int> expected;
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        const std::string key = "key" + std::to_string(random() % 3000);
+        const int value = static_cast<int>(random() % 100);
+
+        switch (random() % 4)
+        {
+        case 0:
+            EXPECT_EQ(map.Insert(key, value).second, expected.insert(std::make_pair(key, value)).second);
+            break;
+        case 1:
+            EXPECT_EQ(map.Erase(key), expected.erase(key));
+            break;
+        case 2:
+            map[key] = value;
+            expected[key] = value;
+            break;
+        default:
+            EXPECT_EQ(map.Contains(StringRef(key)), expected.count(key) != 0);
+            break;
+        }
+    }
+
+    EXPECT_EQ(map.GetSize(), expected.size());
+
+    for (const auto& pair : expected)
+    {
+        const int* value = map.TryGet(pair.first);
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(*value, pair.second);
+    }
+
+    size_t count = 0;
+    for (const auto& pair : map)
+    {
+        EXPECT_EQ(expected.at(pair.first), pair.second);
+        ++count;
+    }
+
+    EXPECT_EQ(count, expected.size());
+}
+
+TEST(FlatHashSet, Basic)
+{
+    TFlatHashSet<std::string, iHash, iEqualTo> set = { "Makefile", "README" };
+
+    EXPECT_TRUE(set.Contains("makefile"));
+    EXPECT_FALSE(set.Insert("readme").second);
+    EXPECT_TRUE(set.Emplace(StringRef("LICENSE.txt", 7)).second);
+    EXPECT_TRUE(set.Contains(StringRef("license")));
+    EXPECT_EQ(set.GetSize(), 3u);
+
+    TFlatHashSet<int> numbers;
+    for (int i = 0; i < 100; ++i)
+    {
+        numbers.Insert(i % 10);
+    }
+
+    EXPECT_EQ(numbers.GetSize(), 10u);
+
+    int sum = 0;
+    for (const int value : numbers)
+    {
+        sum += value;
+    }
+
+    EXPECT_EQ(sum, 45);
+
+    TFlatHashSet<int> moved = std::move(numbers);
+    EXPECT_EQ(moved.GetSize(), 10u);
+    moved.Erase(moved.Find(3));
+    EXPECT_EQ(moved.GetSize(), 9u);
+    EXPECT_FALSE(moved.Contains(3));
+}
+
+TEST(StringPool, Intern)
+{
+    StringPool pool(64);
+    EXPECT_TRUE(pool.IsEmpty());
+
+    const char path[] = "src/main.cpp";
+    const StringPool::HandleType cpp = pool.Intern(StringRef(path + 9, 3));
+
+    EXPECT_EQ(pool.Intern("cpp"), cpp);
+    EXPECT_EQ(pool.Intern(std::string("cpp")), cpp);
+    EXPECT_NE(pool.Intern("CPP"), cpp);
+    EXPECT_EQ(pool.Find("hpp"), StringPool::InvalidHandle);
+    EXPECT_TRUE(pool.Contains("CPP"));
+    EXPECT_EQ(pool.GetSize(), 2u);
+
+    // the pool keeps its own zero terminated copy
+    const StringRef view = pool.GetString(cpp);
+    EXPECT_NE(view.GetData(), path + 9);
+    EXPECT_STREQ(view.GetData(), "cpp");
+    EXPECT_EQ(pool.InternView("cpp").GetData(), view.GetData());
+
+    // views stay valid while the pool grows, long strings get their own chunk
+    const std::string longText(100, 'x');
+    const StringRef longView = pool.InternView(longText);
+    EXPECT_EQ(longView, StringRef(longText));
+
+    std::vector<StringPool::HandleType> handles;
+    for (int i = 0; i < 5000; ++i)
+    {
+        handles.push_back(pool.Intern(std::to_string(i)));
+    }
+
+    EXPECT_EQ(pool.GetSize(), 5003u);
+    EXPECT_EQ(view.GetData(), pool.GetString(cpp).GetData());
+    EXPECT_STREQ(longView.GetData(), longText.c_str());
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        EXPECT_EQ(pool.GetString(handles[i]), StringRef(std::to_string(i)));
+        EXPECT_EQ(pool.Intern(std::to_string(i)), handles[i]);
+    }
+
+    EXPECT_GT(pool.GetMemoryUsage(), 5003 * sizeof(StringRef));
+
+    WStringPool widePool;
+    EXPECT_EQ(widePool.Intern(L"dir"), widePool.Intern(std::wstring(L"dir")));
+    EXPECT_EQ(widePool.GetString(0), WStringRef(L"dir"));
+}
+
+TEST(StringPool, IgnoreCase)
+{
+    iStringPool pool;
+
+    const iStringPool::HandleType handle = pool.Intern("Makefile");
+    EXPECT_EQ(pool.Intern("MAKEFILE"), handle);
+    EXPECT_EQ(pool.Find("makefile"), handle);
+    EXPECT_EQ(pool.GetString(handle), StringRef("Makefile"));
+    EXPECT_EQ(pool.GetSize(), 1u);
+
+    iWStringPool widePool;
+    EXPECT_EQ(widePool.Intern(L"Windows"), widePool.Intern(L"WINDOWS"));
+}
+
+TEST(StringPool, Threads)
+{
+    StringPool pool(256);
+    std::vector<std::vector<StringPool::HandleType>> results(4);
+    std::vector<std::thread> threads;
+
+    for (size_t t = 0; t < results.size(); ++t)
+    {
+        threads.emplace_back([&pool, &results, t]()
+        {
+            for (int i = 0; i < 2000; ++i)
+            {
+                const int value = static_cast<int>(t % 2 == 0 ? i : 1999 - i);
+                const StringPool::HandleType handle = pool.Intern("name" + std::to_string(value % 500));
+
+                results[t].push_back(handle);
+                EXPECT_EQ(pool.GetString(handle), StringRef("name" + std::to_string(value % 500)));
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(pool.GetSize(), 500u);
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        EXPECT_EQ(results[0][i], results[2][i]);
+        EXPECT_EQ(results[1][i], results[3][i]);
+        EXPECT_EQ(results[0][i], results[1][1999 - i]);
+    }
+}
+
+TEST(InlineString, Fixed)
+{
+    InlineString<8> str("abc");
+    EXPECT_EQ(str.GetLength(), 3u);
+    EXPECT_STREQ(str.GetData(), "abc");
+    EXPECT_TRUE(str.IsInline());
+    EXPECT_EQ(str.GetCapacity(), 8u);
+
+    str += "de";
+    str += 'f';
+    EXPECT_EQ(str, StringRef("abcdef"));
+    EXPECT_FALSE(str.IsTruncated());
+
+    // the content is cut at the inline capacity
+    str += "ghijk";
+    EXPECT_EQ(str, StringRef("abcdefgh"));
+    EXPECT_TRUE(str.IsTruncated());
+    EXPECT_STREQ(str.GetData(), "abcdefgh");
+
+    str.RemovePrefix(2);
+    str.RemoveSuffix(1);
+    EXPECT_STREQ(str.GetData(), "cdefg");
+    EXPECT_TRUE(str.IsTruncated());
+
+    // appending a part of itself
+    str.Append(StringRef(str.GetData(), 2));
+    EXPECT_STREQ(str.GetData(), "cdefgcd");
+
+    str[0] = 'C';
+    str.Resize(9, '!');
+    EXPECT_STREQ(str.GetData(), "Cdefgcd!");
+
+    str = StringRef("xyz");
+    EXPECT_FALSE(str.IsTruncated());
+    EXPECT_EQ(str.ToString(), "xyz");
+
+    const InlineString<8> copy = str;
+    str.Clear();
+    EXPECT_TRUE(str.IsEmpty());
+    EXPECT_STREQ(str.GetData(), "");
+    EXPECT_EQ(copy, StringRef("xyz"));
+
+    WInlineString<4> wide(std::wstring(L"wide"));
+    EXPECT_EQ(wide, WStringRef(L"wide"));
+    EXPECT_FALSE(wide.IsTruncated());
+}
+
+TEST(InlineString, SpillToHeap)
+{
+    InlineString<4, true> str("abcd");
+    EXPECT_TRUE(str.IsInline());
+
+    // appending part of itself while moving to the heap
+    str.Append(StringRef(str.GetData() + 1, 3));
+    EXPECT_FALSE(str.IsInline());
+    EXPECT_FALSE(str.IsTruncated());
+    EXPECT_STREQ(str.GetData(), "abcdbcd");
+
+    for (int i = 0; i < 100; ++i)
+    {
+        str += static_cast<char>('0' + i % 10);
+    }
+
+    EXPECT_EQ(str.GetLength(), 107u);
+    EXPECT_GE(str.GetCapacity(), 107u);
+
+    InlineString<4, true> copy = str;
+    EXPECT_EQ(copy, str);
+
+    const char* data = str.GetData();
+    InlineString<4, true> moved = std::move(str);
+    EXPECT_EQ(moved.GetData(), data);
+    EXPECT_TRUE(str.IsEmpty());
+    EXPECT_TRUE(str.IsInline());
+
+    moved = InlineString<4, true>("ab");
+    EXPECT_STREQ(moved.GetData(), "ab");
+
+    copy.Clear();
+    copy.Reserve(500);
+    EXPECT_GE(copy.GetCapacity(), 500u);
+}
+
+TEST(StringBuilder, Append)
+{
+    StringBuilder builder(16);
+    std::string expected;
+
+    EXPECT_TRUE(builder.IsEmpty());
+    EXPECT_EQ(builder.ToString(), "");
+
+    // pieces crossing chunk boundaries
+    for (int i = 0; i < 50; ++i)
+    {
+        const std::string piece = "piece" + std::to_string(i) + ";";
+        builder.Append(piece);
+        expected += piece;
+    }
+
+    builder.Append('-', 40);
+    expected.append(40, '-');
+
+    EXPECT_EQ(builder.GetLength(), expected.size());
+    EXPECT_EQ(builder.ToString(), expected);
+
+    size_t chunks = 0;
+    builder.ForEachChunk([&chunks](const char*, const size_t length) { EXPECT_LE(length, 16u); ++chunks; });
+    EXPECT_EQ(chunks, (expected.size() + 15) / 16);
+
+    DynamicBuffer buffer;
+    buffer.Append("<", 1);
+    builder.WriteTo(buffer);
+    ASSERT_EQ(buffer.GetSize(), expected.size() + 1);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(buffer.GetData()) + 1, expected.size()), expected);
+
+    // the chunks are kept for reuse
+    const size_t capacity = builder.GetCapacity();
+    builder.Clear();
+    EXPECT_TRUE(builder.IsEmpty());
+    builder.Append("again");
+    EXPECT_EQ(builder.ToString(), "again");
+    EXPECT_EQ(builder.GetCapacity(), capacity);
+
+    WStringBuilder wideBuilder(4);
+    wideBuilder.Append(L"wide ").Append(L"string");
+    EXPECT_EQ(wideBuilder.ToString(), L"wide string");
+}
+
+TEST(StringBuilder, Move)
+{
+    StringBuilder source(4);
+    source.Append("0123456789ab", 12);
+
+    StringBuilder moved(std::move(source));
+    EXPECT_EQ(moved.ToString(), "0123456789ab");
+
+    // the moved-from builder is empty and usable
+    EXPECT_TRUE(source.IsEmpty());
+    source.Append("xy", 2);
+    EXPECT_EQ(source.ToString(), "xy");
+
+    StringBuilder assigned(8);
+    assigned.Append("previous content");
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned.ToString(), "0123456789ab");
+    assigned.Append("cd");
+    EXPECT_EQ(assigned.ToString(), "0123456789abcd");
+
+    EXPECT_TRUE(moved.IsEmpty());
+    moved.Append("0123456789", 10);
+    EXPECT_EQ(moved.ToString(), "0123456789");
+}
+
+TEST(StringBuilder, Format)
+{
+    StringBuilder builder;
+
+    builder.AppendInteger(0).Append(' ').AppendInteger(-7).Append(' ').AppendInteger(1234567890123ull);
+    builder.Append(' ').AppendInteger(INT64_MIN).Append(' ').AppendInteger(UINT64_MAX).Append(' ').AppendInteger(static_cast<int8_t>(-128));
+    EXPECT_EQ(builder.ToString(), "0 -7 1234567890123 -9223372036854775808 18446744073709551615 -128");
+
+    builder.Clear();
+    builder.AppendHex(0xBEEF).Append(' ').AppendHex(0xBEEF, 8, true).Append(' ').AppendHex(0).Append(' ').AppendHex(UINT64_MAX);
+    EXPECT_EQ(builder.ToString(), "beef 0000BEEF 0 ffffffffffffffff");
+
+    for (int i = -1000; i <= 1000; ++i)
+    {
+        builder.Clear();
+        builder.AppendInteger(i);
+        EXPECT_EQ(builder.ToString(), std::to_string(i));
+    }
+
+    builder.Clear();
+    builder.AppendFormat("{} files in {} ({}), {{{}}} {}", 42u, std::string("/tmp"), StringRef("cache"), 'x', true);
+    EXPECT_EQ(builder.ToString(), "42 files in /tmp (cache), {x} true");
+
+    builder.Clear();
+    builder << "n=" << -5 << ", ok=" << false << ", name=" << InlineString<8>("abc") << '!';
+    EXPECT_EQ(builder.ToString(), "n=-5, ok=false, name=abc!");
+
+    builder.Clear();
+    builder << 0.1 << ' ' << 2.5f << ' ' << -1e100 << ' ';
+    builder.AppendFixed(3.14159, 3).Append(' ').AppendFixed(2.0, 0);
+    EXPECT_EQ(builder.ToString(), "0.1 2.5 -1e+100 3.142 2");
+
+    WStringBuilder wideBuilder;
+    wideBuilder.AppendFormat(L"{}: {}", L"count", 3);
+    EXPECT_EQ(wideBuilder.ToString(), L"count: 3");
+}
+
+TEST(StringBuilder, AppendFixedMatchesPrintf)
+{
+    const double samples[] = { 6062731.8125, 0.5, 1.5, 2.5, 0.125, 0.375, -0.0, 1e-300, 5e-324, 9.0e9, 1.0005, 2.675 };
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<double> magnitude(-12.0, 9.0);
+    char expected[64];
+
+    for (int i = 0; i < 200000; ++i)
+    {
+        const int decimals = i % 10;
+        double value;
+
+        if (i < static_cast<int>(sizeof(samples) / sizeof(samples[0])) * 10)
+        {
+            value = samples[i / 10];
+        }
+        else
+        {
+            value = std::pow(10.0, magnitude(random)) * ((random() & 1) ? -1.0 : 1.0);
+        }
+
+        StringBuilder builder;
+        builder.AppendFixed(value, decimals);
+        snprintf(expected, sizeof(expected), "%.*f", decimals, value);
+        ASSERT_EQ(builder.ToString(), expected) << value << " with " << decimals << " decimals";
+    }
+}
+
+TEST(StringBuilder, WriteToFile)
+{
+    StringBuilder builder(8);
+    std::string expected;
+
+    for (int i = 0; i < 500; ++i)
+    {
+        builder << i << '\n';
+        expected += std::to_string(i) + "\n";
+    }
+
+    FILE* file = tmpfile();
+    ASSERT_NE(file, nullptr);
+
+#if CMT_PLATFORM_WINDOWS
+    const int fd = _fileno(file);
+#else
+    const int fd = fileno(file);
+#endif
+
+    EXPECT_TRUE(builder.WriteTo(fd));
+
+    rewind(file);
+    std::string content(expected.size() + 1, '\0');
+    content.resize(fread(&content[0], 1, content.size(), file));
+    fclose(file);
+
+    EXPECT_EQ(content, expected);
+}
@@ -46,5 +46,7 @@ TEST(Crc32, CaculateBytes)
 
     auto crc32 = CRC32::Caculate((const uint8_t*)Text, strlen(Text));    
     EXPECT_EQ(crc32, 0x1c291ca3);
+    EXPECT_EQ(CRC32::ToHexString(crc32), "1c291ca3");
+    EXPECT_EQ(CRC32::ToHexString(0x0000ABCD, true), "0000ABCD");
 }
 
@@ -2,6 +2,8 @@
 #include <Common/BuildConfig.hpp>
 #include <FileSystem/FileSystem.hpp>
 #include <FileSystem/Path.hpp>
+#include <FileSystem/LineReader.hpp>
+#include <algorithm>
 
 using namespace CppMiniToolkit;
 
@@ -41,3 +43,100 @@ TEST(FileSystem, WalkThoughDirectory)
     );
 }
 
+
+TEST(FileSystem, WalkThoughDirectoryWithFilter)
+{
+    const char* dirPath = "testGlobDir";
+    ASSERT_TRUE(FileSystem::CreateDirectories("testGlobDir/logs.d"));
+
+    const uint8_t data[] = { 1 };
+
+    for (const char* name : { "testGlobDir/a.log", "testGlobDir/B.LOG", "testGlobDir/c.txt", "testGlobDir/logs.d/d.log" })
+    {
+        ASSERT_TRUE(FileSystem::WriteAllBytes(name, data, sizeof(data)));
+    }
+
+    std::vector<std::string> found;
+    auto visitor = [&found](const char* path, bool)
+    {
+        found.push_back(PathUtils::GetFileName(path));
+        return true;
+    };
+
+    FileSystem::WalkThoughDirectoryEx(dirPath, iGlobPattern("*.log"), visitor, true, false);
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(found, (std::vector<std::string>{ "B.LOG", "a.log", "d.log" }));
+
+    found.clear();
+    FileSystem::WalkThoughDirectoryEx(dirPath, GlobPattern("*.log"), visitor, false, true);
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(found, (std::vector<std::string>{ "a.log" }));
+
+    found.clear();
+    FileSystem::WalkThoughDirectoryEx(dirPath, GlobPattern("logs*"), visitor, false, true);
+    EXPECT_EQ(found, (std::vector<std::string>{ "logs.d" }));
+
+    ASSERT_TRUE(FileSystem::DeleteDirectories(dirPath));
+}
+
+TEST(FileSystem, LineReader)
+{
+    const char* filePath = "testLines.txt";
+    const std::string longLine(100, 'x');
+    const std::string text = "first\r\nsecond\n\n\r\n" + longLine + "\nlast\rline";
+    const std::vector<std::string> expected = { "first", "second", "", "", longLine, "last\rline" };
+
+    ASSERT_TRUE(FileSystem::WriteAllBytes(filePath, reinterpret_cast<const uint8_t*>(text.data()), text.size()));
+
+    // small blocks split lines and "\r\n" pairs between reads
+    for (size_t blockSize : { 1, 2, 3, 7, 64, 4096 })
+    {
+        LineReader reader(blockSize);
+        ASSERT_TRUE(reader.OpenFile(filePath));
+
+        std::vector<std::string> lines;
+
+        for (StringRef line; reader.ReadLine(line); )
+        {
+            lines.push_back(line.ToString());
+        }
+
+        EXPECT_EQ(lines, expected) << blockSize;
+        EXPECT_EQ(reader.GetLineNumber(), expected.size());
+        EXPECT_FALSE(reader.HasError());
+    }
+
+    // a line of many blocks is searched once, not again after every block
+    const std::string hugeLine(4 * 1024 * 1024, 'y');
+    ASSERT_TRUE(FileSystem::WriteAllBytes(filePath, reinterpret_cast<const uint8_t*>(hugeLine.data()), hugeLine.size()));
+
+    {
+        LineReader reader(64);
+        StringRef line;
+        ASSERT_TRUE(reader.OpenFile(filePath));
+        ASSERT_TRUE(reader.ReadLine(line));
+        EXPECT_EQ(line.GetLength(), hugeLine.size());
+        EXPECT_FALSE(reader.ReadLine(line));
+    }
+
+    LineReader reader;
+    StringRef line;
+
+    reader.OpenText(StringRef(text));
+    ASSERT_TRUE(reader.ReadLine(line));
+    EXPECT_EQ(line.GetData(), text.data());
+    EXPECT_EQ(line.GetLength(), 5u);
+
+    reader.OpenText(StringRef("single line\n"));
+    ASSERT_TRUE(reader.ReadLine(line));
+    EXPECT_EQ(line.ToString(), "single line");
+    EXPECT_FALSE(reader.ReadLine(line));
+
+    reader.OpenText(StringRef(""));
+    EXPECT_FALSE(reader.ReadLine(line));
+
+    EXPECT_FALSE(reader.OpenFile("missing/testLines.txt"));
+    EXPECT_FALSE(reader.ReadLine(line));
+
+    ASSERT_TRUE(FileSystem::DeleteSingleFile(filePath));
+}
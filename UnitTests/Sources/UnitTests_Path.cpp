@@ -33,6 +33,22 @@ TEST(PathUtils, GetExtension)
     EXPECT_EQ(PathUtils::GetExtension(""), "");
 }
 
+TEST(PathUtils, StringRef)
+{
+    const std::string buffer = "C:\\folder.d\\file.txt|/usr/local/bin/executable";
+    const StringRef first(buffer.c_str(), buffer.find('|'));
+    const StringRef second = StringRef(buffer).SubRef(buffer.find('|') + 1);
+
+    EXPECT_EQ(PathUtils::GetFileName(first), "file.txt");
+    EXPECT_EQ(PathUtils::GetFileName(first).GetData(), buffer.c_str() + 12);
+    EXPECT_EQ(PathUtils::GetExtension(first), ".txt");
+    EXPECT_EQ(PathUtils::GetFileName(second), "executable");
+    EXPECT_TRUE(PathUtils::GetExtension(second).IsEmpty());
+    EXPECT_TRUE(PathUtils::GetExtension(StringRef("folder.d/file")).IsEmpty());
+    EXPECT_EQ(PathUtils::GetFileName(WStringRef(L"relative/path/to/file.txt")), L"file.txt");
+    EXPECT_TRUE(PathUtils::GetFileName(StringRef()).IsEmpty());
+}
+
 TEST(PathUtils, ReplaceExtension)
 {
     EXPECT_EQ(PathUtils::ReplaceExtension("C:\\folder\\file.txt", ".exe"), "C:\\folder\\file.exe");
@@ -111,3 +127,22 @@ TEST(PathUtils, IsRelativePath)
     EXPECT_TRUE(PathUtils::IsRelativePath("file.txt"));
     EXPECT_TRUE(PathUtils::IsRelativePath(""));
 }
+
+TEST(PathUtils, InlineString)
+{
+    InlineString<64> path("relative/path");
+    PathUtils::Combine(path, "to", "file.txt");
+    EXPECT_EQ(path.ToString(), PathUtils::Combine("relative/path", "to", "file.txt"));
+
+    InlineString<64> fileName(PathUtils::GetFileName(path));
+    EXPECT_STREQ(fileName.GetData(), "file.txt");
+    EXPECT_EQ(PathUtils::GetExtension(path), StringRef(".txt"));
+
+    InlineString<64> folder("folder/");
+    PathUtils::Combine(folder, std::string("file.txt"));
+    EXPECT_STREQ(folder.GetData(), "folder/file.txt");
+
+    WInlineString<64> widePath(L"dir");
+    PathUtils::Combine(widePath, L"name.ext");
+    EXPECT_EQ(PathUtils::GetExtension(widePath), WStringRef(L".ext"));
+}
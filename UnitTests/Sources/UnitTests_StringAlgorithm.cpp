@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
 #include <Algorithm/String.hpp>
+#include <map>
+#include <random>
+#include <limits>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 
 using namespace CppMiniToolkit;
 
@@ -42,3 +48,1156 @@ TEST(StringAlgorithm, WCharTest)
     std::vector<std::wstring> vec = { L"hello", L"world" };
     ASSERT_EQ(StringAlgorithm::Join(vec, L" "), L"hello world");
 }
+
+TEST(StringAlgorithm, FindLongText)
+{
+    std::string text;
+    for (int i = 0; i < 300; ++i)
+    {
+        text += static_cast<char>('a' + i % 7);
+    }
+
+    for (size_t length = 1; length < 40; ++length)
+    {
+        for (size_t start = 0; start + length <= text.size(); start += 13)
+        {
+            const std::string match = text.substr(start, length);
+            const char* result = TCharTraits<char>::Find(text.c_str(), text.size(), match.c_str(), match.size());
+            ASSERT_NE(result, nullptr);
+            ASSERT_EQ(static_cast<size_t>(result - text.c_str()), text.find(match));
+        }
+    }
+
+    ASSERT_TRUE(StringAlgorithm::Contains(text, text.substr(250)));
+    ASSERT_FALSE(StringAlgorithm::Contains(text, "abcdefga_"));
+    ASSERT_FALSE(StringAlgorithm::Contains(text.c_str(), 10, "fgabcd", 6));
+    ASSERT_EQ(TCharTraits<char>::Find(text.c_str(), ""), text.c_str());
+
+    std::wstring wtext(text.begin(), text.end());
+    const std::wstring wmatch = wtext.substr(287, 11);
+    ASSERT_EQ(TCharTraits<wchar_t>::Find(wtext.c_str(), wmatch.c_str()) - wtext.c_str(), static_cast<std::ptrdiff_t>(wtext.find(wmatch)));
+    ASSERT_FALSE(StringAlgorithm::Contains(wtext, L"gg"));
+
+    std::string replaced = "a-b-c";
+    ASSERT_EQ(StringAlgorithm::ReplaceAll(replaced, std::string("-"), std::string("--")), "a--b--c");
+}
+
+TEST(StringAlgorithm, iFindLongText)
+{
+    std::string text;
+    for (int i = 0; i < 300; ++i)
+    {
+        const char ch = static_cast<char>('a' + i % 11);
+        text += i % 3 == 0 ? static_cast<char>(ch - 'a' + 'A') : ch;
+    }
+
+    std::string lowerText = text;
+    StringAlgorithm::ToLower(lowerText);
+
+    for (size_t length = 1; length < 40; ++length)
+    {
+        for (size_t start = 0; start + length <= text.size(); start += 17)
+        {
+            std::string match = lowerText.substr(start, length);
+            StringAlgorithm::ToUpper(match);
+            const char* result = TCharTraits<char>::iFind(text.c_str(), text.size(), match.c_str(), match.size());
+            ASSERT_NE(result, nullptr);
+            ASSERT_EQ(static_cast<size_t>(result - text.c_str()), lowerText.find(StringAlgorithm::ToLowerCopy(match)));
+        }
+    }
+
+    ASSERT_FALSE(StringAlgorithm::iContains(text, "ABCDEFGHIJKB"));
+    ASSERT_TRUE(StringAlgorithm::iContains(text.c_str(), text.size(), "KABCD", 5));
+
+    // adversarial input falls back to the linear scan
+    const std::string haystack = std::string(5000, 'a') + "B" + std::string(5000, 'a');
+    const std::string needle = std::string(1000, 'A') + "b" + std::string(1000, 'A');
+    ASSERT_EQ(TCharTraits<char>::iFind(haystack.c_str(), needle.c_str()) - haystack.c_str(), 4000);
+    ASSERT_EQ(TCharTraits<char>::Find(haystack.c_str(), "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaB") - haystack.c_str(), 4970);
+
+    const std::wstring wtext = L"GrÖße und GrößE, der Kelvin K und mehr Text als ein Block";
+    ASSERT_EQ(TCharTraits<wchar_t>::iFind(wtext.c_str(), L"GRößE, DER") - wtext.c_str(), 10);
+    ASSERT_TRUE(StringAlgorithm::iContains(wtext, L"kELVIN k UND"));
+    ASSERT_FALSE(StringAlgorithm::iContains(wtext, L"blocks"));
+
+    std::string replaced = "Hello hello HELLO";
+    ASSERT_EQ(StringAlgorithm::iReplaceAll(replaced, std::string("hello"), std::string("bye")), "bye bye bye");
+}
+
+TEST(StringAlgorithm, ReverseSearch)
+{
+    std::mt19937 random(21);
+
+    for (int round = 0; round < 2000; ++round)
+    {
+        std::string text(random() % 150, ' ');
+
+        for (auto& ch : text)
+        {
+            ch = "ab/\\."[random() % 5];
+        }
+
+        const std::string match = text.substr(random() % (text.size() + 1), 1 + random() % 5);
+        const std::string probe = match.empty() ? "ab" : match;
+        const char* result = TCharTraits<char>::rFind(text.c_str(), text.size(), probe.c_str(), probe.size());
+        ASSERT_EQ(result == nullptr ? std::string::npos : static_cast<size_t>(result - text.c_str()), text.rfind(probe)) << text << " / " << probe;
+
+        result = TCharTraits<char>::rFind(text.c_str(), text.size(), '.');
+        ASSERT_EQ(result == nullptr ? std::string::npos : static_cast<size_t>(result - text.c_str()), text.rfind('.'));
+
+        result = TCharTraits<char>::rFindAny(text.c_str(), text.size(), "/\\", 2);
+        ASSERT_EQ(result == nullptr ? std::string::npos : static_cast<size_t>(result - text.c_str()), text.find_last_of("/\\"));
+
+        result = TCharTraits<char>::rFindNotOfAny(text.c_str(), text.size(), "ab.", 3);
+        ASSERT_EQ(result == nullptr ? std::string::npos : static_cast<size_t>(result - text.c_str()), text.find_last_not_of("ab."));
+
+        const std::wstring wtext(text.begin(), text.end());
+        const wchar_t* wresult = TCharTraits<wchar_t>::rFindAny(wtext.c_str(), wtext.size(), L"a.", 2);
+        ASSERT_EQ(wresult == nullptr ? std::wstring::npos : static_cast<size_t>(wresult - wtext.c_str()), wtext.find_last_of(L"a."));
+    }
+
+    // sets beyond the SIMD comparisons go through the lookup table
+    const std::string text = "0123456789abcdef-0123456789-abcdefghij";
+    ASSERT_EQ(TCharTraits<char>::rFindAny(text.c_str(), "0123456789") - text.c_str(), 26);
+    ASSERT_EQ(TCharTraits<char>::rFindNotOfAny(text.c_str(), "abcdefghij-") - text.c_str(), 26);
+    ASSERT_EQ(TCharTraits<char>::rFind(text.c_str(), "") - text.c_str(), static_cast<std::ptrdiff_t>(text.size()));
+    ASSERT_EQ(TCharTraits<char>::rFind(text.c_str(), "0123"), text.c_str() + 17);
+    ASSERT_EQ(TCharTraits<char>::rFind(text.c_str(), "0124"), nullptr);
+
+    // adversarial input falls back to the linear scan
+    const std::string haystack = std::string(5000, 'a') + "B" + std::string(5000, 'a');
+    ASSERT_EQ(TCharTraits<char>::rFind(haystack.c_str(), (std::string(1000, 'a') + "B" + std::string(1000, 'a')).c_str()) - haystack.c_str(), 4000);
+    ASSERT_EQ(TCharTraits<char>::rFind(haystack.c_str(), ("B" + std::string(30, 'a')).c_str()) - haystack.c_str(), 5000);
+    ASSERT_EQ(TCharTraits<char>::rFind(haystack.c_str(), (std::string(30, 'a') + "B").c_str()) - haystack.c_str(), 4970);
+    ASSERT_EQ(TCharTraits<char>::rFind(haystack.c_str(), (std::string(30, 'a') + "C").c_str()), nullptr);
+
+    const std::wstring wtext = L"C:\\Program Files\\Toolkit/bin/tool.exe";
+    ASSERT_EQ(TCharTraits<wchar_t>::rFind(wtext.c_str(), L"Toolkit") - wtext.c_str(), 17);
+    ASSERT_EQ(TCharTraits<wchar_t>::rFindNotOfAny(wtext.c_str(), L"ex.") - wtext.c_str(), 32);
+    ASSERT_TRUE(StringAlgorithm::EndWith(wtext, L"tool.exe"));
+    ASSERT_FALSE(StringAlgorithm::EndWith(std::string("exe"), "tool.exe"));
+}
+
+TEST(StringAlgorithm, StringSearcher)
+{
+    const std::string text = "the quick brown fox jumps over the lazy dog, THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG";
+
+    const StringSearcher shortSearcher("fox");
+    ASSERT_EQ(shortSearcher.FindIn(text), text.find("fox"));
+    ASSERT_TRUE(StringAlgorithm::Contains(text, shortSearcher));
+
+    const StringSearcher longSearcher("jumps over the lazy dog");
+    ASSERT_EQ(longSearcher.FindIn(text), text.find("jumps over the lazy dog"));
+    ASSERT_FALSE(StringAlgorithm::Contains(text.c_str(), 30, longSearcher));
+
+    const iStringSearcher ignoreCaseSearcher("Jumps Over The Lazy Dog");
+    std::vector<size_t> positions;
+    ASSERT_EQ(ignoreCaseSearcher.FindAllIn(text, positions), 2u);
+    ASSERT_EQ(positions[0], text.find("jumps"));
+    ASSERT_EQ(positions[1], text.find("JUMPS"));
+    ASSERT_TRUE(StringAlgorithm::iContains(text, ignoreCaseSearcher));
+
+    const std::string repeated(64, 'a');
+    const StringSearcher overlapped(std::string(20, 'a'));
+    positions.clear();
+    ASSERT_EQ(overlapped.FindAllIn(repeated, positions), 3u);
+    positions.clear();
+    ASSERT_EQ(overlapped.FindAllIn(repeated, positions, true), 45u);
+
+    // adversarial input switches to the linear scan
+    const std::string haystack = std::string(5000, 'a') + "b" + std::string(5000, 'a');
+    const StringSearcher adversarial(std::string(1000, 'a') + "b" + std::string(1000, 'a'));
+    ASSERT_EQ(adversarial.FindIn(haystack), 4000u);
+
+    // many overlapping matches of a long needle are reported by one linear scan
+    const StringSearcher runs(std::string(2000, 'a'));
+    positions.clear();
+    ASSERT_EQ(runs.FindAllIn(std::string(1000000, 'a'), positions, true), 998001u);
+    ASSERT_EQ(positions.back(), 998000u);
+
+    std::mt19937 random(3);
+
+    for (int round = 0; round < 2000; ++round)
+    {
+        std::string pattern(1 + random() % 24, ' ');
+        std::string str(random() % 200, ' ');
+
+        for (auto& ch : pattern)
+        {
+            ch = "aA"[random() % 2];
+        }
+
+        for (auto& ch : str)
+        {
+            ch = random() % 16 == 0 ? 'b' : "aA"[random() % 2];
+        }
+
+        const bool overlapping = round % 2 == 0;
+        std::vector<size_t> expected;
+
+        for (size_t position = 0; position + pattern.size() <= str.size();)
+        {
+            if (StringAlgorithm::iStartWith(str.c_str() + position, pattern.c_str()))
+            {
+                expected.push_back(position);
+                position += overlapping ? 1 : pattern.size();
+            }
+            else
+            {
+                ++position;
+            }
+        }
+
+        positions.clear();
+        iStringSearcher(pattern).FindAllIn(str, positions, overlapping);
+        ASSERT_EQ(positions, expected) << str << " / " << pattern;
+    }
+
+    const iWStringSearcher wideSearcher(L"BROWN FOX JUMPS");
+    ASSERT_TRUE(StringAlgorithm::Contains(L"the quick brown fox jumps", wideSearcher));
+    ASSERT_FALSE(wideSearcher.ContainsIn(L"the quick brown fox jumped"));
+}
+
+TEST(StringAlgorithm, MultiStringMatcher)
+{
+    const TMultiStringMatcher<char> matcher = { "he", "she", "his", "hers" };
+    const std::string text = "ushers";
+
+    ASSERT_TRUE(StringAlgorithm::ContainsAny(text, matcher));
+    ASSERT_FALSE(StringAlgorithm::ContainsAny("ahis_", 3, matcher));
+    ASSERT_EQ(StringAlgorithm::FindAny(text, matcher), 1u);
+
+    std::vector<TMultiStringMatcher<char>::MatchResult> results;
+    ASSERT_EQ(matcher.FindAllIn(text, results), 3u);
+    ASSERT_EQ(results[0].Position, 1u);
+    ASSERT_EQ(matcher.GetPattern(results[0].PatternIndex), "she");
+    ASSERT_EQ(results[1].Position, 2u);
+    ASSERT_EQ(matcher.GetPattern(results[1].PatternIndex), "he");
+    ASSERT_EQ(results[2].Position, 2u);
+    ASSERT_EQ(matcher.GetPattern(results[2].PatternIndex), "hers");
+
+    // leftmost, then longest
+    const TMultiStringMatcher<char> overlapped = { "bcdef", "abc", "abcd" };
+    TMultiStringMatcher<char>::MatchResult first;
+    ASSERT_TRUE(overlapped.FindFirstIn(std::string("xabcdefg"), first));
+    ASSERT_EQ(first.Position, 1u);
+    ASSERT_EQ(first.Length, 4u);
+
+    std::vector<std::wstring> keywords;
+    for (int i = 0; i < 500; ++i)
+    {
+        keywords.push_back(L"Keyword" + std::to_wstring(i * 7));
+    }
+
+    const TMultiStringMatcher<wchar_t, true> blocked(keywords);
+    ASSERT_TRUE(blocked.GetMemoryUsage() > 0);
+    ASSERT_TRUE(StringAlgorithm::ContainsAny(L"this line has KEYWORD693 inside", blocked));
+    ASSERT_FALSE(StringAlgorithm::ContainsAny(L"this line has keyword694 inside", blocked));
+    ASSERT_EQ(StringAlgorithm::FindAny(std::wstring(L"..keyword14"), blocked), 2u);
+}
+
+TEST(StringAlgorithm, ReplaceAll)
+{
+    std::string shrink = "${name} and ${name} and ${name}";
+    ASSERT_EQ(StringAlgorithm::ReplaceAll(shrink, std::string("${name}"), std::string("x")), "x and x and x");
+
+    std::string grow = "a.b.c.";
+    ASSERT_EQ(StringAlgorithm::ReplaceAll(grow, std::string("."), std::string("...")), "a...b...c...");
+
+    std::string same = "abcabc";
+    ASSERT_EQ(StringAlgorithm::ReplaceAll(same, std::string("b"), std::string("B")), "aBcaBc");
+
+    std::string untouched = "abc";
+    ASSERT_EQ(StringAlgorithm::ReplaceAll(untouched, std::string("x"), std::string("")), "abc");
+
+    ASSERT_EQ(StringAlgorithm::ReplaceAllCopy(std::string("aaaa"), std::string("aa"), std::string("b")), "bb");
+    ASSERT_EQ(StringAlgorithm::iReplaceAllCopy(std::string("Tag tag TAG"), std::string("tag"), std::string("<tag/>")), "<tag/> <tag/> <tag/>");
+
+    std::string output = "prefix:";
+    StringAlgorithm::ReplaceAllInto(output, std::string("1-2-3"), std::string("-"), std::string(", "));
+    StringAlgorithm::iReplaceAllInto(output, std::string("|X|x"), std::string("x"), std::string("y"));
+    ASSERT_EQ(output, "prefix:1, 2, 3|y|y");
+
+    DynamicBuffer buffer;
+    StringAlgorithm::ReplaceAllInto(buffer, std::wstring(L"one two"), std::wstring(L" "), std::wstring(L"__"));
+    ASSERT_EQ(buffer.GetSize(), 8 * sizeof(wchar_t));
+    ASSERT_EQ(std::wstring(reinterpret_cast<const wchar_t*>(buffer.GetData()), 8), L"one__two");
+
+    // an adversarial needle with many matches is still found in one linear pass
+    const std::string needle = std::string(500, 'a') + "b" + std::string(500, 'a');
+    std::string adversarial;
+    std::string shrunk;
+    std::string grown;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        adversarial += needle + "c";
+        shrunk += "xc";
+        grown += needle + needle + "c";
+    }
+
+    ASSERT_EQ(StringAlgorithm::Count(adversarial, needle), 1000u);
+    ASSERT_EQ(StringAlgorithm::ReplaceAllCopy(adversarial, needle, std::string("x")), shrunk);
+    ASSERT_EQ(StringAlgorithm::ReplaceAllCopy(adversarial, needle, needle + needle), grown);
+    ASSERT_EQ(StringAlgorithm::iReplaceAll(adversarial, needle, std::string("x")), shrunk);
+}
+
+TEST(StringAlgorithm, ReplaceAllMany)
+{
+    const std::map<std::string, std::string> variables = {
+        { "${NAME}", "world" },
+        { "${N}", "1" },
+        { "${NAME_LONG}", "planet earth" },
+    };
+
+    std::string text = "hello ${NAME}, ${NAME_LONG} #${N}${N} ${UNKNOWN}";
+    ASSERT_EQ(StringAlgorithm::ReplaceAllMany(text, variables), "hello world, planet earth #11 ${UNKNOWN}");
+
+    // leftmost match first, then the longest one
+    const std::vector<std::pair<std::string, std::string>> overlapped = { { "abc", "1" }, { "bcd", "2" }, { "abcd", "3" } };
+    ASSERT_EQ(StringAlgorithm::ReplaceAllManyCopy(std::string("xabcde bcd abc"), overlapped), "x3e 2 1");
+    ASSERT_EQ(StringAlgorithm::iReplaceAllManyCopy(std::string("ABC Bcd"), overlapped), "1 2");
+
+    const TMultiStringMatcher<wchar_t> matcher = { L"<", L">", L"&" };
+    const std::vector<std::wstring> escaped = { L"&lt;", L"&gt;", L"&amp;" };
+    std::wstring html = L"<a & b>";
+    ASSERT_EQ(StringAlgorithm::ReplaceAllMany(html, matcher, escaped), L"&lt;a &amp; b&gt;");
+
+    std::wstring output;
+    StringAlgorithm::ReplaceAllManyInto(output, std::wstring(L"1<2"), matcher, escaped);
+    ASSERT_EQ(output, L"1&lt;2");
+
+    // a long pattern next to a short one must not make every short match rescan the long one's length
+    const std::string longKey = std::string(65535, 'a') + "b";
+    const std::vector<std::pair<std::string, std::string>> shortAndLong = { { "a", "x" }, { longKey, "L" } };
+    ASSERT_EQ(StringAlgorithm::ReplaceAllManyCopy(std::string(256 * 1024, 'a'), shortAndLong), std::string(256 * 1024, 'x'));
+    ASSERT_EQ(StringAlgorithm::ReplaceAllManyCopy("a" + longKey + "aa", shortAndLong), "xLxx");
+
+    // the one pass scan agrees with restarting after every match
+    std::mt19937 random(6);
+
+    for (int round = 0; round < 2000; ++round)
+    {
+        std::vector<std::string> patterns(1 + random() % 5);
+
+        for (auto& pattern : patterns)
+        {
+            pattern.resize(1 + random() % 4);
+
+            for (auto& ch : pattern)
+            {
+                ch = "abc"[random() % 3];
+            }
+        }
+
+        std::string str(random() % 30, ' ');
+
+        for (auto& ch : str)
+        {
+            ch = "abc"[random() % 3];
+        }
+
+        std::vector<std::pair<size_t, size_t>> expected;
+
+        for (size_t position = 0; position < str.size();)
+        {
+            size_t longest = 0;
+
+            for (const auto& pattern : patterns)
+            {
+                if (pattern.size() > longest && str.compare(position, pattern.size(), pattern) == 0)
+                {
+                    longest = pattern.size();
+                }
+            }
+
+            if (longest == 0)
+            {
+                ++position;
+                continue;
+            }
+
+            expected.emplace_back(position, longest);
+            position += longest;
+        }
+
+        std::vector<std::pair<size_t, size_t>> actual;
+        TMultiStringMatcher<char>(patterns).ScanLeftmostLongestIn(str, [&](const TMultiStringMatcher<char>::MatchResult& match)
+            {
+                actual.emplace_back(match.Position, match.Length);
+                return true;
+            });
+
+        ASSERT_EQ(actual, expected) << str;
+    }
+}
+
+TEST(StringAlgorithm, StringRef)
+{
+    const std::string buffer = "  Hello World  \nsecond line";
+    const StringRef line(buffer.c_str(), buffer.find('\n'));
+
+    ASSERT_EQ(line.GetLength(), 15u);
+    ASSERT_EQ(line.ToString(), "  Hello World  ");
+
+    const auto trimmed = StringAlgorithm::Trim(line);
+    ASSERT_EQ(trimmed, "Hello World");
+    ASSERT_EQ(trimmed.GetData(), buffer.c_str() + 2);
+    ASSERT_EQ(StringAlgorithm::TrimLeft(line), "Hello World  ");
+    ASSERT_EQ(StringAlgorithm::TrimRight(line), "  Hello World");
+    ASSERT_TRUE(StringAlgorithm::Trim(StringRef("   ")).IsEmpty());
+
+    ASSERT_TRUE(StringAlgorithm::Equal(trimmed, "Hello World"));
+    ASSERT_FALSE(StringAlgorithm::Equal(trimmed, "Hello World  "));
+    ASSERT_TRUE(StringAlgorithm::iEqual(trimmed, std::string("hello world")));
+    ASSERT_TRUE(StringAlgorithm::StartWith(trimmed, "Hello"));
+    ASSERT_TRUE(StringAlgorithm::iStartWith(trimmed, "HELLO"));
+    ASSERT_TRUE(StringAlgorithm::EndWith(trimmed, "World"));
+    ASSERT_FALSE(StringAlgorithm::EndWith(trimmed, "line"));
+    ASSERT_TRUE(StringAlgorithm::iEndWith(trimmed, "WORLD"));
+    ASSERT_TRUE(StringAlgorithm::Contains(trimmed, "o W"));
+    ASSERT_FALSE(StringAlgorithm::Contains(trimmed, "second"));
+    ASSERT_TRUE(StringAlgorithm::iContains(trimmed, "O w"));
+    ASSERT_TRUE(StringAlgorithm::Contains(trimmed, StringSearcher("World")));
+    ASSERT_EQ(StringAlgorithm::Find(trimmed, [](char ch) { return ch == ' '; }), 5u);
+    ASSERT_EQ(StringAlgorithm::Find(trimmed, [](char ch) { return ch == '!'; }), StringRef::npos);
+
+    std::vector<StringRef> tokens;
+    StringAlgorithm::Split(tokens, StringRef(buffer), TCharTraits<char>::IsSpace);
+    ASSERT_EQ(tokens.size(), 4u);
+    ASSERT_EQ(tokens[0], "Hello");
+    ASSERT_EQ(tokens[3], "line");
+    ASSERT_EQ(tokens[3].GetData(), buffer.c_str() + buffer.size() - 4);
+
+    std::vector<std::wstring> words;
+    StringAlgorithm::Split(words, std::wstring(L",a,,b,c"), [](wchar_t ch) { return ch == L','; });
+    ASSERT_EQ(words, std::vector<std::wstring>({ L"a", L"b", L"c" }));
+
+    const WStringRef wide = L"Key = Value";
+    ASSERT_TRUE(StringAlgorithm::StartWith(wide, L"Key"));
+    ASSERT_EQ(StringAlgorithm::Trim(wide.SubRef(3, 2)), L"=");
+}
+
+TEST(StringAlgorithm, SplitView)
+{
+    const std::string line = "a,,b,c,";
+
+    std::vector<std::string> tokens;
+    for (const auto& token : StringAlgorithm::SplitView(line, ','))
+    {
+        tokens.push_back(token.ToString());
+    }
+    ASSERT_EQ(tokens, std::vector<std::string>({ "a", "", "b", "c", "" }));
+
+    tokens.clear();
+    for (const auto& token : StringAlgorithm::SplitView(line, ',', true))
+    {
+        tokens.push_back(token.ToString());
+    }
+    ASSERT_EQ(tokens, std::vector<std::string>({ "a", "b", "c" }));
+
+    // tokens refer to the source
+    const auto view = StringAlgorithm::SplitView(StringRef(line), ',');
+    auto iter = view.begin();
+    ASSERT_EQ(iter->GetData(), line.c_str());
+    ++iter;
+    ++iter;
+    ASSERT_EQ(iter->GetData(), line.c_str() + 3);
+    ASSERT_EQ(*iter, "b");
+    ASSERT_EQ(std::distance(view.begin(), view.end()), 5);
+
+    const std::string empty;
+    ASSERT_EQ(std::distance(StringAlgorithm::SplitView(empty, ',').begin(), StringAlgorithm::SplitView(empty, ',').end()), 1);
+    ASSERT_TRUE(StringAlgorithm::SplitView(StringRef(""), ',', true).begin() == StringAlgorithm::SplitView(StringRef(""), ',', true).end());
+
+    tokens.clear();
+    const std::string pairs = "key => value =>=> end";
+    for (const auto& token : StringAlgorithm::SplitView(pairs, "=>", true))
+    {
+        tokens.push_back(StringAlgorithm::Trim(token).ToString());
+    }
+    ASSERT_EQ(tokens, std::vector<std::string>({ "key", "value", "end" }));
+
+    // an adversarial delimiter keeps one search over all tokens
+    // every candidate in the runs of 'a' fails only at the 'b'
+    const std::string delimiter = std::string(500, 'a') + "ba";
+    std::string joined;
+    for (int i = 0; i < 200; ++i)
+    {
+        joined += std::to_string(i) + std::string(20000, 'a') + delimiter;
+    }
+
+    size_t tokenCount = 0;
+    for (const auto& token : StringAlgorithm::SplitView(joined, delimiter))
+    {
+        ASSERT_EQ(token.ToString(), tokenCount < 200 ? std::to_string(tokenCount) + std::string(20000, 'a') : "");
+        ++tokenCount;
+    }
+    ASSERT_EQ(tokenCount, 201u);
+
+    std::mt19937 random(8);
+
+    for (int round = 0; round < 2000; ++round)
+    {
+        std::string str(random() % 60, ' ');
+        std::string separator(1 + random() % 3, ' ');
+
+        for (auto& ch : str)
+        {
+            ch = "ab"[random() % 2];
+        }
+
+        for (auto& ch : separator)
+        {
+            ch = "ab"[random() % 2];
+        }
+
+        std::vector<std::string> expected;
+        for (size_t start = 0;;)
+        {
+            const size_t pos = str.find(separator, start);
+            expected.push_back(str.substr(start, pos == std::string::npos ? std::string::npos : pos - start));
+
+            if (pos == std::string::npos)
+            {
+                break;
+            }
+
+            start = pos + separator.size();
+        }
+
+        tokens.clear();
+        const auto view = StringAlgorithm::SplitView(str, separator);
+        auto it = view.begin();
+        for (; it != view.end(); ++it)
+        {
+            tokens.push_back(it->ToString());
+        }
+        ASSERT_EQ(tokens, expected) << str << " / " << separator;
+
+        // a copied iterator goes on with its own search
+        if (expected.size() > 2)
+        {
+            auto second = ++view.begin();
+            auto copy = second;
+            ASSERT_EQ((++second)->ToString(), expected[2]);
+            ASSERT_EQ((++copy)->ToString(), expected[2]);
+        }
+    }
+
+    std::vector<std::wstring> words;
+    const std::wstring sentence = L"one two,\tthree;four";
+    for (const auto& token : StringAlgorithm::SplitViewAnyOf(sentence, L" ,;\t", true))
+    {
+        words.push_back(token.ToString());
+
+        if (words.size() == 3)
+        {
+            break;
+        }
+    }
+    ASSERT_EQ(words, std::vector<std::wstring>({ L"one", L"two", L"three" }));
+
+    // long input goes through memchr
+    std::string csv;
+    for (int i = 0; i < 1000; ++i)
+    {
+        csv += std::to_string(i);
+        csv += ',';
+    }
+
+    int count = 0;
+    for (const auto& token : StringAlgorithm::SplitView(csv, ',', true))
+    {
+        ASSERT_EQ(token, std::to_string(count));
+        ++count;
+    }
+    ASSERT_EQ(count, 1000);
+}
+
+TEST(StringAlgorithm, CharSet)
+{
+    const auto spaces = CharSet::FromPredicate(TCharTraits<char>::IsSpace);
+
+    std::string str = " \t\r\n  hello world, this is a long line \t\n ";
+    ASSERT_EQ(StringAlgorithm::Trim(StringRef(str), spaces), "hello world, this is a long line");
+    ASSERT_EQ(StringAlgorithm::TrimLeft(StringRef(str), spaces).GetLength(), str.size() - 6);
+    ASSERT_TRUE(StringAlgorithm::Trim(StringRef(" \t "), spaces).IsEmpty());
+    ASSERT_EQ(StringAlgorithm::Find(str, CharSet(",")), str.find(','));
+    ASSERT_EQ(StringAlgorithm::Find(str, CharSet(","), str.find(',') + 1), std::string::npos);
+    ASSERT_EQ(StringAlgorithm::Trim(str, spaces), "hello world, this is a long line");
+
+    std::vector<std::string> tokens;
+    StringAlgorithm::Split(tokens, str, CharSet(" ,"));
+    ASSERT_EQ(tokens, std::vector<std::string>({ "hello", "world", "this", "is", "a", "long", "line" }));
+
+    std::wstring wide = L"--==value==--";
+    const WCharSet dashes(L"-=");
+    ASSERT_EQ(StringAlgorithm::TrimRight(wide, dashes), L"--==value");
+    ASSERT_EQ(StringAlgorithm::TrimLeft(wide, dashes), L"value");
+
+    const std::string record = "a;b c;;d";
+    std::vector<StringRef> fields;
+    for (const auto& token : StringAlgorithm::SplitViewAnyOf(record, CharSet("; ")))
+    {
+        fields.push_back(token);
+    }
+    ASSERT_EQ(fields.size(), 5u);
+    ASSERT_TRUE(fields[3].IsEmpty());
+    ASSERT_EQ(fields[4], "d");
+}
+
+TEST(StringAlgorithm, Join)
+{
+    const std::vector<std::string> parts = { "usr", "", "local", "bin" };
+    ASSERT_EQ(StringAlgorithm::Join(parts, "/"), "usr//local/bin");
+    ASSERT_EQ(StringAlgorithm::Join(parts, std::string(", ")), "usr, , local, bin");
+    ASSERT_EQ(StringAlgorithm::Join(parts, "/", [](const std::string& part) { return !part.empty(); }), "usr/local/bin");
+    ASSERT_EQ(StringAlgorithm::Join(std::vector<std::string>(), "/"), "");
+
+    const std::vector<const wchar_t*> pointers = { L"a", L"b" };
+    ASSERT_EQ(StringAlgorithm::Join(pointers, L"+"), L"a+b");
+
+    const std::string source = "x y z";
+    std::vector<StringRef> refs;
+    StringAlgorithm::Split(refs, StringRef(source), CharSet(" "));
+    ASSERT_EQ(StringAlgorithm::Join(refs, "-"), "x-y-z");
+
+    std::string output = "[";
+    StringAlgorithm::JoinInto(output, parts, "/", [](const std::string& part) { return !part.empty(); });
+    StringAlgorithm::JoinInto(output, refs, std::string(""));
+    ASSERT_EQ(output, "[usr/local/binxyz");
+
+    DynamicBuffer buffer;
+    StringAlgorithm::JoinInto(buffer, parts, "/");
+    StringAlgorithm::JoinInto(buffer, refs, std::string("|"));
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(buffer.GetData()), buffer.GetSize()), "usr//local/binx|y|z");
+}
+
+TEST(StringAlgorithm, UpperLower)
+{
+    std::string text;
+    std::string upper;
+    for (int i = 0; i < 100; ++i)
+    {
+        text += "Key_" + std::to_string(i) + "-az{AZ@`\xC3\xA9;";
+        upper += "KEY_" + std::to_string(i) + "-AZ{AZ@`\xC3\xA9;";
+    }
+
+    ASSERT_EQ(StringAlgorithm::ToUpperCopy(text), upper);
+    ASSERT_EQ(StringAlgorithm::ToLowerCopy(StringRef(upper).SubRef(3)), StringAlgorithm::ToLowerCopy(text.substr(3)));
+    ASSERT_EQ(StringAlgorithm::ToLowerCopy(std::string("ABC\xC3\x89xyz")), "abc\xC3\x89xyz");
+    ASSERT_EQ(StringAlgorithm::ToUpper(text), upper);
+    ASSERT_TRUE(StringAlgorithm::ToUpperCopy(std::string()).empty());
+
+    std::wstring wide;
+    std::wstring wideUpper;
+    for (int i = 0; i < 50; ++i)
+    {
+        wide += L"abcdefghijklmnopqrstuvwxyz0123456789";
+        wideUpper += L"ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+        if (i % 7 == 0)
+        {
+            wide += static_cast<wchar_t>(0x3042);
+            wideUpper += static_cast<wchar_t>(0x3042);
+        }
+    }
+
+    ASSERT_EQ(StringAlgorithm::ToUpperCopy(wide), wideUpper);
+    ASSERT_EQ(StringAlgorithm::ToLower(wideUpper), wide);
+}
+
+TEST(StringAlgorithm, InlineString)
+{
+    InlineString<32> str("  Hello World  ");
+
+    // every string reference overload accepts an inline string
+    EXPECT_TRUE(StringAlgorithm::Contains(str, "World"));
+    EXPECT_TRUE(StringAlgorithm::iStartWith(StringAlgorithm::Trim(TStringRef<char>(str)), "hello"));
+    EXPECT_EQ(StringAlgorithm::Find(str, CharSet("W")), 8u);
+
+    // the inline overloads change the string in place
+    StringAlgorithm::Trim(str);
+    EXPECT_STREQ(str.GetData(), "Hello World");
+
+    StringAlgorithm::ToUpper(str);
+    EXPECT_STREQ(str.GetData(), "HELLO WORLD");
+
+    StringAlgorithm::ToLower(str);
+    StringAlgorithm::TrimRight(str, CharSet("dl"));
+    EXPECT_STREQ(str.GetData(), "hello wor");
+
+    StringAlgorithm::TrimLeft(str, [](const char ch) { return ch == 'h' || ch == 'e'; });
+    EXPECT_STREQ(str.GetData(), "llo wor");
+
+    std::vector<StringRef> tokens;
+    StringAlgorithm::Split(tokens, str, CharSet(" "));
+    ASSERT_EQ(tokens.size(), 2u);
+    EXPECT_EQ(tokens[1], StringRef("wor"));
+
+    const std::vector<std::string> parts = { "a", "b", "c" };
+    InlineString<4> joined;
+    StringAlgorithm::JoinInto(joined, parts, ",");
+    EXPECT_STREQ(joined.GetData(), "a,b,");
+    EXPECT_TRUE(joined.IsTruncated());
+
+    InlineString<4, true> spilled;
+    StringAlgorithm::JoinInto(spilled, parts, ", ");
+    EXPECT_STREQ(spilled.GetData(), "a, b, c");
+
+    WInlineString<16> wide(L" Wide ");
+    StringAlgorithm::Trim(wide);
+    StringAlgorithm::ToUpper(wide);
+    EXPECT_EQ(wide, WStringRef(L"WIDE"));
+}
+
+TEST(StringAlgorithm, ParseNumber)
+{
+    int value = 0;
+    EXPECT_TRUE(StringAlgorithm::ParseInt(StringRef("-2147483648"), value));
+    EXPECT_EQ(value, INT32_MIN);
+    EXPECT_FALSE(StringAlgorithm::ParseInt(std::string("+0012345678901"), value));
+    EXPECT_FALSE(StringAlgorithm::ParseInt(StringRef("2147483648"), value));
+    EXPECT_FALSE(StringAlgorithm::ParseInt(StringRef("12a"), value));
+    EXPECT_FALSE(StringAlgorithm::ParseInt(StringRef("-"), value));
+    EXPECT_FALSE(StringAlgorithm::ParseInt(StringRef(""), value));
+
+    int64_t big = 0;
+    EXPECT_TRUE(StringAlgorithm::ParseInt(StringRef("-9223372036854775808"), big));
+    EXPECT_EQ(big, INT64_MIN);
+    EXPECT_TRUE(StringAlgorithm::ParseInt(WStringRef(L"000000000000000000000123456789012"), big));
+    EXPECT_EQ(big, 123456789012);
+
+    uint64_t unsignedValue = 0;
+    EXPECT_TRUE(StringAlgorithm::ParseUInt(StringRef("18446744073709551615"), unsignedValue));
+    EXPECT_EQ(unsignedValue, UINT64_MAX);
+    EXPECT_FALSE(StringAlgorithm::ParseUInt(StringRef("18446744073709551616"), unsignedValue));
+    EXPECT_FALSE(StringAlgorithm::ParseUInt(StringRef("184467440737095516150"), unsignedValue));
+    EXPECT_FALSE(StringAlgorithm::ParseUInt(StringRef("-1"), unsignedValue));
+
+    uint8_t byte = 0;
+    EXPECT_TRUE(StringAlgorithm::ParseUInt(std::wstring(L"255"), byte));
+    EXPECT_EQ(byte, 255);
+    EXPECT_FALSE(StringAlgorithm::ParseUInt(std::wstring(L"256"), byte));
+
+    // with parsedLength the number may be followed by anything
+    size_t parsed = 0;
+    EXPECT_TRUE(TCharTraits<char>::ParseInt("42, 43", 6, value, &parsed));
+    EXPECT_EQ(value, 42);
+    EXPECT_EQ(parsed, 2u);
+
+    double number = 0;
+    EXPECT_TRUE(StringAlgorithm::ParseDouble(StringRef("3.25"), number));
+    EXPECT_EQ(number, 3.25);
+    EXPECT_TRUE(StringAlgorithm::ParseDouble(StringRef("-.5e-3"), number));
+    EXPECT_EQ(number, -0.0005);
+    EXPECT_TRUE(StringAlgorithm::ParseDouble(WStringRef(L"12345678901234567890123"), number));
+    EXPECT_EQ(number, 12345678901234567890123.0);
+    EXPECT_TRUE(StringAlgorithm::ParseDouble(StringRef("1e400"), number));
+    EXPECT_TRUE(std::isinf(number));
+    EXPECT_TRUE(StringAlgorithm::ParseDouble(StringRef("-Infinity"), number));
+    EXPECT_TRUE(std::isinf(number) && number < 0);
+    EXPECT_TRUE(StringAlgorithm::ParseDouble(StringRef("nan"), number));
+    EXPECT_TRUE(std::isnan(number));
+    EXPECT_TRUE(StringAlgorithm::ParseDouble(StringRef("4.9406564584124654e-324"), number));
+    EXPECT_EQ(number, std::numeric_limits<double>::denorm_min());
+    EXPECT_FALSE(StringAlgorithm::ParseDouble(StringRef("."), number));
+    EXPECT_FALSE(StringAlgorithm::ParseDouble(StringRef("1e"), number));
+    EXPECT_FALSE(StringAlgorithm::ParseDouble(StringRef("1.2.3"), number));
+
+    EXPECT_TRUE(TCharTraits<char>::ParseDouble("2e+x", 4, number, &parsed));
+    EXPECT_EQ(number, 2.0);
+    EXPECT_EQ(parsed, 1u);
+}
+
+TEST(StringAlgorithm, ToChars)
+{
+    char buffer[64];
+
+    auto format = [&buffer](const double value) { return std::string(buffer, TCharTraits<char>::ToChars(buffer, buffer + sizeof(buffer), value)); };
+
+    EXPECT_EQ(format(0.0), "0");
+    EXPECT_EQ(format(-0.0), "-0");
+    EXPECT_EQ(format(0.1), "0.1");
+    EXPECT_EQ(format(1.5), "1.5");
+    EXPECT_EQ(format(100.0), "100");
+    EXPECT_EQ(format(1e21), "1e+21");
+    EXPECT_EQ(format(123e18), "123000000000000000000");
+    EXPECT_EQ(format(0.000001), "0.000001");
+    EXPECT_EQ(format(1e-7), "1e-7");
+    EXPECT_EQ(format(-1.25e-300), "-1.25e-300");
+    EXPECT_EQ(format(5e-324), "5e-324");
+    EXPECT_EQ(format(1.7976931348623157e308), "1.7976931348623157e+308");
+    EXPECT_EQ(format(std::numeric_limits<double>::infinity()), "inf");
+    EXPECT_EQ(format(-std::numeric_limits<double>::infinity()), "-inf");
+    EXPECT_EQ(format(std::numeric_limits<double>::quiet_NaN()), "nan");
+
+    char* end = TCharTraits<char>::ToChars(buffer, buffer + sizeof(buffer), 0.3f);
+    EXPECT_EQ(std::string(buffer, end), "0.3");
+
+    end = TCharTraits<char>::ToChars(buffer, buffer + sizeof(buffer), INT64_MIN);
+    EXPECT_EQ(std::string(buffer, end), "-9223372036854775808");
+
+    end = TCharTraits<char>::ToCharsFixed(buffer, buffer + sizeof(buffer), 1023.996, 2);
+    EXPECT_EQ(std::string(buffer, end), "1024.00");
+
+    end = TCharTraits<char>::ToCharsFixed(buffer, buffer + sizeof(buffer), -0.5, 0);
+    EXPECT_EQ(std::string(buffer, end), "-0");
+
+    end = TCharTraits<char>::ToCharsFixed(buffer, buffer + sizeof(buffer), 6062731.8125, 3);
+    EXPECT_EQ(std::string(buffer, end), "6062731.812");
+
+    // nothing is written past the end
+    EXPECT_EQ(TCharTraits<char>::ToChars(buffer, buffer + 3, 1234), nullptr);
+    EXPECT_EQ(TCharTraits<char>::ToChars(buffer, buffer + 3, 0.125), nullptr);
+
+    wchar_t wide[32];
+    wchar_t* wideEnd = TCharTraits<wchar_t>::ToChars(wide, wide + 32, 2.5e-10);
+    EXPECT_EQ(std::wstring(wide, wideEnd), L"2.5e-10");
+
+    // random bit patterns read back through strtod as the same value
+    std::mt19937_64 random(18);
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        const uint64_t bits = random();
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+
+        if (!std::isfinite(value))
+        {
+            continue;
+        }
+
+        end = TCharTraits<char>::ToChars(buffer, buffer + sizeof(buffer), value);
+        *end = 0;
+        ASSERT_EQ(strtod(buffer, nullptr), value) << buffer;
+
+        double parsed = 0;
+        ASSERT_TRUE(TCharTraits<char>::ParseDouble(buffer, static_cast<size_t>(end - buffer), parsed)) << buffer;
+        ASSERT_EQ(parsed, value) << buffer;
+
+        float single;
+        const auto singleBits = static_cast<uint32_t>(bits);
+        memcpy(&single, &singleBits, sizeof(single));
+
+        if (std::isfinite(single))
+        {
+            end = TCharTraits<char>::ToChars(buffer, buffer + sizeof(buffer), single);
+            *end = 0;
+            ASSERT_EQ(strtof(buffer, nullptr), single) << buffer;
+        }
+    }
+}
+
+TEST(StringAlgorithm, FindAll)
+{
+    std::vector<size_t> positions;
+    EXPECT_EQ(StringAlgorithm::FindAll(positions, StringRef("one, two, three"), ", "), 2u);
+    EXPECT_EQ(positions, (std::vector<size_t>{ 3, 8 }));
+
+    positions.clear();
+    EXPECT_EQ(StringAlgorithm::FindAll(positions, std::string("aaaa"), "aa"), 2u);
+    EXPECT_EQ(StringAlgorithm::FindAll(positions, std::string("aaaa"), "aa", true), 3u);
+    EXPECT_EQ(positions, (std::vector<size_t>{ 0, 2, 0, 1, 2 }));
+
+    positions.clear();
+    EXPECT_EQ(StringAlgorithm::iFindAll(positions, WStringRef(L"Abc aBC abc"), L"ABC"), 3u);
+    EXPECT_EQ(positions, (std::vector<size_t>{ 0, 4, 8 }));
+
+    EXPECT_EQ(StringAlgorithm::Count(StringRef("abc"), ""), 0u);
+    EXPECT_EQ(StringAlgorithm::Count(StringRef("ab"), "abc"), 0u);
+    EXPECT_EQ(StringAlgorithm::Count(std::wstring(L"x.x.x"), L"."), 2u);
+    EXPECT_EQ(StringAlgorithm::iCount(std::string("Hello HELLO hello"), "hello"), 3u);
+
+    std::string offsets;
+    StringAlgorithm::FindAll(StringRef("a-b-c"), "-", [&offsets](const size_t offset) { offsets += std::to_string(offset); });
+    EXPECT_EQ(offsets, "13");
+
+    // the same offsets as a naive search, over lengths that cross the SIMD blocks and small alphabets with many candidates
+    std::mt19937 random(20);
+
+    for (int round = 0; round < 2000; ++round)
+    {
+        const size_t length = random() % 200;
+        const size_t matchLength = 1 + random() % 6;
+        const char* alphabet = round % 2 == 0 ? "ab" : "aAbB";
+        const size_t alphabetLength = strlen(alphabet);
+
+        std::string str(length, ' ');
+        std::string match(matchLength, ' ');
+
+        for (auto& ch : str)
+        {
+            ch = alphabet[random() % alphabetLength];
+        }
+
+        for (auto& ch : match)
+        {
+            ch = alphabet[random() % alphabetLength];
+        }
+
+        const bool overlapping = random() % 2 == 0;
+        const bool ignoreCase = round % 4 == 1;
+
+        std::vector<size_t> expected;
+
+        for (size_t i = 0; i + matchLength <= length; )
+        {
+            const bool equal = ignoreCase ? StringAlgorithm::iEqual(str.substr(i, matchLength), match) : str.compare(i, matchLength, match) == 0;
+
+            if (equal)
+            {
+                expected.push_back(i);
+                i += overlapping ? 1 : matchLength;
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        positions.clear();
+
+        if (ignoreCase)
+        {
+            StringAlgorithm::iFindAll(positions, str, match, overlapping);
+        }
+        else
+        {
+            StringAlgorithm::FindAll(positions, str, match, overlapping);
+        }
+
+        ASSERT_EQ(positions, expected) << str << " / " << match << " overlapping " << overlapping;
+    }
+
+    // verification work beyond the budget continues with the linear scan
+    const std::string repeated(5000, 'a');
+    EXPECT_EQ(StringAlgorithm::Count(repeated, std::string(50, 'a')), 100u);
+    EXPECT_EQ(StringAlgorithm::Count(repeated, std::string(50, 'a'), true), 4951u);
+    EXPECT_EQ(StringAlgorithm::iCount(repeated, std::string(49, 'A') + "b"), 0u);
+}
+
+TEST(StringAlgorithm, Match)
+{
+    EXPECT_TRUE(StringAlgorithm::Match(StringRef("server.log"), "*.log"));
+    EXPECT_FALSE(StringAlgorithm::Match(StringRef("server.log.1"), "*.log"));
+    EXPECT_TRUE(StringAlgorithm::Match(std::string("data_07.bin"), "data_??.bin"));
+    EXPECT_FALSE(StringAlgorithm::Match(std::string("data_7.bin"), "data_??.bin"));
+    EXPECT_TRUE(StringAlgorithm::Match(StringRef(""), "*"));
+    EXPECT_TRUE(StringAlgorithm::Match(StringRef(""), ""));
+    EXPECT_FALSE(StringAlgorithm::Match(StringRef("a"), ""));
+    EXPECT_TRUE(StringAlgorithm::Match(StringRef("abc"), "a**c"));
+    EXPECT_FALSE(StringAlgorithm::Match(StringRef("a"), "a*a"));
+    EXPECT_TRUE(StringAlgorithm::iMatch(StringRef("Report.PDF"), "report.*"));
+    EXPECT_TRUE(StringAlgorithm::iMatch(std::wstring(L"Größe.TXT"), L"grö?e.txt"));
+    EXPECT_FALSE(StringAlgorithm::Match(std::wstring(L"Größe.TXT"), L"*.txt"));
+
+    const iGlobPattern pattern("*_??_*.CSV");
+    EXPECT_TRUE(StringAlgorithm::Match(StringRef("export_01_final.csv"), pattern));
+    EXPECT_FALSE(StringAlgorithm::Match(std::string("export_1_final.csv"), pattern));
+
+    // against a dynamic programming reference
+    auto reference = [](const std::string& str, const std::string& glob)
+    {
+        std::vector<std::vector<bool>> matches(glob.size() + 1, std::vector<bool>(str.size() + 1, false));
+        matches[0][0] = true;
+
+        for (size_t i = 1; i <= glob.size(); ++i)
+        {
+            for (size_t j = 0; j <= str.size(); ++j)
+            {
+                if (glob[i - 1] == '*')
+                {
+                    matches[i][j] = matches[i - 1][j] || (j > 0 && matches[i][j - 1]);
+                }
+                else
+                {
+                    matches[i][j] = j > 0 && matches[i - 1][j - 1] && (glob[i - 1] == '?' || glob[i - 1] == str[j - 1]);
+                }
+            }
+        }
+
+        return static_cast<bool>(matches[glob.size()][str.size()]);
+    };
+
+    std::mt19937 random(24);
+
+    for (int round = 0; round < 5000; ++round)
+    {
+        std::string str(random() % 40, ' ');
+        std::string glob(random() % 10, ' ');
+
+        for (auto& ch : str)
+        {
+            ch = "ab"[random() % 2];
+        }
+
+        for (auto& ch : glob)
+        {
+            ch = "ab*?"[random() % 4];
+        }
+
+        ASSERT_EQ(GlobPattern(glob).Match(str), reference(str, glob)) << str << " / " << glob;
+    }
+
+    // a long segment with '?' is matched by an automaton of several words
+    const std::string longSegment = std::string(70, 'a') + "?b";
+    EXPECT_TRUE(StringAlgorithm::Match(std::string(100, 'a') + "xb", "*" + longSegment + "*"));
+    EXPECT_FALSE(StringAlgorithm::Match(std::string(100, 'a') + "xc", "*" + longSegment + "*"));
+    EXPECT_FALSE(StringAlgorithm::Match(std::string(200000, 'a'), "*" + std::string(64, 'a') + "?" + std::string(1000, 'a') + "b*"));
+
+    // wide characters and segments over many words, the wide strings map c and d to characters beyond 256
+    auto widen = [](const std::string& str)
+    {
+        std::wstring result;
+
+        for (const char ch : str)
+        {
+            result += ch == 'c' ? L'\u00DF' : ch == 'd' ? L'\u4E2D' : static_cast<wchar_t>(ch);
+        }
+
+        return result;
+    };
+
+    for (int round = 0; round < 500; ++round)
+    {
+        std::string str(random() % 300, ' ');
+        std::string glob;
+
+        for (auto& ch : str)
+        {
+            ch = "abcd"[random() % 4];
+        }
+
+        // the string with some characters replaced by '?' and some runs by '*', then maybe one character changed
+        for (size_t i = 0; i < str.size(); ++i)
+        {
+            const auto choice = random() % 60;
+
+            if (choice == 0)
+            {
+                glob += '*';
+                i += random() % 5;
+            }
+            else
+            {
+                glob += choice < 15 ? '?' : str[i];
+            }
+        }
+
+        if (!glob.empty() && random() % 2 == 0)
+        {
+            glob[random() % glob.size()] = "abcd"[random() % 4];
+        }
+
+        ASSERT_EQ(WGlobPattern(widen(glob)).Match(widen(str)), reference(str, glob)) << str << " / " << glob;
+    }
+
+    // many stars don't backtrack
+    std::string stars;
+
+    for (int i = 0; i < 200; ++i)
+    {
+        stars += "*a";
+    }
+
+    EXPECT_FALSE(StringAlgorithm::Match(std::string(20000, 'a'), stars + "*b"));
+    EXPECT_TRUE(StringAlgorithm::Match(std::string(20000, 'a'), stars + "*"));
+}
+
+TEST(StringAlgorithm, EditDistance)
+{
+    EXPECT_EQ(StringAlgorithm::EditDistance("kitten", "sitting"), 3u);
+    EXPECT_EQ(StringAlgorithm::EditDistance(std::string("flaw"), "lawn"), 2u);
+    EXPECT_EQ(StringAlgorithm::EditDistance("", "abc"), 3u);
+    EXPECT_EQ(StringAlgorithm::EditDistance("abc", ""), 3u);
+    EXPECT_EQ(StringAlgorithm::EditDistance("", ""), 0u);
+    EXPECT_EQ(StringAlgorithm::EditDistance("same", "same"), 0u);
+
+    // bounded: maxDistance + 1 for more distant strings
+    EXPECT_EQ(StringAlgorithm::EditDistance("kitten", "sitting", 3), 3u);
+    EXPECT_EQ(StringAlgorithm::EditDistance("kitten", "sitting", 2), 3u);
+    EXPECT_EQ(StringAlgorithm::EditDistance("a", "abcdef", 1), 2u);
+    EXPECT_EQ(StringAlgorithm::EditDistance("kitten", "sitting", 0), 1u);
+
+    EXPECT_EQ(StringAlgorithm::iEditDistance("HeLLo", "hello"), 0u);
+    EXPECT_EQ(StringAlgorithm::iEditDistance(std::string("WORLD"), "word"), 1u);
+    EXPECT_EQ(StringAlgorithm::EditDistance("HeLLo", "hello"), 3u);
+
+    EXPECT_EQ(StringAlgorithm::EditDistance(L"Größe", L"Grösse"), 2u);
+    EXPECT_EQ(StringAlgorithm::EditDistance(L"中文字", L"中字"), 1u);
+    EXPECT_EQ(StringAlgorithm::iEditDistance(L"Apfel", L"aPFEL"), 0u);
+
+    auto reference = [](const std::string& first, const std::string& second)
+    {
+        std::vector<size_t> row(second.size() + 1);
+
+        for (size_t j = 0; j <= second.size(); ++j)
+        {
+            row[j] = j;
+        }
+
+        for (size_t i = 1; i <= first.size(); ++i)
+        {
+            size_t diagonal = row[0];
+            row[0] = i;
+
+            for (size_t j = 1; j <= second.size(); ++j)
+            {
+                const size_t above = row[j];
+                row[j] = std::min(std::min(row[j] + 1, row[j - 1] + 1), diagonal + (first[i - 1] == second[j - 1] ? 0 : 1));
+                diagonal = above;
+            }
+        }
+
+        return row[second.size()];
+    };
+
+    std::mt19937 random(25);
+
+    // lengths beyond 64 take the blocked path
+    for (int round = 0; round < 2000; ++round)
+    {
+        const size_t maxLength = round % 2 == 0 ? 20 : 200;
+        std::string first(random() % maxLength, ' ');
+        std::string second(random() % maxLength, ' ');
+        const char* alphabet = round % 3 == 0 ? "ab" : "abcd";
+        const size_t alphabetSize = round % 3 == 0 ? 2 : 4;
+
+        for (auto& ch : first)
+        {
+            ch = alphabet[random() % alphabetSize];
+        }
+
+        for (auto& ch : second)
+        {
+            ch = random() % 8 == 0 ? alphabet[random() % alphabetSize] : (first.empty() ? 'a' : first[random() % first.size()]);
+        }
+
+        const size_t distance = reference(first, second);
+        const size_t maxDistance = random() % 40;
+
+        ASSERT_EQ(StringAlgorithm::EditDistance(first, second), distance) << first << " / " << second;
+        ASSERT_EQ(StringAlgorithm::EditDistance(first, second, maxDistance), std::min(distance, maxDistance + 1)) << first << " / " << second;
+    }
+
+    const std::vector<std::string> names = { "Parse", "Print", "parser", "Format", "Prase", "Parsing", "Pause" };
+
+    iFuzzyMatcher matcher("parse");
+    std::vector<size_t> within;
+
+    EXPECT_EQ(matcher.FindWithin(names.begin(), names.end(), 1, [&](size_t index, size_t distance) { within.push_back(index * 10 + distance); }), 3u);
+    EXPECT_EQ(within, std::vector<size_t>({ 0, 21, 61 }));
+
+    size_t distance = 0;
+    EXPECT_EQ(matcher.FindClosest(names.begin(), names.end(), 3, &distance), names.begin());
+    EXPECT_EQ(distance, 0u);
+
+    FuzzyMatcher exact("Prse");
+    EXPECT_EQ(exact.FindClosest(names.begin() + 1, names.end(), FuzzyMatcher::npos, &distance) - names.begin(), 4);
+    EXPECT_EQ(distance, 1u);
+    EXPECT_EQ(exact.FindClosest(names.begin(), names.end(), 0, &distance), names.end());
+    EXPECT_EQ(distance, FuzzyMatcher::npos);
+}
@@ -1,6 +1,11 @@
 ﻿#include <gtest/gtest.h>
 #include <Text/Encoding.hpp>
 #include <Text/Details/TextEncodingGeneric.hpp>
+#include <Text/HexBase64.hpp>
+#include <Text/CsvTokenizer.hpp>
+#include <Common/DynamicBuffer.hpp>
+#include <random>
+#include <vector>
 
 using namespace CppMiniToolkit;
 
@@ -77,3 +82,228 @@ TEST(EncodingGeneric, UTF8ToUTF16Chinese)
     EXPECT_EQ(utf16, u"\u4F60\u597D, \u4E16\u754C!");  // "你好, 世界!"
 }
 
+
+TEST(HexCodec, EncodeDecode)
+{
+    const uint8_t bytes[] = { 0x00, 0x01, 0x7F, 0x80, 0xAB, 0xFF };
+    EXPECT_EQ(HexCodec::Encode(bytes, sizeof(bytes)), "00017f80abff");
+    EXPECT_EQ(HexCodec::Encode(bytes, sizeof(bytes), true), "00017F80ABFF");
+    EXPECT_EQ(HexCodec::Encode(bytes, 0), "");
+
+    std::string decoded;
+    EXPECT_TRUE(HexCodec::DecodeInto(decoded, "00017f80ABfF"));
+    EXPECT_EQ(decoded, std::string(reinterpret_cast<const char*>(bytes), sizeof(bytes)));
+
+    EXPECT_FALSE(HexCodec::DecodeInto(decoded, "abc"));
+    EXPECT_FALSE(HexCodec::DecodeInto(decoded, "0g"));
+    EXPECT_EQ(decoded.size(), sizeof(bytes));
+
+    DynamicBuffer buffer;
+    HexCodec::EncodeInto(buffer, bytes, 2);
+    HexCodec::EncodeInto(buffer, bytes + 2, 4);
+    ASSERT_EQ(buffer.GetSize(), 12u);
+    EXPECT_EQ(memcmp(buffer.GetData(), "00017f80abff", 12), 0);
+
+    // every length around the SIMD block sizes, with a bad character at every position
+    std::mt19937 random(19);
+
+    for (size_t length = 0; length <= 100; ++length)
+    {
+        std::vector<uint8_t> data(length);
+
+        for (auto& byte : data)
+        {
+            byte = static_cast<uint8_t>(random());
+        }
+
+        const std::string text = HexCodec::Encode(data.data(), length, length % 2 == 0);
+
+        DynamicBuffer output;
+        ASSERT_TRUE(HexCodec::DecodeInto(output, text));
+        ASSERT_EQ(output.GetSize(), length);
+        ASSERT_TRUE(length == 0 || memcmp(output.GetData(), data.data(), length) == 0);
+
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            std::string bad = text;
+            bad[i] = "g/:@G`\xff"[i % 7];
+            ASSERT_FALSE(HexCodec::DecodeInto(output, bad)) << bad;
+        }
+
+        ASSERT_EQ(output.GetSize(), length);
+    }
+}
+
+TEST(Base64Codec, EncodeDecode)
+{
+    // RFC 4648 test vectors
+    const char* vectors[][2] = { { "", "" }, { "f", "Zg==" }, { "fo", "Zm8=" }, { "foo", "Zm9v" }, { "foob", "Zm9vYg==" }, { "fooba", "Zm9vYmE=" }, { "foobar", "Zm9vYmFy" } };
+
+    for (const auto& vector : vectors)
+    {
+        EXPECT_EQ(Base64Codec::Encode(vector[0], strlen(vector[0])), vector[1]);
+
+        std::string decoded;
+        EXPECT_TRUE(Base64Codec::DecodeInto(decoded, vector[1]));
+        EXPECT_EQ(decoded, vector[0]);
+    }
+
+    std::string decoded;
+    EXPECT_FALSE(Base64Codec::DecodeInto(decoded, "Zm9"));
+    EXPECT_FALSE(Base64Codec::DecodeInto(decoded, "Zm=v"));
+    EXPECT_FALSE(Base64Codec::DecodeInto(decoded, "Zg==Zm9v"));
+    EXPECT_FALSE(Base64Codec::DecodeInto(decoded, "Z==="));
+    EXPECT_FALSE(Base64Codec::DecodeInto(decoded, "Zm9-"));
+    EXPECT_TRUE(decoded.empty());
+
+    std::mt19937 random(64);
+
+    for (size_t length = 0; length <= 120; ++length)
+    {
+        std::vector<uint8_t> data(length);
+
+        for (auto& byte : data)
+        {
+            byte = static_cast<uint8_t>(random());
+        }
+
+        const std::string text = Base64Codec::Encode(data.data(), length);
+        ASSERT_EQ(text.size(), Base64Codec::GetEncodedLength(length));
+
+        // the scalar reference
+        std::string expected;
+        const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        for (size_t i = 0; i < length; i += 3)
+        {
+            const uint32_t triple = data[i] << 16 | (i + 1 < length ? data[i + 1] << 8 : 0) | (i + 2 < length ? data[i + 2] : 0);
+
+            expected += alphabet[triple >> 18];
+            expected += alphabet[(triple >> 12) & 0x3F];
+            expected += i + 1 < length ? alphabet[(triple >> 6) & 0x3F] : '=';
+            expected += i + 2 < length ? alphabet[triple & 0x3F] : '=';
+        }
+
+        ASSERT_EQ(text, expected);
+
+        DynamicBuffer output;
+        ASSERT_TRUE(Base64Codec::DecodeInto(output, text));
+        ASSERT_EQ(output.GetSize(), length);
+        ASSERT_TRUE(length == 0 || memcmp(output.GetData(), data.data(), length) == 0);
+
+        for (size_t i = 0; i + 2 < text.size(); ++i)
+        {
+            std::string bad = text;
+            bad[i] = "=-_ \n\x80*"[i % 7];
+            ASSERT_FALSE(Base64Codec::DecodeInto(output, bad)) << bad;
+        }
+
+        ASSERT_EQ(output.GetSize(), length);
+    }
+}
+
+TEST(CsvTokenizer, Parse)
+{
+    CsvTokenizer csv;
+
+    const std::string text = "name,comment,count\r\n\"Smith, J\",\"said \"\"hi\"\"\nand left\",3\r\n,,\n\"\"\nlast";
+    ASSERT_TRUE(csv.Parse(text));
+    ASSERT_EQ(csv.GetRowCount(), 5u);
+    EXPECT_EQ(csv.GetFieldCount(), 11u);
+    EXPECT_EQ(csv.GetColumnCount(0), 3u);
+    EXPECT_EQ(csv.GetField(0, 2).ToString(), "count");
+    EXPECT_EQ(csv.GetField(1, 0).ToString(), "Smith, J");
+    EXPECT_EQ(csv.GetField(1, 1).ToString(), "said \"\"hi\"\"\nand left");
+    EXPECT_EQ(csv.GetValue(1, 1), "said \"hi\"\nand left");
+    EXPECT_EQ(csv.GetRawField(5).ToString(), "3");
+    EXPECT_EQ(csv.GetColumnCount(2), 3u);
+    EXPECT_TRUE(csv.GetField(2, 2).IsEmpty());
+    EXPECT_EQ(csv.GetColumnCount(3), 1u);
+    EXPECT_EQ(csv.GetValue(3, 0), "");
+    EXPECT_EQ(csv.GetField(4, 0).ToString(), "last");
+
+    // fields point into the text
+    EXPECT_EQ(csv.GetField(0, 0).GetData(), text.data());
+
+    ASSERT_TRUE(csv.Parse(StringRef("a,b,\n")));
+    ASSERT_EQ(csv.GetRowCount(), 1u);
+    EXPECT_EQ(csv.GetColumnCount(0), 3u);
+
+    ASSERT_TRUE(csv.Parse(StringRef("a,b,")));
+    EXPECT_EQ(csv.GetColumnCount(0), 3u);
+
+    ASSERT_TRUE(csv.Parse(StringRef("")));
+    EXPECT_EQ(csv.GetRowCount(), 0u);
+
+    EXPECT_FALSE(csv.Parse(StringRef("a,b\n\"c,d\ne")));
+    EXPECT_EQ(csv.GetRowCount(), 1u);
+    EXPECT_EQ(csv.GetFieldCount(), 2u);
+
+    CsvTokenizer tsv('\t');
+    ASSERT_TRUE(tsv.Parse(StringRef("a,b\tc\n")));
+    EXPECT_EQ(tsv.GetField(0, 0).ToString(), "a,b");
+    EXPECT_EQ(tsv.GetField(0, 1).ToString(), "c");
+
+    // rows and quoted fields crossing the 64 byte blocks
+    std::mt19937 random(23);
+
+    for (int round = 0; round < 200; ++round)
+    {
+        std::vector<std::vector<std::string>> rows(1 + random() % 20);
+        std::string generated;
+
+        for (auto& row : rows)
+        {
+            row.resize(1 + random() % 8);
+
+            for (size_t column = 0; column < row.size(); ++column)
+            {
+                auto& field = row[column];
+                field.resize(random() % 40);
+
+                for (auto& ch : field)
+                {
+                    ch = "ab ,\"\n\r"[random() % 7];
+                }
+
+                // a lone \r at the end of a field looks like the one of a \r\n row end
+                const bool quote = random() % 2 == 0 || field.find_first_of(",\"\n\r") != std::string::npos;
+
+                generated += column > 0 ? "," : "";
+
+                if (quote)
+                {
+                    generated += '"';
+
+                    for (const char ch : field)
+                    {
+                        generated += ch == '"' ? "\"\"" : std::string(1, ch);
+                    }
+
+                    generated += '"';
+                }
+                else
+                {
+                    generated += field;
+                }
+            }
+
+            generated += random() % 2 == 0 ? "\n" : "\r\n";
+        }
+
+        ASSERT_TRUE(csv.Parse(generated));
+        ASSERT_EQ(csv.GetRowCount(), rows.size());
+
+        std::string value;
+
+        for (size_t row = 0; row < rows.size(); ++row)
+        {
+            ASSERT_EQ(csv.GetColumnCount(row), rows[row].size());
+
+            for (size_t column = 0; column < rows[row].size(); ++column)
+            {
+                ASSERT_EQ(csv.GetValue(row, column, value), rows[row][column]) << generated;
+            }
+        }
+    }
+}